@@ -71,13 +71,55 @@ test_component() {
   fi
 }
 
+# function test_wav_24in32()
+# Round trip of a WAV file with 24 bit samples MSB justified in 32 bit
+# containers through the volume component at 0 dB. The written WAV must
+# contain the same samples as the input file.
+test_wav_24in32() {
+  echo "------------------------------------------------------------"
+  echo "test 24 bit in 32 bit container WAV round trip"
+  python3 - <<'EOFPY'
+import random
+import struct
+
+ch, rate, frames = 2, 48000, 4800
+random.seed(1)
+data = b"".join(struct.pack("<i", random.randint(-(1 << 23), (1 << 23) - 1) << 8)
+                for _ in range(ch * frames))
+subformat_pcm = bytes([1, 0, 0, 0, 0, 0, 0x10, 0, 0x80, 0, 0, 0xaa, 0, 0x38, 0x9b, 0x71])
+fmt = struct.pack("<HHIIHHHHI", 0xfffe, ch, rate, rate * ch * 4, ch * 4, 32, 22, 24, 3)
+fmt += subformat_pcm
+with open("wav_24in32_in.wav", "wb") as f:
+    f.write(b"RIFF" + struct.pack("<I", 4 + 8 + len(fmt) + 8 + len(data)) + b"WAVE")
+    f.write(b"fmt " + struct.pack("<I", len(fmt)) + fmt)
+    f.write(b"data" + struct.pack("<I", len(data)) + data)
+EOFPY
+  ./comp_run.sh volume playback 24 24 48000 48000 wav_24in32_in.wav wav_24in32_out.wav
+  python3 - <<'EOFPY' || die "24 bit in 32 bit WAV round trip failed!\n"
+import sys
+
+def wav_data(fn):
+    d = open(fn, "rb").read()
+    pos = 12
+    while d[pos:pos + 4] != b"data":
+        pos += 8 + int.from_bytes(d[pos + 4:pos + 8], "little")
+    return d[pos + 8:]
+
+data_in = wav_data("wav_24in32_in.wav")
+data_out = wav_data("wav_24in32_out.wav")
+if len(data_out) < len(data_in) * 9 // 10 or data_out != data_in[:len(data_out)]:
+    sys.exit(1)
+EOFPY
+  echo "24 bit in 32 bit WAV round trip passed!"
+}
+
 SCRIPTS_DIR=$(dirname "${BASH_SOURCE[0]}")
 SOF_DIR=$SCRIPTS_DIR/../
 TESTBENCH_DIR=${SOF_DIR}/tools/test/audio
 INPUT_FILE_SIZE=10240
 
 cd "$TESTBENCH_DIR"
-rm -rf ./*.raw
+rm -rf ./*.raw ./wav_24in32_*.wav
 
 # create input zeros raw file
 head -c ${INPUT_FILE_SIZE} < /dev/zero > zeros_in.raw
@@ -90,6 +132,9 @@ test_component volume 16 16 48000 "$FullTest"
 test_component volume 24 24 48000 "$FullTest"
 test_component volume 32 32 48000 "$FullTest"
 
+# test 24 bit WAV files
+test_wav_24in32
+
 # test with eq-iir
 test_component eq-iir 16 16 48000 "$FullTest"
 test_component eq-iir 24 24 48000 "$FullTest"
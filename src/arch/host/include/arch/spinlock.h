@@ -11,6 +11,50 @@
 #ifndef __ARCH_SPINLOCK_H__
 #define __ARCH_SPINLOCK_H__
 
+#if CONFIG_LIBRARY
+
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Testbench can run pipelines on several host threads, buffers shared
+ * between them need a real lock. Padded to keep the members that follow
+ * the lock in packed struct coherent aligned.
+ */
+struct k_spinlock {
+	uint32_t locked;
+	uint32_t reserved;
+};
+
+/*
+ * Real locking is enabled only by the multi-core testbench mode, before
+ * any lock is taken. Single threaded users keep the no-op lock.
+ */
+extern bool arch_spinlock_smp;
+
+static inline void arch_spinlock_init(struct k_spinlock *lock)
+{
+	__atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+}
+
+static inline void arch_spin_lock(struct k_spinlock *lock)
+{
+	if (!arch_spinlock_smp)
+		return;
+
+	while (__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE))
+		sched_yield();
+}
+
+static inline void arch_spin_unlock(struct k_spinlock *lock)
+{
+	if (arch_spinlock_smp)
+		__atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+}
+
+#else
+
 struct k_spinlock {
 };
 
@@ -18,6 +62,8 @@ static inline void arch_spinlock_init(struct k_spinlock *lock) {}
 static inline void arch_spin_lock(struct k_spinlock *lock) {}
 static inline void arch_spin_unlock(struct k_spinlock *lock) {}
 
+#endif /* CONFIG_LIBRARY */
+
 #endif /* __ARCH_SPINLOCK_H__ */
 
 #else
@@ -195,6 +195,29 @@ void buffer_free(struct comp_buffer *buffer)
 	coherent_free_thread(buffer, c);
 }
 
+/*
+ * Position updates of a buffer with a single producer and a single consumer
+ * on one core. Data is never overwritten by the producer, so the write and
+ * read positions only move by the produced and consumed amount and avail and
+ * free are updated with an add instead of comparing the pointers. Each
+ * position is published with a single store after the data is in place.
+ */
+static inline void buffer_spsc_produce(struct audio_stream __sparse_cache *stream,
+				       uint32_t bytes)
+{
+	stream->w_ptr = audio_stream_wrap(stream, (char *)stream->w_ptr + bytes);
+	stream->avail += bytes;
+	stream->free -= bytes;
+}
+
+static inline void buffer_spsc_consume(struct audio_stream __sparse_cache *stream,
+				       uint32_t bytes)
+{
+	stream->r_ptr = audio_stream_wrap(stream, (char *)stream->r_ptr + bytes);
+	stream->avail -= bytes;
+	stream->free += bytes;
+}
+
 /*
  * comp_update_buffer_produce() and comp_update_buffer_consume() send
  * NOTIFIER_ID_BUFFER_PRODUCE and NOTIFIER_ID_BUFFER_CONSUME notifier events
@@ -225,11 +248,15 @@ void comp_update_buffer_produce(struct comp_buffer __sparse_cache *buffer, uint3
 		return;
 	}
 
-	audio_stream_produce(&buffer->stream, bytes);
+	if (buffer->spsc && bytes <= buffer->stream.free)
+		buffer_spsc_produce(&buffer->stream, bytes);
+	else
+		audio_stream_produce(&buffer->stream, bytes);
 
 	/* Notifier looks for the pointer value to match it against registration */
-	notifier_event(cache_to_uncache(buffer), NOTIFIER_ID_BUFFER_PRODUCE,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+	if (notifier_has_callbacks(NOTIFIER_ID_BUFFER_PRODUCE))
+		notifier_event(cache_to_uncache(buffer), NOTIFIER_ID_BUFFER_PRODUCE,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
 
 	buf_dbg(buffer, "comp_update_buffer_produce(), ((buffer->avail << 16) | buffer->free) = %08x, ((buffer->id << 16) | buffer->size) = %08x",
 		(audio_stream_get_avail_bytes(&buffer->stream) << 16) |
@@ -258,10 +285,14 @@ void comp_update_buffer_consume(struct comp_buffer __sparse_cache *buffer, uint3
 		return;
 	}
 
-	audio_stream_consume(&buffer->stream, bytes);
+	if (buffer->spsc && bytes <= buffer->stream.avail)
+		buffer_spsc_consume(&buffer->stream, bytes);
+	else
+		audio_stream_consume(&buffer->stream, bytes);
 
-	notifier_event(cache_to_uncache(buffer), NOTIFIER_ID_BUFFER_CONSUME,
-		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
+	if (notifier_has_callbacks(NOTIFIER_ID_BUFFER_CONSUME))
+		notifier_event(cache_to_uncache(buffer), NOTIFIER_ID_BUFFER_CONSUME,
+			       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
 
 	buf_dbg(buffer, "comp_update_buffer_consume(), (buffer->avail << 16) | buffer->free = %08x, (buffer->id << 16) | buffer->size = %08x, (buffer->r_ptr - buffer->addr) << 16 | (buffer->w_ptr - buffer->addr)) = %08x",
 		(audio_stream_get_avail_bytes(&buffer->stream) << 16) |
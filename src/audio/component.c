@@ -295,6 +295,11 @@ void audio_stream_copy_to_linear(const struct audio_stream __sparse_cache *sourc
 	}
 }
 
+#if CONFIG_LIBRARY
+/* Testbench profiler hook, called in place of the copy() op when set */
+int (*comp_copy_hook)(struct comp_dev *dev);
+#endif
+
 /** See comp_ops::copy */
 int comp_copy(struct comp_dev *dev)
 {
@@ -308,7 +313,14 @@ int comp_copy(struct comp_dev *dev)
 		perf_cnt_init(&dev->pcd);
 #endif
 
+#if CONFIG_LIBRARY
+		if (comp_copy_hook)
+			ret = comp_copy_hook(dev);
+		else
+			ret = dev->drv->ops.copy(dev);
+#else
 		ret = dev->drv->ops.copy(dev);
+#endif
 
 #if CONFIG_PERFORMANCE_COUNTERS
 		perf_cnt_stamp(&dev->pcd, perf_trace_null, dev);
@@ -22,6 +22,7 @@
 #include <sof/lib/notifier.h>
 #include <sof/lib/uuid.h>
 #include <sof/list.h>
+#include <sof/math/numbers.h>
 #include <rtos/string.h>
 #include <sof/ut.h>
 #include <sof/trace/trace.h>
@@ -87,6 +88,7 @@ static int create_endpoint_buffer(struct comp_dev *parent_dev,
 	struct comp_buffer *buffer;
 	uint32_t buf_size;
 	uint32_t chan_map;
+	int channels;
 	int i;
 
 	audio_stream_fmt_conversion(copier_cfg->base.audio_fmt.depth,
@@ -145,21 +147,7 @@ static int create_endpoint_buffer(struct comp_dev *parent_dev,
 	}
 
 	parent_dev->ipc_config.frame_fmt = config->frame_fmt;
-
-	memset(&ipc_buf, 0, sizeof(ipc_buf));
-	ipc_buf.size = buf_size;
-	ipc_buf.comp.pipeline_id = config->pipeline_id;
-	ipc_buf.comp.core = config->core;
-
-	buffer = buffer_new(&ipc_buf);
-	if (!buffer)
-		return -ENOMEM;
-
-	buffer->stream.channels = copier_cfg->base.audio_fmt.channels_count;
-	buffer->stream.rate = copier_cfg->base.audio_fmt.sampling_frequency;
-	buffer->stream.frame_fmt = config->frame_fmt;
-	buffer->stream.valid_sample_fmt = valid_fmt;
-	buffer->buffer_fmt = copier_cfg->base.audio_fmt.interleaving_style;
+	channels = copier_cfg->base.audio_fmt.channels_count;
 
 	/* For ALH multi-gateway case, configuration blob contains struct ipc4_alh_multi_gtw_cfg
 	 * with channel map and channels number for each individual gateway.
@@ -167,7 +155,6 @@ static int create_endpoint_buffer(struct comp_dev *parent_dev,
 	if (type == ipc4_gtw_alh && is_multi_gateway(copier_cfg->gtw_cfg.node_id) &&
 	    !create_multi_endpoint_buffer) {
 		if (copier_cfg->gtw_cfg.config_length) {
-			int channels;
 			const struct sof_alh_configuration_blob *alh_blob =
 				(const struct sof_alh_configuration_blob *)
 					copier_cfg->gtw_cfg.config_data;
@@ -178,14 +165,34 @@ static int create_endpoint_buffer(struct comp_dev *parent_dev,
 				comp_err(parent_dev, "Invalid channels mask: 0x%x", chan_bitmask);
 				return -EINVAL;
 			}
-			buffer->stream.channels = channels;
 			chan_map = bitmask_to_nibble_channel_map(chan_bitmask);
+
+			/* the size is for the whole multi stream, keep whole frames of this
+			 * gateway channels for the copies to and from the multi buffer
+			 */
+			buf_size = ROUND_DOWN(buf_size, get_frame_bytes(config->frame_fmt,
+									channels));
 		} else {
 			comp_err(parent_dev, "No ipc4_alh_multi_gtw_cfg found in blob!");
 			return -EINVAL;
 		}
 	}
 
+	memset(&ipc_buf, 0, sizeof(ipc_buf));
+	ipc_buf.size = buf_size;
+	ipc_buf.comp.pipeline_id = config->pipeline_id;
+	ipc_buf.comp.core = config->core;
+
+	buffer = buffer_new(&ipc_buf);
+	if (!buffer)
+		return -ENOMEM;
+
+	buffer->stream.channels = channels;
+	buffer->stream.rate = copier_cfg->base.audio_fmt.sampling_frequency;
+	buffer->stream.frame_fmt = config->frame_fmt;
+	buffer->stream.valid_sample_fmt = valid_fmt;
+	buffer->buffer_fmt = copier_cfg->base.audio_fmt.interleaving_style;
+
 	for (i = 0; i < SOF_IPC_MAX_CHANNELS; i++)
 		buffer->chmap[i] = (chan_map >> i * 4) & 0xf;
 
@@ -764,81 +771,180 @@ static pcm_converter_func get_converter_func(const struct ipc4_audio_format *in_
 		return pcm_get_conversion_vc_function(in, in_valid, out, out_valid, type, dir);
 }
 
-static void copy_single_channel_c16(struct audio_stream __sparse_cache *dst,
-				    int dst_channel,
-				    const struct audio_stream __sparse_cache *src,
-				    int src_channel, int frame_count)
+/* The mux/demux functions copy all channels of one frame at a time so the
+ * multi_endpoint_buffer is passed only once per period.
+ */
+static void demux_c16(const struct copier_chmap *map, void *multi_ptr, void **endp_ptr,
+		      uint32_t frames)
 {
-	int16_t *r_ptr = (int16_t *)src->r_ptr + src_channel;
-	int16_t *w_ptr = (int16_t *)dst->w_ptr + dst_channel;
-
-	/* We have to iterate over frames here. However, tracking frames requires using
-	 * of expensive division operations (e.g., inside audio_stream_frames_without_wrap()).
-	 * So let's track samples instead. Since we only copy one channel, src_stream_sample_count
-	 * is NOT number of samples we need to copy but total samples for all channels. We just
-	 * track them to know when to stop.
-	 */
-	int src_stream_sample_count = frame_count * src->channels;
+	const struct copier_chmap_item *item;
+	int16_t *dst[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	int16_t *src = multi_ptr;
+	uint32_t i, j;
+
+	for (j = 0; j < map->endp_num; j++)
+		dst[j] = endp_ptr[j];
+
+	for (i = 0; i < frames; i++) {
+		for (j = 0; j < map->count; j++) {
+			item = &map->item[j];
+			dst[item->endp_idx][item->endp_channel] = src[item->channel];
+		}
+
+		src += map->channels;
+		for (j = 0; j < map->endp_num; j++)
+			dst[j] += map->endp_channels[j];
+	}
+}
 
-	while (src_stream_sample_count) {
-		int src_samples_without_wrap;
-		int16_t *r_end_ptr, *r_ptr_before_loop;
+static void mux_c16(const struct copier_chmap *map, void *multi_ptr, void **endp_ptr,
+		    uint32_t frames)
+{
+	const struct copier_chmap_item *item;
+	int16_t *src[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	int16_t *dst = multi_ptr;
+	uint32_t i, j;
+
+	for (j = 0; j < map->endp_num; j++)
+		src[j] = endp_ptr[j];
+
+	for (i = 0; i < frames; i++) {
+		for (j = 0; j < map->count; j++) {
+			item = &map->item[j];
+			dst[item->channel] = src[item->endp_idx][item->endp_channel];
+		}
 
-		r_ptr = audio_stream_wrap(src, r_ptr);
-		w_ptr = audio_stream_wrap(dst, w_ptr);
+		dst += map->channels;
+		for (j = 0; j < map->endp_num; j++)
+			src[j] += map->endp_channels[j];
+	}
+}
 
-		src_samples_without_wrap = audio_stream_samples_without_wrap_s16(src, r_ptr);
-		r_end_ptr = src_stream_sample_count < src_samples_without_wrap ?
-			r_ptr + src_stream_sample_count : (int16_t *)src->end_addr;
+static void demux_c32(const struct copier_chmap *map, void *multi_ptr, void **endp_ptr,
+		      uint32_t frames)
+{
+	const struct copier_chmap_item *item;
+	int32_t *dst[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	int32_t *src = multi_ptr;
+	uint32_t i, j;
+
+	for (j = 0; j < map->endp_num; j++)
+		dst[j] = endp_ptr[j];
+
+	for (i = 0; i < frames; i++) {
+		for (j = 0; j < map->count; j++) {
+			item = &map->item[j];
+			dst[item->endp_idx][item->endp_channel] = src[item->channel];
+		}
 
-		r_ptr_before_loop = r_ptr;
+		src += map->channels;
+		for (j = 0; j < map->endp_num; j++)
+			dst[j] += map->endp_channels[j];
+	}
+}
 
-		do {
-			*w_ptr = *r_ptr;
-			r_ptr += src->channels;
-			w_ptr += dst->channels;
-		} while (r_ptr < r_end_ptr && w_ptr < (int16_t *)dst->end_addr);
+static void mux_c32(const struct copier_chmap *map, void *multi_ptr, void **endp_ptr,
+		    uint32_t frames)
+{
+	const struct copier_chmap_item *item;
+	int32_t *src[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	int32_t *dst = multi_ptr;
+	uint32_t i, j;
+
+	for (j = 0; j < map->endp_num; j++)
+		src[j] = endp_ptr[j];
+
+	for (i = 0; i < frames; i++) {
+		for (j = 0; j < map->count; j++) {
+			item = &map->item[j];
+			dst[item->channel] = src[item->endp_idx][item->endp_channel];
+		}
 
-		src_stream_sample_count -= r_ptr - r_ptr_before_loop;
+		dst += map->channels;
+		for (j = 0; j < map->endp_num; j++)
+			src[j] += map->endp_channels[j];
 	}
 }
 
-static void copy_single_channel_c32(struct audio_stream __sparse_cache *dst,
-				    int dst_channel,
-				    const struct audio_stream __sparse_cache *src,
-				    int src_channel, int frame_count)
+/* Builds the channel map for the multi_endpoint_buffer from the channel maps of the
+ * endpoint buffers.
+ */
+static int copier_build_chmap(struct comp_dev *dev, struct copier_data *cd)
 {
-	int32_t *r_ptr = (int32_t *)src->r_ptr + src_channel;
-	int32_t *w_ptr = (int32_t *)dst->w_ptr + dst_channel;
-
-	/* We have to iterate over frames here. However, tracking frames requires using
-	 * of expensive division operations (e.g., inside audio_stream_frames_without_wrap()).
-	 * So let's track samples instead. Since we only copy one channel, src_stream_sample_count
-	 * is NOT number of samples we need to copy but total samples for all channels. We just
-	 * track them to know when to stop.
-	 */
-	int src_stream_sample_count = frame_count * src->channels;
+	struct copier_chmap *map = &cd->chmap;
+	struct comp_buffer __sparse_cache *buf_c;
+	struct copier_chmap_item *item;
+	uint32_t frame_bytes;
+	uint32_t size;
+	int ret = 0;
+	int i, j;
+
+	memset(map, 0, sizeof(*map));
 
-	while (src_stream_sample_count) {
-		int src_samples_without_wrap;
-		int32_t *r_end_ptr, *r_ptr_before_loop;
+	buf_c = buffer_acquire(cd->multi_endpoint_buffer);
+	map->channels = buf_c->stream.channels;
+	map->endp_num = cd->endpoint_num;
+	size = buf_c->stream.size;
+	frame_bytes = audio_stream_frame_bytes(&buf_c->stream);
+	buffer_release(buf_c);
 
-		r_ptr = audio_stream_wrap(src, r_ptr);
-		w_ptr = audio_stream_wrap(dst, w_ptr);
+	/* the copy is done in spans of whole frames between buffer wraps */
+	if (!frame_bytes || size % frame_bytes) {
+		comp_err(dev, "multi endpoint buffer size %u isn't in frames", size);
+		return -EINVAL;
+	}
 
-		src_samples_without_wrap = audio_stream_samples_without_wrap_s32(src, r_ptr);
-		r_end_ptr = src_stream_sample_count < src_samples_without_wrap ?
-			r_ptr + src_stream_sample_count : (int32_t *)src->end_addr;
+	for (i = 0; i < cd->endpoint_num; i++) {
+		buf_c = buffer_acquire(cd->endpoint_buffer[i]);
+		map->endp_channels[i] = buf_c->stream.channels;
+		frame_bytes = audio_stream_frame_bytes(&buf_c->stream);
+		if (!frame_bytes || buf_c->stream.size % frame_bytes) {
+			comp_err(dev, "endpoint %d buffer size %u isn't in frames", i,
+				 buf_c->stream.size);
+			ret = -EINVAL;
+		}
 
-		r_ptr_before_loop = r_ptr;
+		for (j = 0; j < buf_c->stream.channels && !ret; j++) {
+			if (map->count == SOF_IPC_MAX_CHANNELS ||
+			    buf_c->chmap[j] >= map->channels) {
+				comp_err(dev, "endpoint %d channel %d can't be mapped", i, j);
+				ret = -EINVAL;
+				break;
+			}
 
-		do {
-			*w_ptr = *r_ptr;
-			r_ptr += src->channels;
-			w_ptr += dst->channels;
-		} while (r_ptr < r_end_ptr && w_ptr < (int32_t *)dst->end_addr);
+			item = &map->item[map->count++];
+			item->endp_idx = i;
+			item->endp_channel = j;
+			item->channel = buf_c->chmap[j];
+		}
+		buffer_release(buf_c);
 
-		src_stream_sample_count -= r_ptr - r_ptr_before_loop;
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Output pins of the same format and converter share one conversion, the first
+ * converted of them is copied to the others.
+ */
+static void copier_update_conversion_pins(struct copier_data *cd)
+{
+	int i, j;
+
+	for (i = 0; i < IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT; i++) {
+		cd->conversion_pin[i] = i;
+		if (!cd->converter[i])
+			continue;
+
+		for (j = 0; j < i; j++) {
+			if (cd->converter[j] == cd->converter[i] &&
+			    !memcmp(&cd->out_fmt[j], &cd->out_fmt[i], sizeof(cd->out_fmt[i]))) {
+				cd->conversion_pin[i] = j;
+				break;
+			}
+		}
 	}
 }
 
@@ -890,6 +996,8 @@ static int copier_prepare(struct comp_dev *dev)
 		}
 	}
 
+	copier_update_conversion_pins(cd);
+
 	/* select channel copy func now to avoid unnecessary "switch" logic at processing stage */
 	if (cd->multi_endpoint_buffer) {
 		struct comp_buffer __sparse_cache *buf_c;
@@ -901,15 +1009,21 @@ static int copier_prepare(struct comp_dev *dev)
 
 		switch (container_size) {
 		case 2:
-			cd->copy_single_channel = copy_single_channel_c16;
+			cd->mux = mux_c16;
+			cd->demux = demux_c16;
 			break;
 		case 4:
-			cd->copy_single_channel = copy_single_channel_c32;
+			cd->mux = mux_c32;
+			cd->demux = demux_c32;
 			break;
 		default:
 			comp_err(dev, "Unexpected container size: %d", container_size);
 			return -EINVAL;
 		}
+
+		ret = copier_build_chmap(dev, cd);
+		if (ret < 0)
+			return ret;
 	}
 
 	return 0;
@@ -1089,43 +1203,65 @@ static inline struct comp_buffer *get_endpoint_buffer(struct copier_data *cd)
 		cd->endpoint_buffer[IPC4_COPIER_GATEWAY_PIN];
 }
 
+/* copy frames between the multi_endpoint_buffer and the endpoint buffers in spans
+ * without wrap in any of the buffers
+ */
+static void copy_multi_endpoint(struct copier_data *cd, channel_map_copy_func copy,
+				struct audio_stream __sparse_cache *multi, void *multi_ptr,
+				struct audio_stream __sparse_cache **endp, void **endp_ptr,
+				uint32_t frames)
+{
+	uint32_t n;
+	int i;
+
+	while (frames) {
+		n = MIN(frames, audio_stream_frames_without_wrap(multi, multi_ptr));
+		for (i = 0; i < cd->endpoint_num; i++)
+			n = MIN(n, audio_stream_frames_without_wrap(endp[i], endp_ptr[i]));
+
+		copy(&cd->chmap, multi_ptr, endp_ptr, n);
+
+		multi_ptr = audio_stream_wrap(multi, (char *)multi_ptr +
+					      n * audio_stream_frame_bytes(multi));
+		for (i = 0; i < cd->endpoint_num; i++)
+			endp_ptr[i] = audio_stream_wrap(endp[i], (char *)endp_ptr[i] +
+							n * audio_stream_frame_bytes(endp[i]));
+		frames -= n;
+	}
+}
+
 static int demux_from_multi_endpoint_buffer(struct copier_data *cd)
 {
-	struct comp_buffer __sparse_cache *multi_buf_c, *endp_buf_c;
-	int endp_idx, endp_channel;
+	struct comp_buffer __sparse_cache *endp_buf_c[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	struct audio_stream __sparse_cache *endp[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	void *endp_ptr[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	struct comp_buffer __sparse_cache *multi_buf_c;
 	uint32_t frame_count, byte_count;
+	uint32_t bytes_produced;
+	int endp_idx;
 
 	multi_buf_c = buffer_acquire(cd->multi_endpoint_buffer);
 
 	frame_count = audio_stream_get_avail_frames(&multi_buf_c->stream);
 
 	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
-		endp_buf_c = buffer_acquire(cd->endpoint_buffer[endp_idx]);
-		frame_count = MIN(frame_count, audio_stream_get_free_frames(&endp_buf_c->stream));
-		buffer_release(endp_buf_c);
+		endp_buf_c[endp_idx] = buffer_acquire(cd->endpoint_buffer[endp_idx]);
+		endp[endp_idx] = &endp_buf_c[endp_idx]->stream;
+		endp_ptr[endp_idx] = endp[endp_idx]->w_ptr;
+		frame_count = MIN(frame_count, audio_stream_get_free_frames(endp[endp_idx]));
 	}
 
 	byte_count = frame_count * audio_stream_frame_bytes(&multi_buf_c->stream);
 	buffer_stream_invalidate(multi_buf_c, byte_count);
 
-	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
-		uint32_t bytes_produced;
-
-		endp_buf_c = buffer_acquire(cd->endpoint_buffer[endp_idx]);
-
-		for (endp_channel = 0; endp_channel < endp_buf_c->stream.channels;
-				endp_channel++) {
-			int multi_buf_channel = endp_buf_c->chmap[endp_channel];
-
-			cd->copy_single_channel(&endp_buf_c->stream, endp_channel,
-						&multi_buf_c->stream, multi_buf_channel,
-						frame_count);
-		}
+	copy_multi_endpoint(cd, cd->demux, &multi_buf_c->stream, multi_buf_c->stream.r_ptr,
+			    endp, endp_ptr, frame_count);
 
-		bytes_produced = frame_count * audio_stream_frame_bytes(&endp_buf_c->stream);
-		buffer_stream_writeback(endp_buf_c, bytes_produced);
-		comp_update_buffer_produce(endp_buf_c, bytes_produced);
-		buffer_release(endp_buf_c);
+	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
+		bytes_produced = frame_count * audio_stream_frame_bytes(endp[endp_idx]);
+		buffer_stream_writeback(endp_buf_c[endp_idx], bytes_produced);
+		comp_update_buffer_produce(endp_buf_c[endp_idx], bytes_produced);
+		buffer_release(endp_buf_c[endp_idx]);
 	}
 
 	comp_update_buffer_consume(multi_buf_c, byte_count);
@@ -1136,15 +1272,20 @@ static int demux_from_multi_endpoint_buffer(struct copier_data *cd)
 
 static int mux_into_multi_endpoint_buffer(struct copier_data *cd)
 {
-	struct comp_buffer __sparse_cache *multi_buf_c, *endp_buf_c;
-	int endp_idx, endp_channel;
+	struct comp_buffer __sparse_cache *endp_buf_c[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	struct audio_stream __sparse_cache *endp[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	void *endp_ptr[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	struct comp_buffer __sparse_cache *multi_buf_c;
 	uint32_t frame_count = UINT32_MAX;
+	uint32_t endp_buf_byte_count;
 	uint32_t bytes_produced;
+	int endp_idx;
 
 	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
-		endp_buf_c = buffer_acquire(cd->endpoint_buffer[endp_idx]);
-		frame_count = MIN(frame_count, audio_stream_get_avail_frames(&endp_buf_c->stream));
-		buffer_release(endp_buf_c);
+		endp_buf_c[endp_idx] = buffer_acquire(cd->endpoint_buffer[endp_idx]);
+		endp[endp_idx] = &endp_buf_c[endp_idx]->stream;
+		endp_ptr[endp_idx] = endp[endp_idx]->r_ptr;
+		frame_count = MIN(frame_count, audio_stream_get_avail_frames(endp[endp_idx]));
 	}
 
 	multi_buf_c = buffer_acquire(cd->multi_endpoint_buffer);
@@ -1152,24 +1293,17 @@ static int mux_into_multi_endpoint_buffer(struct copier_data *cd)
 	frame_count = MIN(frame_count, audio_stream_get_free_frames(&multi_buf_c->stream));
 
 	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
-		uint32_t endp_buf_byte_count;
-
-		endp_buf_c = buffer_acquire(cd->endpoint_buffer[endp_idx]);
-
-		endp_buf_byte_count = frame_count * audio_stream_frame_bytes(&endp_buf_c->stream);
-		buffer_stream_invalidate(endp_buf_c, endp_buf_byte_count);
-
-		for (endp_channel = 0; endp_channel < endp_buf_c->stream.channels;
-				endp_channel++) {
-			int multi_buf_channel = endp_buf_c->chmap[endp_channel];
+		endp_buf_byte_count = frame_count * audio_stream_frame_bytes(endp[endp_idx]);
+		buffer_stream_invalidate(endp_buf_c[endp_idx], endp_buf_byte_count);
+	}
 
-			cd->copy_single_channel(&multi_buf_c->stream, multi_buf_channel,
-						&endp_buf_c->stream, endp_channel,
-						frame_count);
-		}
+	copy_multi_endpoint(cd, cd->mux, &multi_buf_c->stream, multi_buf_c->stream.w_ptr,
+			    endp, endp_ptr, frame_count);
 
-		comp_update_buffer_consume(endp_buf_c, endp_buf_byte_count);
-		buffer_release(endp_buf_c);
+	for (endp_idx = 0; endp_idx < cd->endpoint_num; endp_idx++) {
+		endp_buf_byte_count = frame_count * audio_stream_frame_bytes(endp[endp_idx]);
+		comp_update_buffer_consume(endp_buf_c[endp_idx], endp_buf_byte_count);
+		buffer_release(endp_buf_c[endp_idx]);
 	}
 
 	bytes_produced = frame_count * audio_stream_frame_bytes(&multi_buf_c->stream);
@@ -1214,12 +1348,38 @@ static int do_endpoint_copy(struct comp_dev *dev)
 	}
 }
 
+/* convert the samples and shift them by attenuation in one pass */
+static void convert_attenuated(const struct audio_stream __sparse_cache *source,
+			       struct audio_stream __sparse_cache *sink, uint32_t samples,
+			       uint32_t attenuation, copier_att_lin_func converter)
+{
+	const int s_size_in = audio_stream_sample_bytes(source);
+	const int s_size_out = audio_stream_sample_bytes(sink);
+	char *r_ptr = source->r_ptr;
+	char *w_ptr = sink->w_ptr;
+	uint32_t n;
+
+	while (samples) {
+		n = audio_stream_bytes_without_wrap(source, r_ptr) / s_size_in;
+		n = MIN(n, audio_stream_bytes_without_wrap(sink, w_ptr) / s_size_out);
+		n = MIN(n, samples);
+
+		converter(r_ptr, w_ptr, n, attenuation);
+
+		r_ptr = audio_stream_wrap(source, r_ptr + n * s_size_in);
+		w_ptr = audio_stream_wrap(sink, w_ptr + n * s_size_out);
+		samples -= n;
+	}
+}
+
 static int do_conversion_copy(struct comp_dev *dev,
 			      struct copier_data *cd,
 			      struct comp_buffer __sparse_cache *src,
 			      struct comp_buffer __sparse_cache *sink,
 			      struct comp_copy_limits *processed_data)
 {
+	copier_att_lin_func att_converter;
+	uint32_t samples;
 	int i;
 	int ret;
 
@@ -1234,13 +1394,23 @@ static int do_conversion_copy(struct comp_dev *dev,
 		return -EINVAL;
 	buffer_stream_invalidate(src, processed_data->source_bytes);
 
-	cd->converter[i](&src->stream, 0, &sink->stream, 0,
-			 processed_data->frames * sink->stream.channels);
+	samples = processed_data->frames * sink->stream.channels;
+	att_converter = cd->attenuation ?
+		get_attenuated_converter(cd->converter[i], src->stream.frame_fmt,
+					 sink->stream.frame_fmt) : NULL;
 
-	if (cd->attenuation) {
-		ret = apply_attenuation(dev, cd, sink, processed_data->frames);
-		if (ret < 0)
-			return ret;
+	if (att_converter) {
+		/* no separate attenuation pass over the converted samples */
+		convert_attenuated(&src->stream, &sink->stream, samples, cd->attenuation,
+				   att_converter);
+	} else {
+		cd->converter[i](&src->stream, 0, &sink->stream, 0, samples);
+
+		if (cd->attenuation) {
+			ret = apply_attenuation(dev, cd, sink, processed_data->frames);
+			if (ret < 0)
+				return ret;
+		}
 	}
 
 	buffer_stream_writeback(sink, processed_data->sink_bytes);
@@ -1249,6 +1419,84 @@ static int do_conversion_copy(struct comp_dev *dev,
 	return 0;
 }
 
+/* samples converted to an output during one copy, to be copied to other outputs */
+struct copier_converted {
+	struct comp_buffer *buffer;
+	void *ptr;		/* first converted sample in buffer */
+	uint32_t frames;
+};
+
+/* copy the samples already converted to another sink of the same format */
+static void copy_converted(const struct audio_stream __sparse_cache *source, const void *ptr,
+			   struct audio_stream __sparse_cache *sink, uint32_t bytes)
+{
+	const uint8_t *src = ptr;
+	uint8_t *dst = sink->w_ptr;
+	uint32_t n;
+
+	while (bytes) {
+		n = MIN(audio_stream_bytes_without_wrap(source, src),
+			audio_stream_bytes_without_wrap(sink, dst));
+		n = MIN(n, bytes);
+		memcpy_s(dst, n, src, n);
+		src = audio_stream_wrap(source, (uint8_t *)src + n);
+		dst = audio_stream_wrap(sink, dst + n);
+		bytes -= n;
+	}
+}
+
+/* Converts the source to the sink, or copies the samples converted for an earlier sink of
+ * the same output format when there are enough of them.
+ */
+static int do_fanout_conversion_copy(struct comp_dev *dev, struct copier_data *cd,
+				     struct comp_buffer __sparse_cache *src,
+				     struct comp_buffer *sink,
+				     struct comp_buffer __sparse_cache *sink_c,
+				     struct comp_copy_limits *processed_data,
+				     struct copier_converted *converted)
+{
+	struct comp_buffer __sparse_cache *conv_c;
+	struct copier_converted *conv;
+	void *ptr = sink_c->stream.w_ptr;
+	int pin = IPC4_SINK_QUEUE_ID(sink_c->id);
+	int ret;
+
+	if (pin >= IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT)
+		return -EINVAL;
+
+	conv = &converted[cd->conversion_pin[pin]];
+	if (conv->buffer && sink_c->hw_params_configured) {
+		comp_get_copy_limits(src, sink_c, processed_data);
+		if (processed_data->frames <= conv->frames) {
+			conv_c = buffer_acquire(conv->buffer);
+			copy_converted(&conv_c->stream, conv->ptr, &sink_c->stream,
+				       processed_data->sink_bytes);
+			buffer_release(conv_c);
+
+			buffer_stream_writeback(sink_c, processed_data->sink_bytes);
+			comp_update_buffer_produce(sink_c, processed_data->sink_bytes);
+			return 0;
+		}
+	}
+
+	ret = do_conversion_copy(dev, cd, src, sink_c, processed_data);
+	if (ret < 0 || conv->buffer || !src->hw_params_configured ||
+	    !sink_c->hw_params_configured)
+		return ret;
+
+	/* only share samples that had the attenuation applied while converting */
+	if (cd->attenuation &&
+	    !get_attenuated_converter(cd->converter[pin], src->stream.frame_fmt,
+				      sink_c->stream.frame_fmt))
+		return 0;
+
+	conv->buffer = sink;
+	conv->ptr = ptr;
+	conv->frames = processed_data->frames;
+
+	return 0;
+}
+
 /* Copier has one input and one or more outputs. Maximum of one gateway can be connected
  * to copier or no gateway connected at all. Gateway can only be connected to either input
  * pin 0 (the only input) or output pin 0. With or without connected gateway it is also
@@ -1265,6 +1513,7 @@ static int copier_copy(struct comp_dev *dev)
 	struct copier_data *cd = comp_get_drvdata(dev);
 	struct comp_buffer *src, *sink;
 	struct comp_buffer __sparse_cache *src_c, *sink_c;
+	struct copier_converted converted[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
 	struct comp_copy_limits processed_data;
 	struct list_item *sink_list;
 	int ret = 0;
@@ -1313,6 +1562,7 @@ static int copier_copy(struct comp_dev *dev)
 	}
 
 	/* zero or more components on outputs */
+	memset(converted, 0, sizeof(converted));
 	list_for_item(sink_list, &dev->bsink_list) {
 		struct comp_dev *sink_dev;
 
@@ -1321,7 +1571,8 @@ static int copier_copy(struct comp_dev *dev)
 		sink_dev = sink_c->sink;
 		processed_data.sink_bytes = 0;
 		if (sink_dev->state == COMP_STATE_ACTIVE) {
-			ret = do_conversion_copy(dev, cd, src_c, sink_c, &processed_data);
+			ret = do_fanout_conversion_copy(dev, cd, src_c, sink, sink_c,
+							&processed_data, converted);
 			cd->output_total_data_processed += processed_data.sink_bytes;
 		}
 		buffer_release(sink_c);
@@ -1550,6 +1801,7 @@ static int copier_set_sink_fmt(struct comp_dev *dev, const void *data,
 	cd->converter[sink_fmt->sink_id] = get_converter_func(&sink_fmt->source_fmt,
 							      &sink_fmt->sink_fmt, ipc4_gtw_none,
 							      ipc4_bidirection);
+	copier_update_conversion_pins(cd);
 
 	/* update corresponding sink format */
 	list_for_item(sink_list, &dev->bsink_list) {
@@ -1578,7 +1830,6 @@ static int set_attenuation(struct comp_dev *dev, uint32_t data_offset, const cha
 	struct list_item *sink_list;
 	uint32_t attenuation;
 
-	/* only support attenuation in format of 32bit */
 	if (data_offset > sizeof(uint32_t)) {
 		comp_err(dev, "attenuation data size %d is incorrect", data_offset);
 		return -EINVAL;
@@ -1592,7 +1843,9 @@ static int set_attenuation(struct comp_dev *dev, uint32_t data_offset, const cha
 
 	list_for_item(sink_list, &dev->bsink_list) {
 		sink = container_of(sink_list, struct comp_buffer, source_list);
-		if (sink->stream.frame_fmt < SOF_IPC_FRAME_S24_4LE) {
+		if (sink->stream.frame_fmt != SOF_IPC_FRAME_S16_LE &&
+		    sink->stream.frame_fmt != SOF_IPC_FRAME_S24_4LE &&
+		    sink->stream.frame_fmt != SOF_IPC_FRAME_S32_LE) {
 			comp_err(dev, "sink %d in format %d isn't supported by attenuation",
 				 sink->id, sink->buffer_fmt);
 			return -EINVAL;
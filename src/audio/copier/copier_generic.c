@@ -20,6 +20,151 @@
 
 LOG_MODULE_REGISTER(copier_generic, CONFIG_SOF_LOG_LEVEL);
 
+/* Conversions with attenuation fused in, each one gives the same result as the
+ * plain pcm converter followed by the attenuation shift of the output samples.
+ */
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE
+static void att_s16_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int16_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = src[i] >> attenuation;
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE || CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static void att_s32_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = src[i] >> attenuation;
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+static void att_s16_to_s24(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = (src[i] << 8) >> attenuation;
+}
+
+static void att_s24_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int32_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(sign_extend_s24(src[i]), 23, 15)) >> attenuation;
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static void att_s16_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int16_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = (src[i] << 16) >> attenuation;
+}
+
+static void att_s32_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int32_t *src = psrc;
+	int16_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = sat_int16(Q_SHIFT_RND(src[i], 31, 15)) >> attenuation;
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static void att_s24_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = (src[i] << 8) >> attenuation;
+}
+
+static void att_s32_to_s24(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	const int32_t *src = psrc;
+	int32_t *dst = pdst;
+	uint32_t i;
+
+	for (i = 0; i < samples; i++)
+		dst[i] = sat_int24(Q_SHIFT_RND(src[i], 31, 23)) >> attenuation;
+}
+#endif
+
+static const struct {
+	enum sof_ipc_frame in;
+	enum sof_ipc_frame out;
+	copier_att_lin_func func;
+} att_func_map[] = {
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, att_s16_to_s16 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, att_s32_to_s32 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, att_s32_to_s32 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, att_s16_to_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, att_s24_to_s16 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, att_s16_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, att_s32_to_s16 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, att_s24_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, att_s32_to_s24 },
+#endif
+};
+
+copier_att_lin_func get_attenuated_converter(pcm_converter_func converter,
+					     enum sof_ipc_frame in, enum sof_ipc_frame out)
+{
+	int i;
+
+	/* gateway specific converters have no fused variant */
+	if (converter != pcm_get_conversion_function(in, out))
+		return NULL;
+
+	for (i = 0; i < ARRAY_SIZE(att_func_map); i++)
+		if (att_func_map[i].in == in && att_func_map[i].out == out)
+			return att_func_map[i].func;
+
+	return NULL;
+}
+
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer __sparse_cache *sink, int frame)
 {
@@ -29,11 +174,22 @@ int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 	int remaining_samples = frame * sink->stream.channels;
 	int32_t *dst = sink->stream.r_ptr;
 
-	/* only support attenuation in format of 32bit */
+	int16_t *dst16 = sink->stream.r_ptr;
+
 	switch (sink->stream.frame_fmt) {
 	case SOF_IPC_FRAME_S16_LE:
-		comp_err(dev, "16bit sample isn't supported by attenuation");
-		return -EINVAL;
+		while (remaining_samples) {
+			nmax = audio_stream_samples_without_wrap_s16(&sink->stream, dst16);
+			n = MIN(remaining_samples, nmax);
+			for (i = 0; i < n; i++) {
+				*dst16 >>= cd->attenuation;
+				dst16++;
+			}
+			remaining_samples -= n;
+			dst16 = audio_stream_wrap(&sink->stream, dst16);
+		}
+
+		return 0;
 	case SOF_IPC_FRAME_S24_4LE:
 	case SOF_IPC_FRAME_S32_LE:
 		while (remaining_samples) {
@@ -20,46 +20,324 @@
 
 LOG_MODULE_REGISTER(copier_hifi, CONFIG_SOF_LOG_LEVEL);
 
+/* Conversions with attenuation fused in. Each one converts the samples the same
+ * way as the HiFi3 pcm converter and shifts the converted lanes by the
+ * attenuation before the store.
+ */
+static void att_s16_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int16x4 sample;
+	ae_int32x2 val1;
+	ae_int32x2 val2;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int16x4 *in = (ae_int16x4 *)psrc;
+	ae_int16x4 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 2; i++) {
+		/* load four 16 bit samples, shift them as 32 bit and truncate back */
+		AE_LA16X4_IP(sample, inu, in);
+		val1 = AE_SRAA32(AE_SEXT32X2D16_32(sample), attenuation);
+		val2 = AE_SRAA32(AE_SEXT32X2D16_10(sample), attenuation);
+		AE_SA16X4_IP(AE_CVT16X4(val1, val2), outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	for (i = 0; i < (samples & 0x03); i++) {
+		AE_L16_IP(sample, (ae_int16 *)in, sizeof(ae_int16));
+		val1 = AE_SRAA32(AE_SEXT32X2D16_10(sample), attenuation);
+		sample = AE_CVT16X4(val1, val1);
+		AE_S16_0_IP(AE_MOVAD16_0(sample), (ae_int16 *)out, sizeof(ae_int16));
+	}
+}
+
+static void att_s32_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int32x2 sample;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int32x2 *in = (ae_int32x2 *)psrc;
+	ae_int32x2 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 1; i++) {
+		AE_LA32X2_IP(sample, inu, in);
+		sample = AE_SRAA32(sample, attenuation);
+		AE_SA32X2_IP(sample, outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	if (samples & 0x01) {
+		AE_L32_IP(sample, (ae_int32 *)in, sizeof(ae_int32));
+		sample = AE_SRAA32(sample, attenuation);
+		AE_S32_L_IP(sample, (ae_int32 *)out, sizeof(ae_int32));
+	}
+}
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+static void att_s16_to_s24(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int16x4 sample;
+	ae_int32x2 val1;
+	ae_int32x2 val2;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int16x4 *in = (ae_int16x4 *)psrc;
+	ae_int32x2 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 2; i++) {
+		/* convert four 16 bit samples as the pcm converter and shift them */
+		AE_LA16X4_IP(sample, inu, in);
+		val1 = AE_SRAI32(AE_CVT32X2F16_32(sample), 8);
+		val2 = AE_SRAI32(AE_CVT32X2F16_10(sample), 8);
+		AE_SA32X2_IP(AE_SRAA32(val1, attenuation), outu, out);
+		AE_SA32X2_IP(AE_SRAA32(val2, attenuation), outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	for (i = 0; i < (samples & 0x03); i++) {
+		AE_L16_IP(sample, (ae_int16 *)in, sizeof(ae_int16));
+		val1 = AE_SRAI32(AE_CVT32X2F16_32(sample), 8);
+		AE_S32_L_IP(AE_SRAA32(val1, attenuation), (ae_int32 *)out, sizeof(ae_int32));
+	}
+}
+
+/* same shift with saturation and rounding as the pcm converter */
+static ae_int32x2 att_shift_s24_to_s16(ae_int32x2 sample)
+{
+	sample = AE_SLAA32(sample, 8);
+	sample = AE_SRAI32R(sample, 16);
+	sample = AE_SLAI32S(sample, 16);
+	sample = AE_SRAI32(sample, 16);
+
+	return sample;
+}
+
+static void att_s24_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int16x4 sample;
+	ae_int32x2 val1;
+	ae_int32x2 val2;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int32x2 *in = (ae_int32x2 *)psrc;
+	ae_int16x4 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 2; i++) {
+		AE_LA32X2_IP(val1, inu, in);
+		AE_LA32X2_IP(val2, inu, in);
+		val1 = AE_SRAA32(att_shift_s24_to_s16(val1), attenuation);
+		val2 = AE_SRAA32(att_shift_s24_to_s16(val2), attenuation);
+		AE_SA16X4_IP(AE_CVT16X4(val1, val2), outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	for (i = 0; i < (samples & 0x03); i++) {
+		AE_L32_IP(val1, (ae_int32 *)in, sizeof(ae_int32));
+		val1 = AE_SRAA32(att_shift_s24_to_s16(val1), attenuation);
+		sample = AE_MOVINT16X4_FROMINT32X2(val1);
+		AE_S16_0_IP(AE_MOVAD16_0(sample), (ae_int16 *)out, sizeof(ae_int16));
+	}
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static void att_s16_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int16x4 sample;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int16x4 *in = (ae_int16x4 *)psrc;
+	ae_int32x2 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 2; i++) {
+		AE_LA16X4_IP(sample, inu, in);
+		AE_SA32X2_IP(AE_SRAA32(AE_CVT32X2F16_32(sample), attenuation), outu, out);
+		AE_SA32X2_IP(AE_SRAA32(AE_CVT32X2F16_10(sample), attenuation), outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	for (i = 0; i < (samples & 0x03); i++) {
+		AE_L16_IP(sample, (ae_int16 *)in, sizeof(ae_int16));
+		AE_S32_L_IP(AE_SRAA32(AE_CVT32X2F16_32(sample), attenuation), (ae_int32 *)out,
+			    sizeof(ae_int32));
+	}
+}
+
+static void att_s32_to_s16(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int16x4 sample;
+	ae_int32x2 val1;
+	ae_int32x2 val2;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int32x2 *in = (ae_int32x2 *)psrc;
+	ae_int16x4 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 2; i++) {
+		/* round to 16 bits as the pcm converter, shift as 32 bit and truncate back */
+		AE_LA32X2_IP(val1, inu, in);
+		AE_LA32X2_IP(val2, inu, in);
+		sample = AE_ROUND16X4F32SSYM(val1, val2);
+		val1 = AE_SRAA32(AE_SEXT32X2D16_32(sample), attenuation);
+		val2 = AE_SRAA32(AE_SEXT32X2D16_10(sample), attenuation);
+		AE_SA16X4_IP(AE_CVT16X4(val1, val2), outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	for (i = 0; i < (samples & 0x03); i++) {
+		AE_L32_IP(val1, (ae_int32 *)in, sizeof(ae_int32));
+		sample = AE_ROUND16X4F32SSYM(val1, val1);
+		val1 = AE_SRAA32(AE_SEXT32X2D16_10(sample), attenuation);
+		sample = AE_CVT16X4(val1, val1);
+		AE_S16_0_IP(AE_MOVAD16_0(sample), (ae_int16 *)out, sizeof(ae_int16));
+	}
+}
+#endif
+
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+static void att_s24_to_s32(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int32x2 sample;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int32x2 *in = (ae_int32x2 *)psrc;
+	ae_int32x2 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 1; i++) {
+		AE_LA32X2_IP(sample, inu, in);
+		sample = AE_SRAA32(AE_SLAI32(sample, 8), attenuation);
+		AE_SA32X2_IP(sample, outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	if (samples & 0x01) {
+		AE_L32_IP(sample, (ae_int32 *)in, sizeof(ae_int32));
+		sample = AE_SRAA32(AE_SLAI32(sample, 8), attenuation);
+		AE_S32_L_IP(sample, (ae_int32 *)out, sizeof(ae_int32));
+	}
+}
+
+/* same shift with saturation and rounding as the pcm converter */
+static ae_int32x2 att_shift_s32_to_s24(ae_int32x2 sample)
+{
+	sample = AE_SRAI32R(sample, 8);
+	sample = AE_SLAI32S(sample, 8);
+	sample = AE_SRAI32(sample, 8);
+
+	return sample;
+}
+
+static void att_s32_to_s24(const void *psrc, void *pdst, uint32_t samples,
+			   uint32_t attenuation)
+{
+	ae_int32x2 sample;
+	ae_valign inu;
+	ae_valign outu = AE_ZALIGN64();
+	ae_int32x2 *in = (ae_int32x2 *)psrc;
+	ae_int32x2 *out = pdst;
+	uint32_t i;
+
+	inu = AE_LA64_PP(in);
+	for (i = 0; i < samples >> 1; i++) {
+		AE_LA32X2_IP(sample, inu, in);
+		sample = AE_SRAA32(att_shift_s32_to_s24(sample), attenuation);
+		AE_SA32X2_IP(sample, outu, out);
+	}
+	AE_SA64POS_FP(outu, out);
+
+	if (samples & 0x01) {
+		AE_L32_IP(sample, (ae_int32 *)in, sizeof(ae_int32));
+		sample = AE_SRAA32(att_shift_s32_to_s24(sample), attenuation);
+		AE_S32_L_IP(sample, (ae_int32 *)out, sizeof(ae_int32));
+	}
+}
+#endif
+
+static const struct {
+	enum sof_ipc_frame in;
+	enum sof_ipc_frame out;
+	copier_att_lin_func func;
+} att_func_map[] = {
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, att_s16_to_s16 },
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S24_4LE, att_s32_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, att_s32_to_s32 },
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S24_4LE, att_s16_to_s24 },
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S16_LE, att_s24_to_s16 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S16LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, att_s16_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, att_s32_to_s16 },
+#endif
+#if CONFIG_PCM_CONVERTER_FORMAT_S24LE && CONFIG_PCM_CONVERTER_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, att_s24_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, att_s32_to_s24 },
+#endif
+};
+
+copier_att_lin_func get_attenuated_converter(pcm_converter_func converter,
+					     enum sof_ipc_frame in, enum sof_ipc_frame out)
+{
+	int i;
+
+	/* gateway specific converters have no fused variant */
+	if (converter != pcm_get_conversion_function(in, out))
+		return NULL;
+
+	for (i = 0; i < ARRAY_SIZE(att_func_map); i++)
+		if (att_func_map[i].in == in && att_func_map[i].out == out)
+			return att_func_map[i].func;
+
+	return NULL;
+}
+
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer __sparse_cache *sink, int frame)
 {
-	int i;
 	int n;
 	int nmax;
-	int m;
-	ae_int32x2 sample;
-	ae_valign uu = AE_ZALIGN64();
-	ae_valign su = AE_ZALIGN64();
 	int remaining_samples = frame * sink->stream.channels;
 	uint32_t *dst = sink->stream.r_ptr;
-	ae_int32x2 *in = (ae_int32x2 *)dst;
-	ae_int32x2 *out = (ae_int32x2 *)dst;
+	int16_t *dst16 = sink->stream.r_ptr;
 
-	/* only support attenuation in format of 32bit */
 	switch (sink->stream.frame_fmt) {
 	case SOF_IPC_FRAME_S16_LE:
-		comp_err(dev, "16bit sample isn't supported by attenuation");
-		return -EINVAL;
+		while (remaining_samples) {
+			nmax = audio_stream_samples_without_wrap_s16(&sink->stream, dst16);
+			n = MIN(remaining_samples, nmax);
+			att_s16_to_s16(dst16, dst16, n, cd->attenuation);
+			remaining_samples -= n;
+			dst16 = audio_stream_wrap(&sink->stream, dst16 + n);
+		}
+
+		return 0;
 	case SOF_IPC_FRAME_S24_4LE:
 	case SOF_IPC_FRAME_S32_LE:
 		while (remaining_samples) {
 			nmax = audio_stream_samples_without_wrap_s32(&sink->stream, dst);
-			in = (ae_int32x2 *)dst;
-			out = (ae_int32x2 *)dst;
-			uu = AE_LA64_PP(in);
 			n = MIN(remaining_samples, nmax);
-			m = n >> 1;
-			for (i = 0; i < m; i++) {
-				AE_LA32X2_IP(sample, uu, in);
-				sample = AE_SRAA32(sample, cd->attenuation);
-				AE_SA32X2_IP(sample, su, out);
-			}
-			AE_SA64POS_FP(su, out);
-			if (n & 0x01) {
-				AE_L32_IP(sample, (ae_int32 *)in, sizeof(ae_int32));
-				sample = AE_SRAA32(sample, cd->attenuation);
-				AE_S32_L_IP(sample, (ae_int32 *)out, sizeof(ae_int32));
-			}
+			att_s32_to_s32(dst, dst, n, cd->attenuation);
 			remaining_samples -= n;
 			dst = audio_stream_wrap(&sink->stream, dst + n);
 		}
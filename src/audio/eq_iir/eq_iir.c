@@ -47,6 +47,7 @@ DECLARE_TR_CTX(eq_iir_tr, SOF_UUID(eq_iir_uuid), LOG_LEVEL_INFO);
 /* IIR component private data */
 struct comp_data {
 	struct iir_state_df1 iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	struct iir_multi_state_df1 multi;	/**< channels in lockstep state */
 	struct comp_data_blob_handler *model_handler;
 	struct sof_eq_iir_config *config;
 	int32_t *iir_delay;			/**< pointer to allocated RAM */
@@ -300,6 +301,220 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE */
 #endif /* CONFIG_IPC_MAJOR_3 */
 
+/*
+ * Process all channels in lockstep with the multi-channel IIR. Samples are
+ * converted to and from Q1.31 the same way as in the per channel functions
+ * above so the output is bit exact with them.
+ */
+#if CONFIG_FORMAT_S16LE
+static void eq_iir_multi_s16(struct processing_module *mod, struct input_stream_buffer *bsource,
+			     struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	const int nch = source->channels;
+	int16_t *x = source->r_ptr;
+	int16_t *y = sink->w_ptr;
+	int remaining = frames;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int j;
+
+	while (remaining) {
+		n1 = audio_stream_frames_without_wrap(source, x);
+		n2 = audio_stream_frames_without_wrap(sink, y);
+		n = MIN(n1, n2);
+		n = MIN(n, remaining);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < nch; j++)
+				frame[j] = (int32_t)x[j] << 16;
+
+			iir_df1_multi(&cd->multi, frame);
+			for (j = 0; j < nch; j++)
+				y[j] = iir_df1_out_s16(frame[j]);
+
+			x += nch;
+			y += nch;
+		}
+		remaining -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void eq_iir_multi_s24(struct processing_module *mod, struct input_stream_buffer *bsource,
+			     struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	const int nch = source->channels;
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int remaining = frames;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int j;
+
+	while (remaining) {
+		n1 = audio_stream_frames_without_wrap(source, x);
+		n2 = audio_stream_frames_without_wrap(sink, y);
+		n = MIN(n1, n2);
+		n = MIN(n, remaining);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < nch; j++)
+				frame[j] = x[j] << 8;
+
+			iir_df1_multi(&cd->multi, frame);
+			for (j = 0; j < nch; j++)
+				y[j] = iir_df1_out_s24(frame[j]);
+
+			x += nch;
+			y += nch;
+		}
+		remaining -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void eq_iir_multi_s32(struct processing_module *mod, struct input_stream_buffer *bsource,
+			     struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	const int nch = source->channels;
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int remaining = frames;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int j;
+
+	while (remaining) {
+		n1 = audio_stream_frames_without_wrap(source, x);
+		n2 = audio_stream_frames_without_wrap(sink, y);
+		n = MIN(n1, n2);
+		n = MIN(n, remaining);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < nch; j++)
+				frame[j] = x[j];
+
+			iir_df1_multi(&cd->multi, frame);
+			for (j = 0; j < nch; j++)
+				y[j] = frame[j];
+
+			x += nch;
+			y += nch;
+		}
+		remaining -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_IPC_MAJOR_3
+#if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE
+static void eq_iir_multi_s32_s16(struct processing_module *mod,
+				 struct input_stream_buffer *bsource,
+				 struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	const int nch = source->channels;
+	int32_t *x = source->r_ptr;
+	int16_t *y = sink->w_ptr;
+	int remaining = frames;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int j;
+
+	while (remaining) {
+		n1 = audio_stream_frames_without_wrap(source, x);
+		n2 = audio_stream_frames_without_wrap(sink, y);
+		n = MIN(n1, n2);
+		n = MIN(n, remaining);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < nch; j++)
+				frame[j] = x[j];
+
+			iir_df1_multi(&cd->multi, frame);
+			for (j = 0; j < nch; j++)
+				y[j] = iir_df1_out_s16(frame[j]);
+
+			x += nch;
+			y += nch;
+		}
+		remaining -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE
+static void eq_iir_multi_s32_s24(struct processing_module *mod,
+				 struct input_stream_buffer *bsource,
+				 struct output_stream_buffer *bsink, uint32_t frames)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	const int nch = source->channels;
+	int32_t *x = source->r_ptr;
+	int32_t *y = sink->w_ptr;
+	int remaining = frames;
+	int n1;
+	int n2;
+	int n;
+	int i;
+	int j;
+
+	while (remaining) {
+		n1 = audio_stream_frames_without_wrap(source, x);
+		n2 = audio_stream_frames_without_wrap(sink, y);
+		n = MIN(n1, n2);
+		n = MIN(n, remaining);
+		for (i = 0; i < n; i++) {
+			for (j = 0; j < nch; j++)
+				frame[j] = x[j];
+
+			iir_df1_multi(&cd->multi, frame);
+			for (j = 0; j < nch; j++)
+				y[j] = iir_df1_out_s24(frame[j]);
+
+			x += nch;
+			y += nch;
+		}
+		remaining -= n;
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE */
+#endif /* CONFIG_IPC_MAJOR_3 */
+
 static void eq_iir_pass(struct processing_module *mod, struct input_stream_buffer *bsource,
 			struct output_stream_buffer *bsink, uint32_t frames)
 {
@@ -469,6 +684,37 @@ static eq_iir_func eq_iir_find_func(struct processing_module *mod)
 }
 #endif /* CONFIG_IPC_MAJOR_4 */
 
+/* Find the lockstep multi-channel variant of a per channel processing
+ * function. The per channel delay lines are not set up in lockstep mode so
+ * there is no fallback to the per channel function.
+ */
+static eq_iir_func eq_iir_find_multi_func(eq_iir_func func)
+{
+#if CONFIG_FORMAT_S16LE
+	if (func == eq_iir_s16_default)
+		return eq_iir_multi_s16;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	if (func == eq_iir_s24_default)
+		return eq_iir_multi_s24;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	if (func == eq_iir_s32_default)
+		return eq_iir_multi_s32;
+#endif /* CONFIG_FORMAT_S32LE */
+#if CONFIG_IPC_MAJOR_3
+#if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE
+	if (func == eq_iir_s32_16_default)
+		return eq_iir_multi_s32_s16;
+#endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE
+	if (func == eq_iir_s32_24_default)
+		return eq_iir_multi_s32_s24;
+#endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE */
+#endif /* CONFIG_IPC_MAJOR_3 */
+	return NULL;
+}
+
 static void eq_iir_free_delaylines(struct comp_data *cd)
 {
 	struct iir_state_df1 *iir = cd->iir;
@@ -480,6 +726,7 @@ static void eq_iir_free_delaylines(struct comp_data *cd)
 	rfree(cd->iir_delay);
 	cd->iir_delay = NULL;
 	cd->iir_delay_size = 0;
+	iir_reset_multi_df1(&cd->multi);
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		iir[i].delay = NULL;
 }
@@ -592,6 +839,7 @@ static void eq_iir_init_delay(struct iir_state_df1 *iir,
 static int eq_iir_setup(struct processing_module *mod, int nch)
 {
 	struct comp_data *cd = module_get_private_data(mod);
+	int multi_size;
 	int delay_size;
 
 	/* Free existing IIR channels data if it was allocated */
@@ -608,6 +856,24 @@ static int eq_iir_setup(struct processing_module *mod, int nch)
 	if (!delay_size)
 		return 0;
 
+	/* Channels with the same biquads structure are run in lockstep with
+	 * interleaved coefficients and delay lines.
+	 */
+	multi_size = iir_multi_size_df1(cd->iir, nch);
+	if (multi_size > 0) {
+		cd->iir_delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+					multi_size);
+		if (!cd->iir_delay) {
+			comp_err(mod->dev, "eq_iir_setup(), delay allocation fail");
+			return -ENOMEM;
+		}
+
+		cd->iir_delay_size = multi_size;
+		iir_init_multi_df1(&cd->multi, cd->iir, nch, cd->iir_delay);
+		comp_info(mod->dev, "eq_iir_setup(), %d channels in lockstep", nch);
+		return 0;
+	}
+
 	/* Allocate all IIR channels data in a big chunk and clear it */
 	cd->iir_delay = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
 				delay_size);
@@ -782,6 +1048,8 @@ static int eq_iir_new_blob(struct processing_module *mod, struct comp_data *cd,
 #elif CONFIG_IPC_MAJOR_4
 		cd->eq_iir_func = eq_iir_find_func(mod);
 #endif
+		if (cd->multi.channels)
+			cd->eq_iir_func = eq_iir_find_multi_func(cd->eq_iir_func);
 	} else {
 		comp_dbg(mod->dev, "eq_iir_new_blob(), pass-through");
 #if CONFIG_IPC_MAJOR_3
@@ -113,10 +113,11 @@ static void kpb_copy_samples(struct comp_buffer __sparse_cache *sink,
 			     struct comp_buffer __sparse_cache *source, size_t size,
 			     size_t sample_width, uint32_t channels);
 static void kpb_drain_samples(void *source, struct audio_stream __sparse_cache *sink,
-			      size_t size, size_t sample_width);
+			      size_t size, size_t sample_width,
+			      const struct history_data *hd);
 static void kpb_buffer_samples(const struct audio_stream __sparse_cache *source,
 			       int offset, void *sink, size_t size,
-			       size_t sample_width);
+			       size_t sample_width, const struct history_data *hd);
 static void kpb_reset_history_buffer(struct history_buffer *buff);
 static inline bool validate_host_params(struct comp_dev *dev,
 					size_t host_period_size,
@@ -130,6 +131,60 @@ static uint64_t kpb_task_deadline(void *data)
 	return SOF_TASK_DEADLINE_ALMOST_IDLE;
 }
 
+/**
+ * \brief Get number of bytes a sample takes in history buffer.
+ * \param[in] sample_width - stream sample width.
+ * \param[in] valid_bits - valid bits of stream samples.
+ *
+ * \return number of bytes per sample.
+ */
+static uint32_t kpb_hb_sample_bytes(size_t sample_width, uint32_t valid_bits)
+{
+#if CONFIG_KPB_HISTORY_SAMPLE_16
+	return 2;
+#elif CONFIG_KPB_HISTORY_SAMPLE_24
+	/* keep all valid bits up to 24, the packing needs at least 2 bytes */
+	return MAX(SOF_DIV_ROUND_UP(MIN(valid_bits, 24), 8), 2);
+#else
+	return sample_width >> 3;
+#endif
+}
+
+/**
+ * \brief Get number of valid bits rounded off in history buffer.
+ * \param[in] hd - history buffer data.
+ *
+ * \return shift of the samples, zero if the stored bytes keep all valid bits.
+ */
+static inline int kpb_hb_round_shift(const struct history_data *hd)
+{
+	return MAX((int)hd->valid_bits - (int)(hd->sample_bytes << 3), 0);
+}
+
+/**
+ * \brief Convert stream bytes to history buffer bytes.
+ * \param[in] hd - history buffer data.
+ * \param[in] bytes - number of stream bytes, multiple of sample size.
+ *
+ * \return number of history buffer bytes.
+ */
+static inline size_t kpb_hb_bytes(const struct history_data *hd, size_t bytes)
+{
+	return bytes / hd->container_bytes * hd->sample_bytes;
+}
+
+/**
+ * \brief Convert history buffer bytes to stream bytes.
+ * \param[in] hd - history buffer data.
+ * \param[in] hb_bytes - number of history buffer bytes.
+ *
+ * \return number of stream bytes.
+ */
+static inline size_t kpb_stream_bytes(const struct history_data *hd, size_t hb_bytes)
+{
+	return hb_bytes / hd->sample_bytes * hd->container_bytes;
+}
+
 #ifdef __ZEPHYR__
 
 static void kpb_lock(struct comp_data *kpb)
@@ -183,6 +238,7 @@ static int kpb_set_verify_ipc_params(struct comp_dev *dev,
 		ipc_config->base_cfg.audio_fmt.sampling_frequency;
 	kpb->config.sampling_width =
 		ipc_config->base_cfg.audio_fmt.valid_bit_depth;
+	kpb->hd.valid_bits = kpb->config.sampling_width;
 	kpb->ipc4_cfg.base_cfg = ipc_config->base_cfg;
 
 	/* Initialize sinks */
@@ -471,11 +527,85 @@ static struct comp_dev *kpb_new(const struct comp_driver *drv,
 	return dev;
 }
 
+/**
+ * \brief Allocate the largest block of the given memory caps.
+ * \param[in] caps - memory caps of the block.
+ * \param[in] max_size - size of the block we would like to have.
+ * \param[in] frame_bytes - block size granularity.
+ * \param[out] size - size of the allocated block.
+ *
+ * The largest block fitting in the heap is found with a binary search over
+ * the block size, a failed allocation is an upper bound and a successful
+ * one a lower bound. A successful try is freed right away, so it doesn't
+ * take the space of the larger tries, and the block of the final lower
+ * bound is allocated once the bounds are closer than KPB_ALLOCATION_STEP.
+ *
+ * \return: pointer to the block or NULL if nothing could be allocated.
+ */
+void *kpb_alloc_largest_block(uint32_t caps, size_t max_size,
+			      size_t frame_bytes, size_t *size)
+{
+	size_t lo = 0;
+	size_t hi = ROUND_DOWN(max_size, frame_bytes);
+	size_t try_size = hi;
+	size_t step = MAX(frame_bytes, KPB_ALLOCATION_STEP);
+	void *block = NULL;
+	uint64_t time_start;
+	uint64_t time_total = 0;
+	uint64_t time;
+	int attempts = 0;
+
+	while (try_size > lo) {
+		time_start = sof_cycle_get_64();
+		block = rballoc(0, caps, try_size);
+		time = sof_cycle_get_64() - time_start;
+		time_total += time;
+		attempts++;
+
+		comp_cl_dbg(&comp_kpb, "kpb_alloc_largest_block(): caps 0x%x size %u ok %d, %u us",
+			    caps, try_size, !!block, (unsigned int)k_cyc_to_us_near64(time));
+
+		if (block) {
+			/* the whole request fits */
+			if (try_size == hi) {
+				lo = try_size;
+				break;
+			}
+
+			/* free the space for the larger tries */
+			rfree(block);
+			block = NULL;
+			lo = try_size;
+		} else {
+			hi = try_size;
+		}
+
+		if (hi - lo < step)
+			break;
+
+		try_size = ROUND_DOWN(lo + (hi - lo) / 2, frame_bytes);
+	}
+
+	/* allocate the largest size that fit */
+	if (!block && lo) {
+		block = rballoc(0, caps, lo);
+		if (!block)
+			lo = 0;
+	}
+
+	comp_cl_info(&comp_kpb, "kpb_alloc_largest_block(): caps 0x%x %u bytes, %d tries, %u us",
+		     caps, lo, attempts, (unsigned int)k_cyc_to_us_near64(time_total));
+
+	*size = lo;
+	return block;
+}
+
 /**
  * \brief Allocate history buffer.
  * \param[in] kpb - KPB component data pointer.
+ * \param[in] hb_size_req - requested size of history buffer in bytes.
  *
- * \return: none.
+ * \return: allocated size of history buffer in bytes.
  */
 static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
 					  size_t hb_size_req)
@@ -485,14 +615,15 @@ static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
 	/*! Total allocation size */
 	size_t hb_size = hb_size_req;
 	/*! Current allocation size */
-	size_t ca_size = hb_size;
+	size_t ca_size;
 	/*! Memory caps priorites for history buffer */
 	int hb_mcp[KPB_NO_OF_MEM_POOLS] = {SOF_MEM_CAPS_LP, SOF_MEM_CAPS_HP,
 					   SOF_MEM_CAPS_RAM };
 	void *new_mem_block = NULL;
-	size_t temp_ca_size;
-	int i = 0;
+	int i;
 	size_t allocated_size = 0;
+	/* Blocks hold whole frames, packed samples can't be split */
+	size_t frame_bytes = kpb->hd.sample_bytes * kpb->config.channels;
 
 	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer()");
 
@@ -508,64 +639,45 @@ static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
 	/* Allocate history buffer/s. KPB history buffer has a size of
 	 * KPB_MAX_BUFFER_SIZE, since there is no single memory block
 	 * that big, we need to allocate couple smaller blocks which
-	 * linked together will form history buffer.
+	 * linked together will form history buffer. Each memory caps
+	 * provides its largest block that is still needed.
 	 */
-	while (hb_size > 0 && i < ARRAY_SIZE(hb_mcp)) {
-		/* Try to allocate ca_size (current allocation size). At first
-		 * attempt it will be equal to hb_size (history buffer size).
-		 */
-		new_mem_block = rballoc(0, hb_mcp[i], ca_size);
+	for (i = 0; hb_size > 0 && i < ARRAY_SIZE(hb_mcp); i++) {
+		new_mem_block = kpb_alloc_largest_block(hb_mcp[i], hb_size,
+							frame_bytes, &ca_size);
+		if (!new_mem_block)
+			continue;
 
-		if (new_mem_block) {
-			/* We managed to allocate a block of ca_size.
-			 * Now we initialize it.
-			 */
-			comp_cl_info(&comp_kpb, "kpb new memory block: %d",
-				     ca_size);
-			allocated_size += ca_size;
-			hb->start_addr = new_mem_block;
-			hb->end_addr = (char *)new_mem_block +
-				ca_size;
-			hb->w_ptr = new_mem_block;
-			hb->r_ptr = new_mem_block;
-			hb->state = KPB_BUFFER_FREE;
-			hb_size -= ca_size;
-			hb->next = kpb->hd.c_hb;
-			/* Do we need another buffer? */
-			if (hb_size > 0) {
-				/* Yes, we still need at least one more buffer.
-				 * Let's first create new container for it.
-				 */
-				new_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0,
-						 SOF_MEM_CAPS_RAM,
-						 sizeof(struct history_buffer));
-				if (!new_hb)
-					return 0;
-				hb->next = new_hb;
-				new_hb->next = kpb->hd.c_hb;
-				new_hb->state = KPB_BUFFER_OFF;
-				new_hb->prev = hb;
-				hb = new_hb;
-				kpb->hd.c_hb->prev = new_hb;
-				ca_size = hb_size;
-				i++;
-			}
-		} else {
-			/* We've failed to allocate ca_size of that hb_mcp
-			 * let's try again with some smaller size.
-			 * NOTE! If we decrement by some small value,
-			 * the allocation will take significant time.
-			 * However, bigger values like
-			 * HEAP_HP_BUFFER_BLOCK_SIZE will result in lower
-			 * accuracy of allocation.
+		/* We managed to allocate a block of ca_size.
+		 * Now we initialize it.
+		 */
+		comp_cl_info(&comp_kpb, "kpb new memory block: %d",
+			     ca_size);
+		allocated_size += ca_size;
+		hb->start_addr = new_mem_block;
+		hb->end_addr = (char *)new_mem_block +
+			ca_size;
+		hb->w_ptr = new_mem_block;
+		hb->r_ptr = new_mem_block;
+		hb->state = KPB_BUFFER_FREE;
+		hb_size -= ca_size;
+		hb->next = kpb->hd.c_hb;
+		/* Do we need another buffer? */
+		if (hb_size > 0) {
+			/* Yes, we still need at least one more buffer.
+			 * Let's first create new container for it.
 			 */
-			temp_ca_size = ca_size - KPB_ALLOCATION_STEP;
-			ca_size = (ca_size < temp_ca_size) ? 0 : temp_ca_size;
-			if (ca_size == 0) {
-				ca_size = hb_size;
-				i++;
-			}
-			continue;
+			new_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0,
+					 SOF_MEM_CAPS_RAM,
+					 sizeof(struct history_buffer));
+			if (!new_hb)
+				return 0;
+			hb->next = new_hb;
+			new_hb->next = kpb->hd.c_hb;
+			new_hb->state = KPB_BUFFER_OFF;
+			new_hb->prev = hb;
+			hb = new_hb;
+			kpb->hd.c_hb->prev = new_hb;
 		}
 	}
 
@@ -691,6 +803,10 @@ static int kpb_params(struct comp_dev *dev,
 	kpb->host_buffer_size = params->buffer.size;
 	kpb->host_period_size = params->host_period_bytes;
 	kpb->config.sampling_width = params->sample_container_bytes * 8;
+	if (params->sample_valid_bytes)
+		kpb->hd.valid_bits = params->sample_valid_bytes * 8;
+	else
+		kpb->hd.valid_bits = kpb->config.sampling_width;
 
 	return 0;
 }
@@ -709,6 +825,9 @@ static int kpb_prepare(struct comp_dev *dev)
 	int ret = 0;
 	int i;
 	size_t hb_size_req = KPB_MAX_BUFFER_SIZE(kpb->config.sampling_width, kpb->config.channels);
+	uint32_t container_bytes = KPB_SAMPLE_CONTAINER_SIZE(kpb->config.sampling_width) / 8;
+	uint32_t sample_bytes = kpb_hb_sample_bytes(kpb->config.sampling_width,
+						    kpb->hd.valid_bits);
 
 	comp_dbg(dev, "kpb_prepare()");
 
@@ -737,16 +856,25 @@ static int kpb_prepare(struct comp_dev *dev)
 	kpb->kpb_no_of_clients = 0;
 	kpb->hd.buffered = 0;
 
-	if (kpb->hd.c_hb && kpb->hd.buffer_size < hb_size_req) {
+	if (kpb->hd.c_hb && (kpb->hd.buffer_size < hb_size_req ||
+			     kpb->hd.container_bytes != container_bytes ||
+			     kpb->hd.sample_bytes != sample_bytes)) {
 		/* Host params has changed, we need to allocate new buffer */
 		kpb_free_history_buffer(kpb->hd.c_hb);
 		kpb->hd.c_hb = NULL;
 	}
 
 	if (!kpb->hd.c_hb) {
-		/* Allocate history buffer */
-		kpb->hd.buffer_size = kpb_allocate_history_buffer(kpb,
-								  hb_size_req);
+		/* Allocate history buffer. Its size is accounted as stream
+		 * bytes, the samples may be stored with less bytes.
+		 */
+		kpb->hd.container_bytes = container_bytes;
+		kpb->hd.sample_bytes = sample_bytes;
+		kpb->hd.buffer_size =
+			kpb_stream_bytes(&kpb->hd,
+					 kpb_allocate_history_buffer(kpb,
+								     kpb_hb_bytes(&kpb->hd,
+										  hb_size_req)));
 
 		/* Have we allocated what we requested? */
 		if (kpb->hd.buffer_size < hb_size_req) {
@@ -1359,7 +1487,8 @@ static int kpb_buffer_data(struct comp_dev *dev,
 		}
 
 		/* Check how much space there is in current write buffer */
-		space_avail = (uintptr_t)buff->end_addr - (uintptr_t)buff->w_ptr;
+		space_avail = kpb_stream_bytes(&kpb->hd, (uintptr_t)buff->end_addr -
+						(uintptr_t)buff->w_ptr);
 
 		if (size_to_copy > space_avail) {
 			/* We have more data to copy than available space
@@ -1367,9 +1496,9 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			 * with next buffer.
 			 */
 			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   space_avail, sample_width);
+					   space_avail, sample_width, &kpb->hd);
 			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + space_avail;
+			buff->w_ptr = (char *)buff->w_ptr + kpb_hb_bytes(&kpb->hd, space_avail);
 			size_to_copy = size_to_copy - space_avail;
 			/* Update read pointer's offset before continuing
 			 * with next buffer.
@@ -1381,9 +1510,9 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			 * copy what was requested.
 			 */
 			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   size_to_copy, sample_width);
+					   size_to_copy, sample_width, &kpb->hd);
 			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + size_to_copy;
+			buff->w_ptr = (char *)buff->w_ptr + kpb_hb_bytes(&kpb->hd, size_to_copy);
 			/* Reset requested copy size */
 			size_to_copy = 0;
 		}
@@ -1560,11 +1689,11 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 			if (buff->state == KPB_BUFFER_FREE) {
 				local_buffered = (uintptr_t)buff->w_ptr -
 						 (uintptr_t)buff->start_addr;
-				buffered += local_buffered;
+				buffered += kpb_stream_bytes(&kpb->hd, local_buffered);
 			} else if (buff->state == KPB_BUFFER_FULL) {
 				local_buffered = (uintptr_t)buff->end_addr -
 						 (uintptr_t)buff->start_addr;
-				buffered += local_buffered;
+				buffered += kpb_stream_bytes(&kpb->hd, local_buffered);
 			} else {
 				comp_err(dev, "kpb_init_draining(): incorrect buffer label");
 			}
@@ -1582,10 +1711,12 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 					 * and buffer's end address.
 					 */
 					buff = buff->prev;
-					buffered += (uintptr_t)buff->end_addr -
-						    (uintptr_t)buff->w_ptr;
+					buffered += kpb_stream_bytes(&kpb->hd,
+								     (uintptr_t)buff->end_addr -
+								     (uintptr_t)buff->w_ptr);
 					buff->r_ptr = (char *)buff->w_ptr +
-						      (buffered - drain_req);
+						      kpb_hb_bytes(&kpb->hd,
+								   buffered - drain_req);
 					break;
 				}
 				buff = buff->prev;
@@ -1594,7 +1725,7 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 				break;
 			} else {
 				buff->r_ptr = (char *)buff->start_addr +
-					      (buffered - drain_req);
+					      kpb_hb_bytes(&kpb->hd, buffered - drain_req);
 				break;
 			}
 
@@ -1668,6 +1799,7 @@ static enum task_state kpb_draining_task(void *arg)
 	size_t sample_width = draining_data->sample_width;
 	size_t size_to_read;
 	size_t size_to_copy;
+	size_t sink_free;
 	bool move_buffer = false;
 	uint32_t drained = 0;
 	uint64_t draining_time_start;
@@ -1716,13 +1848,17 @@ static enum task_state kpb_draining_task(void *arg)
 			period_copy_start = sof_cycle_get_64();
 		}
 
-		size_to_read = (uintptr_t)buff->end_addr - (uintptr_t)buff->r_ptr;
+		size_to_read = kpb_stream_bytes(&kpb->hd, (uintptr_t)buff->end_addr -
+						 (uintptr_t)buff->r_ptr);
+		/* Drain whole samples, history may store them packed */
+		sink_free = ROUND_DOWN(audio_stream_get_free_bytes(&sink->stream),
+				       kpb->hd.container_bytes);
 
-		if (size_to_read > audio_stream_get_free_bytes(&sink->stream)) {
-			if (audio_stream_get_free_bytes(&sink->stream) >= drain_req)
+		if (size_to_read > sink_free) {
+			if (sink_free >= drain_req)
 				size_to_copy = drain_req;
 			else
-				size_to_copy = audio_stream_get_free_bytes(&sink->stream);
+				size_to_copy = sink_free;
 		} else {
 			if (size_to_read > drain_req) {
 				size_to_copy = drain_req;
@@ -1733,9 +1869,9 @@ static enum task_state kpb_draining_task(void *arg)
 		}
 
 		kpb_drain_samples(buff->r_ptr, &sink->stream, size_to_copy,
-				  sample_width);
+				  sample_width, &kpb->hd);
 
-		buff->r_ptr = (char *)buff->r_ptr + (uint32_t)size_to_copy;
+		buff->r_ptr = (char *)buff->r_ptr + kpb_hb_bytes(&kpb->hd, size_to_copy);
 		drain_req -= size_to_copy;
 		drained += size_to_copy;
 		period_bytes += size_to_copy;
@@ -1882,17 +2018,60 @@ static void kpb_convert_24b_to_32b(const void *source, int ioffset,
 	}
 }
 #endif
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/**
+ * \brief Unpack 16 or 24 bit history samples to 32 bit containers.
+ * \param[in] linear_source - history buffer read position.
+ * \param[in,out] sink - sink stream.
+ * \param[in] samples - number of samples.
+ * \param[in] hd - history buffer data with stored samples format.
+ */
+void kpb_unpack_32b(const void *linear_source, struct audio_stream __sparse_cache *sink,
+		    unsigned int samples, const struct history_data *hd)
+{
+	const uint8_t *src = linear_source;
+	int32_t *dst = sink->w_ptr;
+	int shift = kpb_hb_round_shift(hd);
+	int32_t x;
+	int processed;
+	int nmax, i, n;
+
+	for (processed = 0; processed < samples; processed += n) {
+		dst = audio_stream_wrap(sink, dst);
+		n = samples - processed;
+		nmax = KPB_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(sink, dst));
+		n = MIN(n, nmax);
+		if (hd->sample_bytes == 2) {
+			for (i = 0; i < n; i++) {
+				x = (int16_t)(src[0] | (src[1] << 8));
+				*dst++ = (int32_t)((uint32_t)x << shift);
+				src += 2;
+			}
+		} else {
+			for (i = 0; i < n; i++) {
+				x = sign_extend_s24(src[0] | (src[1] << 8) | (src[2] << 16));
+				*dst++ = (int32_t)((uint32_t)x << shift);
+				src += 3;
+			}
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
 /**
  * \brief Drain data samples safe, according to configuration.
  *
  * \param[in] sink - pointer to sink buffer.
  * \param[in] source - pointer to source buffer.
- * \param[in] size - requested copy size in bytes.
+ * \param[in] size - requested copy size in stream bytes.
+ * \param[in] sample_width - stream sample width.
+ * \param[in] hd - history buffer data with stored samples format.
  *
  * \return none.
  */
 static void kpb_drain_samples(void *source, struct audio_stream __sparse_cache *sink,
-			      size_t size, size_t sample_width)
+			      size_t size, size_t sample_width,
+			      const struct history_data *hd)
 {
 	unsigned int samples;
 
@@ -1905,12 +2084,14 @@ static void kpb_drain_samples(void *source, struct audio_stream __sparse_cache *
 #endif /* CONFIG_FORMAT_S16LE */
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 	case 24:
-		samples = size / ((sample_width >> 3) * sink->channels);
-		kpb_convert_24b_to_32b(source, 0, sink, 0, samples);
-		break;
 	case 32:
 		samples = KPB_BYTES_TO_S32_SAMPLES(size);
-		audio_stream_copy_from_linear(source, 0, sink, 0, samples);
+		if (hd->sample_bytes == sizeof(int32_t))
+			audio_stream_copy_from_linear(source, 0, sink, 0, samples);
+		else if (sample_width == 24 && hd->sample_bytes == 3)
+			kpb_convert_24b_to_32b(source, 0, sink, 0, samples);
+		else
+			kpb_unpack_32b(source, sink, samples, hd);
 		break;
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 	default:
@@ -1981,17 +2162,65 @@ static void kpb_convert_32b_to_24b(const struct audio_stream __sparse_cache *sou
 	}
 }
 #endif
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+/**
+ * \brief Round and pack 32 bit container samples to 16 or 24 bits.
+ * \param[in] source - source stream.
+ * \param[in] ioffset - source offset in samples.
+ * \param[out] linear_sink - history buffer write position.
+ * \param[in] samples - number of samples.
+ * \param[in] hd - history buffer data with stored samples format.
+ */
+void kpb_pack_32b(const struct audio_stream __sparse_cache *source, int ioffset,
+		  void *linear_sink, unsigned int samples,
+		  const struct history_data *hd)
+{
+	int32_t *src = audio_stream_wrap(source, (uint8_t *)source->r_ptr +
+					 ioffset * sizeof(int32_t));
+	uint8_t *dst = linear_sink;
+	int sext = 32 - hd->valid_bits;
+	int shift = kpb_hb_round_shift(hd);
+	int32_t x;
+	int processed;
+	int nmax, i, n;
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = audio_stream_wrap(source, src);
+		n = samples - processed;
+		nmax = KPB_BYTES_TO_S32_SAMPLES(audio_stream_bytes_without_wrap(source, src));
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			/* sign extend the valid bits and round to stored bits */
+			x = (int32_t)((uint32_t)*src++ << sext) >> sext;
+			if (shift)
+				x = ((x >> (shift - 1)) + 1) >> 1;
+
+			if (hd->sample_bytes == 2) {
+				x = sat_int16(x);
+			} else {
+				x = sat_int24(x);
+				dst[2] = (x >> 16) & 0xFF;
+			}
+			dst[0] = x & 0xFF;
+			dst[1] = (x >> 8) & 0xFF;
+			dst += hd->sample_bytes;
+		}
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
 /**
  * \brief Buffers data samples safe, according to configuration.
  * \param[in,out] source Pointer to source buffer.
  * \param[in] offset Start offset of source buffer in bytes.
  * \param[in,out] sink Pointer to sink buffer.
- * \param[in] size Requested copy size in bytes.
+ * \param[in] size Requested copy size in stream bytes.
  * \param[in] sample_width Sample size.
+ * \param[in] hd History buffer data with stored samples format.
  */
 static void kpb_buffer_samples(const struct audio_stream __sparse_cache *source,
 			       int offset, void *sink, size_t size,
-			       size_t sample_width)
+			       size_t sample_width, const struct history_data *hd)
 {
 	unsigned int samples_count;
 	int samples_offset;
@@ -2007,16 +2236,17 @@ static void kpb_buffer_samples(const struct audio_stream __sparse_cache *source,
 #endif
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 	case 24:
-		samples_count =  size / ((sample_width >> 3) * source->channels);
-		samples_offset = offset / ((sample_width >> 3) * source->channels);
-		kpb_convert_32b_to_24b(source, samples_offset,
-				       sink, 0, samples_count);
-		break;
 	case 32:
 		samples_count = KPB_BYTES_TO_S32_SAMPLES(size);
 		samples_offset = KPB_BYTES_TO_S32_SAMPLES(offset);
-		audio_stream_copy_to_linear(source, samples_offset,
-					    sink, 0, samples_count);
+		if (hd->sample_bytes == sizeof(int32_t))
+			audio_stream_copy_to_linear(source, samples_offset,
+						    sink, 0, samples_count);
+		else if (sample_width == 24 && hd->sample_bytes == 3)
+			kpb_convert_32b_to_24b(source, samples_offset,
+					       sink, 0, samples_count);
+		else
+			kpb_pack_32b(source, samples_offset, sink, samples_count, hd);
 		break;
 #endif
 	default:
@@ -170,11 +170,9 @@ static void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	int j;
 	int n;
 
-	/* Copy overlapped samples from state buffer. Imaginary part of input
-	 * remains zero.
-	 */
+	/* Copy overlapped samples from state buffer */
 	for (j = 0; j < state->prev_data_size; j++)
-		fft->fft_buf[idx + j].real = state->prev_data[j];
+		fft->fft_buf[idx + j] = state->prev_data[j];
 
 	/* Copy hop size of new data from circular buffer */
 	idx += state->prev_data_size;
@@ -183,7 +181,7 @@ static void mfcc_fill_fft_buffer(struct mfcc_state *state)
 		n = mfcc_buffer_samples_without_wrap(buf, r);
 		n = MIN(n, nmax);
 		for (j = 0; j < n; j++) {
-			fft->fft_buf[idx].real = *r;
+			fft->fft_buf[idx] = *r;
 			r++;
 			idx++;
 		}
@@ -197,7 +195,7 @@ static void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	/* Copy for next time data back to overlap buffer */
 	idx = fft->fft_fill_start_idx + fft->fft_hop_size;
 	for (j = 0; j < state->prev_data_size; j++)
-		state->prev_data[j] = fft->fft_buf[idx + j].real;
+		state->prev_data[j] = fft->fft_buf[idx + j];
 }
 
 #ifdef MFCC_NORMALIZE_FFT
@@ -212,7 +210,7 @@ static int mfcc_normalize_fft_buffer(struct mfcc_state *state)
 	int i = fft->fft_fill_start_idx;
 
 	for (j = 0; j < fft->fft_size; j++) {
-		x = fft->fft_buf[i + j].real;
+		x = fft->fft_buf[i + j];
 		absx = (x < 0) ? -x : x;
 		if (smax < absx)
 			smax = absx;
@@ -237,15 +235,15 @@ static void mfcc_apply_window(struct mfcc_state *state, int input_shift)
 	int s = 14 - input_shift; /* Q1.15 x Q1.15 -> Q30 -> Q15, shift by 15 - 1 for round */
 
 	for (j = 0; j < fft->fft_size; j++) {
-		x = (int32_t)fft->fft_buf[i + j].real * state->window[j];
-		fft->fft_buf[i + j].real = ((x >> s) + 1) >> 1;
+		x = (int32_t)fft->fft_buf[i + j] * state->window[j];
+		fft->fft_buf[i + j] = ((x >> s) + 1) >> 1;
 	}
 #else
 	/* TODO: Use proper multiply and saturate function to make sure no overflows */
 	int s = input_shift + 1; /* To convert 16 -> 32 with Q1.15 x Q1.15 -> Q30 -> Q31 */
 
 	for (j = 0; j < fft->fft_size; j++)
-		fft->fft_buf[i + j].real = (fft->fft_buf[i + j].real * state->window[j]) << s;
+		fft->fft_buf[i + j] = (fft->fft_buf[i + j] * state->window[j]) << s;
 #endif
 }
 
@@ -290,7 +288,7 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 	m = buf->s_avail / fft->fft_hop_size;
 	for (i = 0; i < m; i++) {
 		/* Clear FFT input buffer because it has been used as scratch */
-		bzero(fft->fft_buf, fft->fft_buffer_size);
+		bzero(fft->fft_buf, fft->fft_buf_size);
 
 		/* Copy data to FFT input buffer from overlap buffer and from new samples buffer */
 		mfcc_fill_fft_buffer(state);
@@ -313,19 +311,14 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 
 #ifdef DEBUGFILES
 		for (j = 0; j < fft->fft_padded_size; j++)
-			fprintf(fh_fft_in, "%d %d\n", fft->fft_buf[j].real, fft->fft_buf[j].imag);
+			fprintf(fh_fft_in, "%d %d\n", fft->fft_buf[j], 0);
 #endif
 
-		/* The FFT out buffer needs to be cleared to avoid to corrupt
-		 * the output. TODO: check moving it to FFT lib.
-		 */
-		bzero(fft->fft_out, fft->fft_buffer_size);
-
-		/* Compute FFT */
+		/* Compute FFT, the real input FFT writes all half_fft_size output bins */
 #if MFCC_FFT_BITS == 16
-		fft_execute_16(fft->fft_plan, false);
+		fft_execute_real_16(fft->fft_plan);
 #else
-		fft_execute_32(fft->fft_plan, false);
+		fft_execute_real_32(fft->fft_plan);
 #endif
 
 #ifdef DEBUGFILES_READ_FFT
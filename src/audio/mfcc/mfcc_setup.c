@@ -218,13 +218,19 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	state->prev_data = state->buffers + state->buffer_size;
 	state->window = state->prev_data + state->prev_data_size;
 
-	/* Allocate buffers for FFT input and output data */
+	/* Allocate buffers for FFT input and output data. The real input buffer
+	 * is also the scratch for power spectra. The output buffer is kept at
+	 * full FFT size for the Mel filterbank setup scratch use.
+	 */
 #if MFCC_FFT_BITS == 16
+	fft->fft_buf_size = fft->fft_padded_size * sizeof(int16_t);
 	fft->fft_buffer_size = fft->fft_padded_size * sizeof(struct icomplex16);
 #else
+	fft->fft_buf_size = fft->fft_padded_size * sizeof(int32_t);
 	fft->fft_buffer_size = fft->fft_padded_size * sizeof(struct icomplex32);
 #endif
-	fft->fft_buf = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, fft->fft_buffer_size);
+	fft->fft_buf_size = MAX(fft->fft_buf_size, (int)(fft->half_fft_size * sizeof(int32_t)));
+	fft->fft_buf = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, fft->fft_buf_size);
 	if (!fft->fft_buf) {
 		comp_err(dev, "mfcc_setup(): Failed FFT buffer allocate");
 		ret = -ENOMEM;
@@ -241,8 +247,8 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	fft->fft_fill_start_idx = 0; /* From config pad_type */
 
 	/* Setup FFT */
-	fft->fft_plan = fft_plan_new(fft->fft_buf, fft->fft_out, fft->fft_padded_size,
-				     MFCC_FFT_BITS);
+	fft->fft_plan = fft_plan_new_real(fft->fft_buf, fft->fft_out, fft->fft_padded_size,
+					  MFCC_FFT_BITS);
 	if (!fft->fft_plan) {
 		comp_err(dev, "mfcc_setup(): Failed FFT init");
 		ret = -EINVAL;
@@ -275,7 +281,7 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	fb->half_fft_bins = (fft->fft_padded_size >> 1) + 1;
 	fb->scratch_data1 = (int16_t *)fft->fft_buf;
 	fb->scratch_data2 = (int16_t *)fft->fft_out;
-	fb->scratch_length1 = fft->fft_buffer_size / sizeof(int16_t);
+	fb->scratch_length1 = fft->fft_buf_size / sizeof(int16_t);
 	fb->scratch_length2 = fft->fft_buffer_size / sizeof(int16_t);
 	ret = psy_get_mel_filterbank(fb);
 	if (ret < 0) {
@@ -305,11 +311,11 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	/* Scratch overlay during runtime
 	 *
 	 *  +--------------------------------------------------------+
-	 *  | 1. fft_buf[], 16 bits,size x 4, e.g. 512 -> 2048 bytes |
-	 *  +-------------------------------------+------------------+
-	 *  | 3. power_spectra[],                 |
-	 *  |    32 bits, e.g. x257 -> 1028 bytes |
-	 *  +-------------------------------------+
+	 *  | 1. fft_buf[], 16 bits real, e.g. 512 -> 1028 bytes     |
+	 *  +--------------------------------------------------------+
+	 *  | 3. power_spectra[],                                    |
+	 *  |    32 bits, e.g. x257 -> 1028 bytes                    |
+	 *  +--------------------------------------------------------+
 	 *
 	 *  +---------------------------------------------------------------------------------+
 	 *  | 2. fft_out[], 16 bits,size x 4, e.g. 512 -> 2048 bytes                          |
@@ -9,7 +9,59 @@
 
 #ifdef MIXER_GENERIC
 
+/*
+ * The sources are mixed in spans that do not wrap in any of the buffers.
+ * Inside a span the samples of all sources are added in a wide accumulator
+ * and saturated once. Two and four sources are mixed in a single loop, any
+ * other count adds the sources one by one into a stack accumulator of
+ * MIX_CHUNK_SAMPLES. All the inner loops are simple enough for the compiler
+ * to vectorize.
+ */
+#define MIX_CHUNK_SAMPLES	64
+
 #if CONFIG_FORMAT_S16LE
+static void mix_span_s16(int16_t *dest, int16_t **src, uint32_t num_sources, int n)
+{
+	const int16_t *s0 = src[0];
+	const int16_t *s1;
+	const int16_t *s2;
+	const int16_t *s3;
+	const int16_t *s;
+	int32_t acc[MIX_CHUNK_SAMPLES];
+	int i, j, k, m;
+
+	switch (num_sources) {
+	case 2:
+		s1 = src[1];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int16((int32_t)s0[i] + s1[i]);
+		return;
+	case 4:
+		s1 = src[1];
+		s2 = src[2];
+		s3 = src[3];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int16((int32_t)s0[i] + s1[i] + s2[i] + s3[i]);
+		return;
+	}
+
+	for (k = 0; k < n; k += m) {
+		m = MIN(n - k, MIX_CHUNK_SAMPLES);
+		for (i = 0; i < m; i++)
+			acc[i] = s0[k + i];
+
+		for (j = 1; j < num_sources; j++) {
+			s = src[j] + k;
+			for (i = 0; i < m; i++)
+				acc[i] += s[i];
+		}
+
+		/* Saturate to 16 bits */
+		for (i = 0; i < m; i++)
+			dest[k + i] = sat_int16(acc[i]);
+	}
+}
+
 /* Mix n 16 bit PCM source streams to one sink stream */
 static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 		      const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
@@ -17,16 +69,15 @@ static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	int16_t *src[PLATFORM_MAX_CHANNELS];
 	int16_t *dest;
-	int32_t val;
 	int nmax;
-	int i, j, n, ns;
+	int i, n, ns;
 	int processed = 0;
 	int nch = sink->channels;
 	int samples = frames * nch;
 
 	dest = sink->w_ptr;
-	for (j = 0; j < num_sources; j++)
-		src[j] = sources[j]->r_ptr;
+	for (i = 0; i < num_sources; i++)
+		src[i] = sources[i]->r_ptr;
 
 	while (processed < samples) {
 		nmax = samples - processed;
@@ -36,26 +87,61 @@ static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *
 			ns = audio_stream_samples_without_wrap_s16(sources[i], src[i]);
 			n = MIN(n, ns);
 		}
-		for (i = 0; i < n; i++) {
-			val = 0;
-			for (j = 0; j < num_sources; j++) {
-				val += *src[j];
-				src[j]++;
-			}
-
-			/* Saturate to 16 bits */
-			*dest = sat_int16(val);
-			dest++;
-		}
+
+		mix_span_s16(dest, src, num_sources, n);
+
 		processed += n;
-		dest = audio_stream_wrap(sink, dest);
+		dest = audio_stream_wrap(sink, dest + n);
 		for (i = 0; i < num_sources; i++)
-			src[i] = audio_stream_wrap(sources[i], src[i]);
+			src[i] = audio_stream_wrap(sources[i], src[i] + n);
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
+static void mix_span_s24(int32_t *dest, int32_t **src, uint32_t num_sources, int n)
+{
+	const int32_t *s0 = src[0];
+	const int32_t *s1;
+	const int32_t *s2;
+	const int32_t *s3;
+	const int32_t *s;
+	int32_t acc[MIX_CHUNK_SAMPLES];
+	int i, j, k, m;
+
+	switch (num_sources) {
+	case 2:
+		s1 = src[1];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int24(sign_extend_s24(s0[i]) + sign_extend_s24(s1[i]));
+		return;
+	case 4:
+		s1 = src[1];
+		s2 = src[2];
+		s3 = src[3];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int24(sign_extend_s24(s0[i]) + sign_extend_s24(s1[i]) +
+					    sign_extend_s24(s2[i]) + sign_extend_s24(s3[i]));
+		return;
+	}
+
+	for (k = 0; k < n; k += m) {
+		m = MIN(n - k, MIX_CHUNK_SAMPLES);
+		for (i = 0; i < m; i++)
+			acc[i] = sign_extend_s24(s0[k + i]);
+
+		for (j = 1; j < num_sources; j++) {
+			s = src[j] + k;
+			for (i = 0; i < m; i++)
+				acc[i] += sign_extend_s24(s[i]);
+		}
+
+		/* Saturate to 24 bits */
+		for (i = 0; i < m; i++)
+			dest[k + i] = sat_int24(acc[i]);
+	}
+}
+
 /* Mix n 24 bit PCM source streams to one sink stream */
 static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 		      const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
@@ -63,17 +149,15 @@ static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	int32_t *src[PLATFORM_MAX_CHANNELS];
 	int32_t *dest;
-	int32_t val;
-	int32_t x;
 	int nmax;
-	int i, j, n, ns;
+	int i, n, ns;
 	int processed = 0;
 	int nch = sink->channels;
 	int samples = frames * nch;
 
 	dest = sink->w_ptr;
-	for (j = 0; j < num_sources; j++)
-		src[j] = sources[j]->r_ptr;
+	for (i = 0; i < num_sources; i++)
+		src[i] = sources[i]->r_ptr;
 
 	while (processed < samples) {
 		nmax = samples - processed;
@@ -83,27 +167,60 @@ static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *
 			ns = audio_stream_samples_without_wrap_s24(sources[i], src[i]);
 			n = MIN(n, ns);
 		}
-		for (i = 0; i < n; i++) {
-			val = 0;
-			for (j = 0; j < num_sources; j++) {
-				x = *src[j] << 8;
-				val += x >> 8; /* Sign extend */
-				src[j]++;
-			}
-
-			/* Saturate to 24 bits */
-			*dest = sat_int24(val);
-			dest++;
-		}
+
+		mix_span_s24(dest, src, num_sources, n);
+
 		processed += n;
-		dest = audio_stream_wrap(sink, dest);
+		dest = audio_stream_wrap(sink, dest + n);
 		for (i = 0; i < num_sources; i++)
-			src[i] = audio_stream_wrap(sources[i], src[i]);
+			src[i] = audio_stream_wrap(sources[i], src[i] + n);
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
 
 #if CONFIG_FORMAT_S32LE
+static void mix_span_s32(int32_t *dest, int32_t **src, uint32_t num_sources, int n)
+{
+	const int32_t *s0 = src[0];
+	const int32_t *s1;
+	const int32_t *s2;
+	const int32_t *s3;
+	const int32_t *s;
+	int64_t acc[MIX_CHUNK_SAMPLES];
+	int i, j, k, m;
+
+	switch (num_sources) {
+	case 2:
+		s1 = src[1];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int32((int64_t)s0[i] + s1[i]);
+		return;
+	case 4:
+		s1 = src[1];
+		s2 = src[2];
+		s3 = src[3];
+		for (i = 0; i < n; i++)
+			dest[i] = sat_int32((int64_t)s0[i] + s1[i] + s2[i] + s3[i]);
+		return;
+	}
+
+	for (k = 0; k < n; k += m) {
+		m = MIN(n - k, MIX_CHUNK_SAMPLES);
+		for (i = 0; i < m; i++)
+			acc[i] = s0[k + i];
+
+		for (j = 1; j < num_sources; j++) {
+			s = src[j] + k;
+			for (i = 0; i < m; i++)
+				acc[i] += s[i];
+		}
+
+		/* Saturate to 32 bits */
+		for (i = 0; i < m; i++)
+			dest[k + i] = sat_int32(acc[i]);
+	}
+}
+
 /* Mix n 32 bit PCM source streams to one sink stream */
 static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 		      const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
@@ -111,16 +228,15 @@ static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	int32_t *src[PLATFORM_MAX_CHANNELS];
 	int32_t *dest;
-	int64_t val;
 	int nmax;
-	int i, j, n, ns;
+	int i, n, ns;
 	int processed = 0;
 	int nch = sink->channels;
 	int samples = frames * nch;
 
 	dest = sink->w_ptr;
-	for (j = 0; j < num_sources; j++)
-		src[j] = sources[j]->r_ptr;
+	for (i = 0; i < num_sources; i++)
+		src[i] = sources[i]->r_ptr;
 
 	while (processed < samples) {
 		nmax = samples - processed;
@@ -130,21 +246,13 @@ static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *
 			ns = audio_stream_samples_without_wrap_s32(sources[i], src[i]);
 			n = MIN(n, ns);
 		}
-		for (i = 0; i < n; i++) {
-			val = 0;
-			for (j = 0; j < num_sources; j++) {
-				val += *src[j];
-				src[j]++;
-			}
-
-			/* Saturate to 32 bits */
-			*dest = sat_int32(val);
-			dest++;
-		}
+
+		mix_span_s32(dest, src, num_sources, n);
+
 		processed += n;
-		dest = audio_stream_wrap(sink, dest);
+		dest = audio_stream_wrap(sink, dest + n);
 		for (i = 0; i < num_sources; i++)
-			src[i] = audio_stream_wrap(sources[i], src[i]);
+			src[i] = audio_stream_wrap(sources[i], src[i] + n);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
@@ -11,7 +11,25 @@
 
 #include <xtensa/tie/xt_hifi3.h>
 
+/*
+ * The sources are mixed in spans that do not wrap in any of the buffers.
+ * The samples are accumulated without saturation in 32 bit lanes for 16
+ * and 24 bit formats and in 64 bit for the 32 bit format, the accumulator
+ * can't overflow with up to PLATFORM_MAX_CHANNELS sources. The sum is
+ * saturated once when it is stored. Two and four sources are unrolled.
+ */
+
 #if CONFIG_FORMAT_S16LE
+/* Saturate two 32 bit sums of four 16 bit samples to 16 bits */
+static inline ae_int16x4 mix_sat16(ae_int32x2 val1, ae_int32x2 val2)
+{
+	val1 = AE_SRAA32S(AE_SLAA32S(val1, 16), 16);
+	val2 = AE_SRAA32S(AE_SLAA32S(val2, 16), 16);
+
+	/* truncate the LSB 16bit of four 32-bit signed elements*/
+	return AE_CVT16X4(val1, val2);
+}
+
 /* Mix n 16 bit PCM source streams to one sink stream */
 static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 		      const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
@@ -19,12 +37,13 @@ static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	ae_int16x4 * in[PLATFORM_MAX_CHANNELS];
 	ae_int16x4 *out = sink->w_ptr;
+	ae_int16x4 *in0, *in1, *in2, *in3;
 	ae_int16x4 sample = AE_ZERO16();
-	ae_int16x4 res = AE_ZERO16();
+	ae_int16x4 sample1 = AE_ZERO16();
+	ae_int16x4 sample2 = AE_ZERO16();
+	ae_int16x4 sample3 = AE_ZERO16();
 	ae_int32x2 val1;
 	ae_int32x2 val2;
-	ae_int32x2 sample_1;
-	ae_int32x2 sample_2;
 	unsigned int n, m, nmax, i, j, left_samples;
 	unsigned int samples = frames * sink->channels;
 
@@ -42,32 +61,79 @@ static void mix_n_s16(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		}
 		m = n >> 2;
 
-		for (i = 0; i < m; i++) {
-			val1 = AE_ZERO32();
-			val2 = AE_ZERO32();
-			for (j = 0; j < num_sources; j++) {
+		switch (num_sources) {
+		case 2:
+			in0 = in[0];
+			in1 = in[1];
+			for (i = 0; i < m; i++) {
 				/* load four 16 bit samples, 8 is sizeof(ae_int16x4) */
-				AE_L16X4_IP(sample, in[j], 8);
-				sample_1 = AE_SEXT32X2D16_32(sample);
-				sample_2 = AE_SEXT32X2D16_10(sample);
-				val1 = AE_ADD32S(val1, sample_1);
-				val2 = AE_ADD32S(val2, sample_2);
-			}
-			/*Saturate to 16 bits */
-			val1 = AE_SRAA32S(AE_SLAA32S(val1, 16), 16);
-			val2 = AE_SRAA32S(AE_SLAA32S(val2, 16), 16);
+				AE_L16X4_IP(sample, in0, 8);
+				AE_L16X4_IP(sample1, in1, 8);
 
-			/* truncate the LSB 16bit of four 32-bit signed elements*/
-			res = AE_CVT16X4(val1, val2);
+				/* two sources add with 16 bit saturation */
+				AE_S16X4_IP(AE_ADD16S(sample, sample1), out, 8);
+			}
+			in[0] = in0;
+			in[1] = in1;
+			break;
+		case 4:
+			in0 = in[0];
+			in1 = in[1];
+			in2 = in[2];
+			in3 = in[3];
+			for (i = 0; i < m; i++) {
+				AE_L16X4_IP(sample, in0, 8);
+				AE_L16X4_IP(sample1, in1, 8);
+				AE_L16X4_IP(sample2, in2, 8);
+				AE_L16X4_IP(sample3, in3, 8);
+				val1 = AE_ADD32(AE_ADD32(AE_SEXT32X2D16_32(sample),
+							 AE_SEXT32X2D16_32(sample1)),
+						AE_ADD32(AE_SEXT32X2D16_32(sample2),
+							 AE_SEXT32X2D16_32(sample3)));
+				val2 = AE_ADD32(AE_ADD32(AE_SEXT32X2D16_10(sample),
+							 AE_SEXT32X2D16_10(sample1)),
+						AE_ADD32(AE_SEXT32X2D16_10(sample2),
+							 AE_SEXT32X2D16_10(sample3)));
+				AE_S16X4_IP(mix_sat16(val1, val2), out, 8);
+			}
+			in[0] = in0;
+			in[1] = in1;
+			in[2] = in2;
+			in[3] = in3;
+			break;
+		default:
+			for (i = 0; i < m; i++) {
+				val1 = AE_ZERO32();
+				val2 = AE_ZERO32();
+				for (j = 0; j < num_sources; j++) {
+					/* load four 16 bit samples, 8 is sizeof(ae_int16x4) */
+					AE_L16X4_IP(sample, in[j], 8);
+					val1 = AE_ADD32(val1, AE_SEXT32X2D16_32(sample));
+					val2 = AE_ADD32(val2, AE_SEXT32X2D16_10(sample));
+				}
 
-			/* store four 16 bit samples, 8 is sizeof(ae_int16x4) */
-			AE_S16X4_IP(res, out, 8);
+				/* store four 16 bit samples, 8 is sizeof(ae_int16x4) */
+				AE_S16X4_IP(mix_sat16(val1, val2), out, 8);
+			}
+			break;
 		}
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
 #if CONFIG_FORMAT_S24LE
+/* Sign extend two 24 bit samples */
+static inline ae_int32x2 mix_sext24(ae_int32x2 sample)
+{
+	return AE_SRAA32RS(AE_SLAI32(sample, 8), 8);
+}
+
+/* Saturate two 32 bit sums to 24 bits */
+static inline ae_int32x2 mix_sat24(ae_int32x2 val)
+{
+	return AE_SRAA32S(AE_SLAA32S(val, 8), 8);
+}
+
 /* Mix n 24 bit PCM source streams to one sink stream */
 static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *sink,
 		      const struct audio_stream __sparse_cache **sources, uint32_t num_sources,
@@ -75,8 +141,12 @@ static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	ae_int32x2 *in[PLATFORM_MAX_CHANNELS];
 	ae_int32x2 *out = sink->w_ptr;
+	ae_int32x2 *in0, *in1, *in2, *in3;
 	ae_int32x2 val;
 	ae_int32x2 sample = AE_ZERO32();
+	ae_int32x2 sample1 = AE_ZERO32();
+	ae_int32x2 sample2 = AE_ZERO32();
+	ae_int32x2 sample3 = AE_ZERO32();
 	unsigned int n, m, nmax, i, j, left_samples;
 	unsigned int samples = frames * sink->channels;
 
@@ -93,20 +163,55 @@ static void mix_n_s24(struct comp_dev *dev, struct audio_stream __sparse_cache *
 			n = MIN(n, nmax);
 		}
 		m = n >> 1;
-		for (i = 0; i < m; i++) {
-			val = AE_ZERO32();
-			for (j = 0; j < num_sources; j++) {
+
+		switch (num_sources) {
+		case 2:
+			in0 = in[0];
+			in1 = in[1];
+			for (i = 0; i < m; i++) {
 				/* load two 32 bit samples, 8 is sizeof(ae_int32x2) */
-				AE_L32X2_IP(sample, in[j], 8);
-				/* Sign extend */
-				sample = AE_SRAA32RS(AE_SLAI32(sample, 8), 8);
-				val = AE_ADD32S(val, sample);
+				AE_L32X2_IP(sample, in0, 8);
+				AE_L32X2_IP(sample1, in1, 8);
+				val = AE_ADD32(mix_sext24(sample), mix_sext24(sample1));
+
+				/* store two 32 bit samples, 8 is sizeof(ae_int32x2) */
+				AE_S32X2_IP(mix_sat24(val), out, 8);
+			}
+			in[0] = in0;
+			in[1] = in1;
+			break;
+		case 4:
+			in0 = in[0];
+			in1 = in[1];
+			in2 = in[2];
+			in3 = in[3];
+			for (i = 0; i < m; i++) {
+				AE_L32X2_IP(sample, in0, 8);
+				AE_L32X2_IP(sample1, in1, 8);
+				AE_L32X2_IP(sample2, in2, 8);
+				AE_L32X2_IP(sample3, in3, 8);
+				val = AE_ADD32(AE_ADD32(mix_sext24(sample), mix_sext24(sample1)),
+					       AE_ADD32(mix_sext24(sample2), mix_sext24(sample3)));
+				AE_S32X2_IP(mix_sat24(val), out, 8);
 			}
-			/*Saturate to 24 bits */
-			val = AE_SRAA32S(AE_SLAA32S(val, 8), 8);
+			in[0] = in0;
+			in[1] = in1;
+			in[2] = in2;
+			in[3] = in3;
+			break;
+		default:
+			for (i = 0; i < m; i++) {
+				val = AE_ZERO32();
+				for (j = 0; j < num_sources; j++) {
+					/* load two 32 bit samples, 8 is sizeof(ae_int32x2) */
+					AE_L32X2_IP(sample, in[j], 8);
+					val = AE_ADD32(val, mix_sext24(sample));
+				}
 
-			/* store two 32 bit samples, 8 is sizeof(ae_int32x2) */
-			AE_S32X2_IP(val, out, 8);
+				/* store two 32 bit samples, 8 is sizeof(ae_int32x2) */
+				AE_S32X2_IP(mix_sat24(val), out, 8);
+			}
+			break;
 		}
 	}
 }
@@ -120,6 +225,7 @@ static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *
 {
 	ae_q32s * in[PLATFORM_MAX_CHANNELS];
 	ae_int32 *out = sink->w_ptr;
+	ae_q32s *in0, *in1, *in2, *in3;
 	ae_int64 sample;
 	ae_int64 val;
 	ae_int32x2 res;
@@ -141,18 +247,51 @@ static void mix_n_s32(struct comp_dev *dev, struct audio_stream __sparse_cache *
 		}
 		/*record the processed samples for next address iteration */
 		m = n;
-		for (i = 0; i < m; i++) {
-			val =  AE_ZERO64();
-			for (j = 0; j < num_sources; j++) {
-				/* load one 32 bit sample */
-				sample = AE_L32M_X(in[j],  i * sizeof(ae_q32s));
-				val = AE_ADD64S(val, sample);
+
+		switch (num_sources) {
+		case 2:
+			in0 = in[0];
+			in1 = in[1];
+			for (i = 0; i < m; i++) {
+				/* load one 32 bit sample of each source */
+				val = AE_ADD64(AE_L32M_X(in0, i * sizeof(ae_q32s)),
+					       AE_L32M_X(in1, i * sizeof(ae_q32s)));
+
+				/*Saturate to 32 bits */
+				res = AE_ROUND32X2F48SSYM(val, val);
+				AE_S32_L_IP(res, out, sizeof(ae_int32));
 			}
-			/*Saturate to 32 bits */
-			res =  AE_ROUND32X2F48SSYM(val, val);
+			break;
+		case 4:
+			in0 = in[0];
+			in1 = in[1];
+			in2 = in[2];
+			in3 = in[3];
+			for (i = 0; i < m; i++) {
+				val = AE_ADD64(AE_ADD64(AE_L32M_X(in0, i * sizeof(ae_q32s)),
+							AE_L32M_X(in1, i * sizeof(ae_q32s))),
+					       AE_ADD64(AE_L32M_X(in2, i * sizeof(ae_q32s)),
+							AE_L32M_X(in3, i * sizeof(ae_q32s))));
+				res = AE_ROUND32X2F48SSYM(val, val);
+				AE_S32_L_IP(res, out, sizeof(ae_int32));
+			}
+			break;
+		default:
+			for (i = 0; i < m; i++) {
+				val = AE_ZERO64();
+				for (j = 0; j < num_sources; j++) {
+					/* load one 32 bit sample */
+					sample = AE_L32M_X(in[j], i * sizeof(ae_q32s));
+					val = AE_ADD64(val, sample);
+				}
+
+				/*Saturate to 32 bits */
+				res = AE_ROUND32X2F48SSYM(val, val);
 
-			/* store one 32 bit samples */
-			AE_S32_L_IP(res, out, sizeof(ae_int32));
+				/* store one 32 bit samples */
+				AE_S32_L_IP(res, out, sizeof(ae_int32));
+			}
+			break;
 		}
 	}
 }
@@ -62,6 +62,12 @@ DECLARE_TR_CTX(mixout_tr, SOF_UUID(mixout_uuid), LOG_LEVEL_INFO);
  *
  * Such implementation has less buffer reads/writes than simple implementation
  * using intermediate buffer between mixin and mixout.
+ *
+ * A mixin without source data contributes silence, but it does not write it.
+ * Silence is only written to the part of mixout sink that no mixin has written
+ * when that part is needed: by a mixin that starts mixing after the part, or by
+ * mixout before producing it. So the first mixin with data copies to the sink
+ * and a period is written once even when some mixins are idle.
  */
 
 struct mixin_sink_config {
@@ -236,22 +242,18 @@ static int mix_and_remap(struct comp_dev *dev, const struct mixin_data *mixin_da
 	return 0;
 }
 
-/* mix silence into stream, i.e. set not yet mixed data in stream to zero */
-static void silence(struct audio_stream __sparse_cache *stream, uint32_t start_frame,
-		    uint32_t mixed_frames, uint32_t frame_count)
+/* set frames [mixed_frames, end_frame) of stream, not yet mixed, to zero */
+static void silence(struct audio_stream __sparse_cache *stream, uint32_t mixed_frames,
+		    uint32_t end_frame)
 {
-	uint32_t skip_mixed_frames;
 	uint8_t *ptr;
 	uint32_t size;
 	int n;
 
-	assert(mixed_frames >= start_frame);
-	skip_mixed_frames = mixed_frames - start_frame;
-
-	if (frame_count <= skip_mixed_frames)
+	if (end_frame <= mixed_frames)
 		return;
 
-	size = audio_stream_period_bytes(stream, frame_count - skip_mixed_frames);
+	size = audio_stream_period_bytes(stream, end_frame - mixed_frames);
 	ptr = (uint8_t *)stream->w_ptr + audio_stream_period_bytes(stream, mixed_frames);
 
 	while (size) {
@@ -424,28 +426,35 @@ static int mixin_process(struct processing_module *mod,
 		 */
 		start_frame = mixout_data->pending_frames[source_index];
 
+		/* if source does not produce any data but mixin is in active state -- its
+		 * output is silence. Nothing is written, frames not written by other mixins
+		 * are set to zero when needed.
+		 */
+		if (source_avail_frames == 0) {
+			mixout_data->pending_frames[source_index] += frames_to_copy;
+			module_source_info_release(mod_source_info);
+			continue;
+		}
+
 		sink_c = buffer_acquire(sink);
 
-		/* if source does not produce any data but mixin is in active state -- generate
-		 * silence instead of that source data
+		/* this mixin was idle while other mixins did not write, zero the gap */
+		if (start_frame > mixout_data->mixed_frames) {
+			silence(&sink_c->stream, mixout_data->mixed_frames, start_frame);
+			mixout_data->mixed_frames = start_frame;
+		}
+
+		/* basically, if sink buffer has no data -- copy source data there, if
+		 * sink buffer has some data (written by another mixin) mix that data
+		 * with source data.
 		 */
-		if (source_avail_frames == 0) {
-			/* generate silence */
-			silence(&sink_c->stream, start_frame, mixout_data->mixed_frames,
-				frames_to_copy);
-		} else {
-			/* basically, if sink buffer has no data -- copy source data there, if
-			 * sink buffer has some data (written by another mixin) mix that data
-			 * with source data.
-			 */
-			ret = mix_and_remap(dev, mixin_data, sinks_ids[i], &sink_c->stream,
-					    start_frame, mixout_data->mixed_frames,
-					    input_buffers[0].data, frames_to_copy);
-			if (ret < 0) {
-				buffer_release(sink_c);
-				module_source_info_release(mod_source_info);
-				return ret;
-			}
+		ret = mix_and_remap(dev, mixin_data, sinks_ids[i], &sink_c->stream,
+				    start_frame, mixout_data->mixed_frames,
+				    input_buffers[0].data, frames_to_copy);
+		if (ret < 0) {
+			buffer_release(sink_c);
+			module_source_info_release(mod_source_info);
+			return ret;
 		}
 
 		/* it would be better to writeback memory region starting from start_frame and
@@ -543,7 +552,20 @@ static int mixout_process(struct processing_module *mod,
 				md->pending_frames[source_index] = 0;
 		}
 
-		assert(md->mixed_frames >= frames_to_produce);
+		/* frames only idle mixins contributed to have not been written yet */
+		if (frames_to_produce > md->mixed_frames) {
+			struct comp_buffer __sparse_cache *sink_c;
+
+			sink_c = attr_container_of(output_buffers[0].data,
+						   struct comp_buffer __sparse_cache,
+						   stream, __sparse_cache);
+			silence(output_buffers[0].data, md->mixed_frames, frames_to_produce);
+			buffer_stream_writeback(sink_c,
+						audio_stream_period_bytes(output_buffers[0].data,
+									  frames_to_produce));
+			md->mixed_frames = frames_to_produce;
+		}
+
 		md->mixed_frames -= frames_to_produce;
 
 		sink_bytes = frames_to_produce *
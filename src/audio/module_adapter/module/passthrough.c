@@ -17,29 +17,20 @@ DECLARE_TR_CTX(passthrough_tr, SOF_UUID(passthrough_uuid), LOG_LEVEL_INFO);
 static int passthrough_codec_init(struct processing_module *mod)
 {
 	comp_info(mod->dev, "passthrough_codec_init() start");
+
+	/* data is copied as is, the input and output buffers can be the stream memory */
+	mod->contiguous_view = true;
 	return 0;
 }
 
 static int passthrough_codec_prepare(struct processing_module *mod)
 {
-	struct comp_dev *dev = mod->dev;
 	struct module_data *codec = &mod->priv;
 
-	comp_info(dev, "passthrough_codec_prepare()");
+	comp_info(mod->dev, "passthrough_codec_prepare()");
 
-	codec->mpd.in_buff = rballoc(0, SOF_MEM_CAPS_RAM, mod->period_bytes);
-	if (!codec->mpd.in_buff) {
-		comp_err(dev, "passthrough_codec_prepare(): Failed to alloc in_buff");
-		return -ENOMEM;
-	}
+	/* no codec buffers, a period goes straight from input to output buffer */
 	codec->mpd.in_buff_size = mod->period_bytes;
-
-	codec->mpd.out_buff = rballoc(0, SOF_MEM_CAPS_RAM, mod->period_bytes);
-	if (!codec->mpd.out_buff) {
-		comp_err(dev, "passthrough_codec_prepare(): Failed to alloc out_buff");
-		rfree(codec->mpd.in_buff);
-		return -ENOMEM;
-	}
 	codec->mpd.out_buff_size = mod->period_bytes;
 
 	return 0;
@@ -76,20 +67,14 @@ passthrough_codec_process(struct processing_module *mod,
 	if (!codec->mpd.init_done)
 		passthrough_codec_init_process(mod);
 
-	memcpy_s(codec->mpd.in_buff, codec->mpd.in_buff_size,
-		 input_buffers[0].data, codec->mpd.in_buff_size);
-
 	comp_dbg(dev, "passthrough_codec_process()");
 
-	memcpy_s(codec->mpd.out_buff, codec->mpd.out_buff_size,
-		 codec->mpd.in_buff, codec->mpd.in_buff_size);
+	/* with contiguous views this is the only copy, from source to sink buffer */
+	memcpy_s(output_buffers[0].data, codec->mpd.out_buff_size,
+		 input_buffers[0].data, codec->mpd.in_buff_size);
 	codec->mpd.produced = mod->period_bytes;
 	codec->mpd.consumed = mod->period_bytes;
 	input_buffers[0].consumed = codec->mpd.consumed;
-
-	/* copy the produced samples into the output buffer */
-	memcpy_s(output_buffers[0].data, codec->mpd.produced, codec->mpd.out_buff,
-		 codec->mpd.produced);
 	output_buffers[0].size = codec->mpd.produced;
 
 	return 0;
@@ -97,12 +82,8 @@ passthrough_codec_process(struct processing_module *mod,
 
 static int passthrough_codec_reset(struct processing_module *mod)
 {
-	struct module_data *codec = &mod->priv;
-
 	comp_info(mod->dev, "passthrough_codec_reset()");
 
-	rfree(codec->mpd.in_buff);
-	rfree(codec->mpd.out_buff);
 	return 0;
 }
 
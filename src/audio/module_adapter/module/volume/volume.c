@@ -68,163 +68,6 @@ DECLARE_TR_CTX(gain_tr, SOF_UUID(gain_uuid), LOG_LEVEL_INFO);
 
 DECLARE_TR_CTX(volume_tr, SOF_UUID(volume_uuid), LOG_LEVEL_INFO);
 
-#if CONFIG_FORMAT_S16LE
-/**
- * \brief Used to find nearest zero crossing frame for 16 bit format.
- * \param[in,out] source Source buffer.
- * \param[in] frames Number of frames.
- * \param[in,out] prev_sum Previous sum of channel samples.
- */
-static uint32_t vol_zc_get_s16(const struct audio_stream __sparse_cache *source,
-			       uint32_t frames, int64_t *prev_sum)
-{
-	uint32_t curr_frames = frames;
-	int32_t sum;
-	int16_t *x = source->r_ptr;
-	int bytes;
-	int nmax;
-	int i, j, n;
-	const int nch = source->channels;
-	int remaining_samples = frames * nch;
-
-	x = audio_stream_wrap(source, x + remaining_samples - 1); /* Go to last channel */
-	while (remaining_samples) {
-		bytes = audio_stream_rewind_bytes_without_wrap(source, x);
-		nmax = VOL_BYTES_TO_S16_SAMPLES(bytes) + 1;
-		n = MIN(nmax, remaining_samples);
-		for (i = 0; i < n; i += nch) {
-			sum = 0;
-			for (j = 0; j < nch; j++) {
-				sum += *x;
-				x--;
-			}
-
-			/* first sign change */
-			if ((sum ^ *prev_sum) < 0)
-				return curr_frames;
-
-			*prev_sum = sum;
-			curr_frames--;
-		}
-		remaining_samples -= n;
-		x = audio_stream_rewind_wrap(source, x);
-	}
-
-	/* sign change not detected, process all samples */
-	return frames;
-}
-
-#endif /* CONFIG_FORMAT_S16LE */
-
-#if CONFIG_FORMAT_S24LE
-/**
- * \brief Used to find nearest zero crossing frame for 24 in 32 bit format.
- * \param[in,out] source Source buffer.
- * \param[in] frames Number of frames.
- * \param[in,out] prev_sum Previous sum of channel samples.
- */
-static uint32_t vol_zc_get_s24(const struct audio_stream __sparse_cache *source,
-			       uint32_t frames, int64_t *prev_sum)
-{
-	int64_t sum;
-	uint32_t curr_frames = frames;
-	int32_t *x = source->r_ptr;
-	int bytes;
-	int nmax;
-	int i, j, n;
-	const int nch = source->channels;
-	int remaining_samples = frames * nch;
-
-	x = audio_stream_wrap(source, x + remaining_samples - 1); /* Go to last channel */
-	while (remaining_samples) {
-		bytes = audio_stream_rewind_bytes_without_wrap(source, x);
-		nmax = VOL_BYTES_TO_S32_SAMPLES(bytes) + 1;
-		n = MIN(nmax, remaining_samples);
-		for (i = 0; i < n; i += nch) {
-			sum = 0;
-			for (j = 0; j < nch; j++) {
-				sum += sign_extend_s24(*x);
-				x--;
-			}
-
-			/* first sign change */
-			if ((sum ^ *prev_sum) < 0)
-				return curr_frames;
-
-			*prev_sum = sum;
-			curr_frames--;
-		}
-		remaining_samples -= n;
-		x = audio_stream_rewind_wrap(source, x);
-	}
-
-	/* sign change not detected, process all samples */
-	return frames;
-}
-
-#endif /* CONFIG_FORMAT_S24LE */
-
-#if CONFIG_FORMAT_S32LE
-/**
- * \brief Used to find nearest zero crossing frame for 32 bit format.
- * \param[in,out] source Source buffer.
- * \param[in] frames Number of frames.
- * \param[in,out] prev_sum Previous sum of channel samples.
- */
-static uint32_t vol_zc_get_s32(const struct audio_stream __sparse_cache *source,
-			       uint32_t frames, int64_t *prev_sum)
-{
-	int64_t sum;
-	uint32_t curr_frames = frames;
-	int32_t *x = source->r_ptr;
-	int bytes;
-	int nmax;
-	int i, j, n;
-	const int nch = source->channels;
-	int remaining_samples = frames * nch;
-
-	x = audio_stream_wrap(source, x + remaining_samples - 1); /* Go to last channel */
-	while (remaining_samples) {
-		bytes = audio_stream_rewind_bytes_without_wrap(source, x);
-		nmax = VOL_BYTES_TO_S32_SAMPLES(bytes) + 1;
-		n = MIN(nmax, remaining_samples);
-		for (i = 0; i < n; i += nch) {
-			sum = 0;
-			for (j = 0; j < nch; j++) {
-				sum += *x;
-				x--;
-			}
-
-			/* first sign change */
-			if ((sum ^ *prev_sum) < 0)
-				return curr_frames;
-
-			*prev_sum = sum;
-			curr_frames--;
-		}
-		remaining_samples -= n;
-		x = audio_stream_rewind_wrap(source, x);
-	}
-
-	/* sign change not detected, process all samples */
-	return frames;
-}
-
-#endif /* CONFIG_FORMAT_S32LE */
-
-/** \brief Map of formats with dedicated zc functions. */
-static const struct comp_zc_func_map zc_func_map[] = {
-#if CONFIG_FORMAT_S16LE
-	{ SOF_IPC_FRAME_S16_LE, vol_zc_get_s16 },
-#endif /* CONFIG_FORMAT_S16LE */
-#if CONFIG_FORMAT_S24LE
-	{ SOF_IPC_FRAME_S24_4LE, vol_zc_get_s24 },
-#endif /* CONFIG_FORMAT_S24LE */
-#if CONFIG_FORMAT_S32LE
-	{ SOF_IPC_FRAME_S32_LE, vol_zc_get_s32 },
-#endif /* CONFIG_FORMAT_S32LE */
-};
-
 #if CONFIG_COMP_VOLUME_LINEAR_RAMP
 /**
  * \brief Calculate linear ramp function
@@ -325,6 +168,29 @@ static inline void volume_ramp(struct vol_data *cd)
 	}
 }
 
+/**
+ * \brief Sets up per frame gain interpolation for a block of ramp.
+ * \param[in,out] cd Volume component data
+ * \param[in] frames Number of frames in the block
+ *
+ * The gain of the block starts from the current volume and reaches the
+ * ramp gain at the end of the block, with constant increment per frame.
+ */
+static inline void volume_ramp_block(struct vol_data *cd, uint32_t frames)
+{
+	int i;
+
+	for (i = 0; i < cd->channels; i++)
+		cd->ramp_vol[i] = cd->volume[i] << VOL_RAMP_FRAC_BITS;
+
+	cd->vol_ramp_elapsed_frames += frames;
+	volume_ramp(cd);
+
+	for (i = 0; i < cd->channels; i++)
+		cd->ramp_delta[i] = ((cd->volume[i] << VOL_RAMP_FRAC_BITS) - cd->ramp_vol[i]) /
+				    (int32_t)frames;
+}
+
 /**
  * \brief Ramps volume changes over time.
  * \param[in,out] mod Volume processing module handle
@@ -641,6 +507,12 @@ static inline void prepare_ramp(struct comp_dev *dev, struct vol_data *cd)
 		cd->vol_ramp_frames = dev->frames;
 	else
 		cd->vol_ramp_frames = dev->frames / (dev->period / ramp_update_us);
+
+	/* The gain is interpolated per frame between the ramp updates. A linear
+	 * ramp is then exact with any update rate, so update it once per copy().
+	 */
+	if (cd->ramp_type == SOF_VOLUME_LINEAR || cd->ramp_type == SOF_VOLUME_LINEAR_ZC)
+		cd->vol_ramp_frames = dev->frames;
 }
 
 /**
@@ -1143,56 +1015,33 @@ static int volume_process(struct processing_module *mod,
 	struct vol_data *cd = module_get_private_data(mod);
 	uint32_t avail_frames = input_buffers[0].size;
 	uint32_t frames;
-	int64_t prev_sum = 0;
 
 	comp_dbg(mod->dev, "volume_process()");
 
 	while (avail_frames) {
 		volume_update_current_vol_ipc4(cd);
 
-		if (cd->ramp_finished || cd->vol_ramp_frames > avail_frames) {
-			/* without ramping process all at once */
+		if (cd->ramp_finished) {
+			/* without ramping process all at once with constant gain */
 			frames = avail_frames;
-		} else if (cd->ramp_type == SOF_VOLUME_LINEAR_ZC) {
-			/* with ZC ramping look for next ZC offset */
-			frames = cd->zc_get(input_buffers[0].data, cd->vol_ramp_frames, &prev_sum);
+			cd->scale_vol(mod, &input_buffers[0], &output_buffers[0], frames,
+				      cd->attenuation);
 		} else {
-			/* without ZC process max ramp chunk */
-			frames = cd->vol_ramp_frames;
-		}
-
-		if (!cd->ramp_finished) {
-			volume_ramp(cd);
-			cd->vol_ramp_elapsed_frames += frames;
+			/* process max ramp chunk with the gain interpolated per
+			 * frame, no need to look for zero crossings
+			 */
+			frames = MIN(cd->vol_ramp_frames, avail_frames);
+			volume_ramp_block(cd, frames);
+			cd->scale_vol_ramp(mod, &input_buffers[0], &output_buffers[0], frames,
+					   cd->attenuation);
 		}
 
-		/* copy and scale volume */
-		cd->scale_vol(mod, &input_buffers[0], &output_buffers[0], frames, cd->attenuation);
-
 		avail_frames -= frames;
 	}
 
 	return 0;
 }
 
-/*
- * \brief Retrieves volume zero crossing function.
- * \param[in,out] dev Volume base component device.
- */
-static vol_zc_func vol_get_zc_function(struct comp_dev *dev,
-				       struct comp_buffer __sparse_cache *sinkb)
-{
-	int i;
-
-	/* map the zc function to frame format */
-	for (i = 0; i < ARRAY_SIZE(zc_func_map); i++) {
-		if (sinkb->stream.valid_sample_fmt == zc_func_map[i].frame_fmt)
-			return zc_func_map[i].func;
-	}
-
-	return NULL;
-}
-
 /**
  * \brief Set volume frames alignment limit.
  * \param[in,out] source Structure pointer of source.
@@ -1286,9 +1135,9 @@ static int volume_prepare(struct processing_module *mod)
 		goto err;
 	}
 
-	cd->zc_get = vol_get_zc_function(dev, sink_c);
-	if (!cd->zc_get) {
-		comp_err(dev, "volume_prepare(): invalid cd->zc_get");
+	cd->scale_vol_ramp = vol_get_ramp_function(dev, sink_c);
+	if (!cd->scale_vol_ramp) {
+		comp_err(dev, "volume_prepare(): invalid cd->scale_vol_ramp");
 		ret = -EINVAL;
 		goto err;
 	}
@@ -214,5 +214,240 @@ const struct comp_func_map volume_func_map[] = {
 
 const size_t volume_func_count = ARRAY_SIZE(volume_func_map);
 
+#endif /* !CONFIG_COMP_PEAK_VOL */
+
+/* The gain ramp functions are used with and without peak volume detection.
+ * VOL_RAMP_Y is the fractional bits count of the ramp gain.
+ */
+#define VOL_RAMP_Y	(VOL_QXY_Y + VOL_RAMP_FRAC_BITS)
+
+#if CONFIG_FORMAT_S24LE
+/**
+ * \brief Volume processing with gain ramp from 24/32 bit to 24/32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment
+ *
+ * The gain of each channel starts from ramp_vol and is incremented by
+ * ramp_delta every frame.
+ */
+static void vol_ramp_s24_to_s24(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t vol;
+	int32_t delta;
+	int32_t *x, *x0;
+	int32_t *y, *y0;
+	int nmax, n, i, j;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int32_t tmp;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * cd->channels);
+#endif
+	x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s24(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s24(sink, y);
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			vol = cd->ramp_vol[j];
+			delta = cd->ramp_delta[j];
+#if CONFIG_COMP_PEAK_VOL
+			tmp = 0;
+#endif
+			for (i = 0; i < n; i += nch) {
+				y0[i] = q_multsr_sat_32x32_24(sign_extend_s24(x0[i]), vol,
+							      Q_SHIFT_BITS_64(23, VOL_RAMP_Y, 23));
+				vol += delta;
+#if CONFIG_COMP_PEAK_VOL
+				tmp = MAX(abs(x0[i]), tmp);
+#endif
+			}
+			cd->ramp_vol[j] = vol;
+#if CONFIG_COMP_PEAK_VOL
+			tmp = tmp << attenuation;
+			cd->peak_regs.peak_meter[j] = MAX(tmp, cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+/**
+ * \brief Volume processing with gain ramp from 32 bit to 32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment
+ *
+ * The gain of each channel starts from ramp_vol and is incremented by
+ * ramp_delta every frame.
+ */
+static void vol_ramp_s32_to_s32(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t vol;
+	int32_t delta;
+	int32_t *x, *x0;
+	int32_t *y, *y0;
+	int nmax, n, i, j;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int32_t tmp;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * cd->channels);
+#endif
+	x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s32(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s32(sink, y);
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			vol = cd->ramp_vol[j];
+			delta = cd->ramp_delta[j];
+#if CONFIG_COMP_PEAK_VOL
+			tmp = 0;
+#endif
+			for (i = 0; i < n; i += nch) {
+				y0[i] = q_multsr_sat_32x32(x0[i], vol,
+							   Q_SHIFT_BITS_64(31, VOL_RAMP_Y, 31));
+				vol += delta;
+#if CONFIG_COMP_PEAK_VOL
+				tmp = MAX(abs(x0[i]), tmp);
+#endif
+			}
+			cd->ramp_vol[j] = vol;
+#if CONFIG_COMP_PEAK_VOL
+			tmp = tmp << attenuation;
+			cd->peak_regs.peak_meter[j] = MAX(tmp, cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_S16LE
+/**
+ * \brief Volume processing with gain ramp from 16 bit to 16 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment (unused for 16bit)
+ *
+ * The gain of each channel starts from ramp_vol and is incremented by
+ * ramp_delta every frame.
+ */
+static void vol_ramp_s16_to_s16(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	int32_t vol;
+	int32_t delta;
+	int16_t *x, *x0;
+	int16_t *y, *y0;
+	int nmax, n, i, j;
+	const int nch = source->channels;
+	int remaining_samples = frames * nch;
+#if CONFIG_COMP_PEAK_VOL
+	int32_t tmp;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * cd->channels);
 #endif
+	x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	bsource->consumed += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	bsink->size += VOL_S16_SAMPLES_TO_BYTES(remaining_samples);
+	while (remaining_samples) {
+		nmax = audio_stream_samples_without_wrap_s16(source, x);
+		n = MIN(remaining_samples, nmax);
+		nmax = audio_stream_samples_without_wrap_s16(sink, y);
+		n = MIN(n, nmax);
+		for (j = 0; j < nch; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			vol = cd->ramp_vol[j];
+			delta = cd->ramp_delta[j];
+#if CONFIG_COMP_PEAK_VOL
+			tmp = 0;
+#endif
+			for (i = 0; i < n; i += nch) {
+				y0[i] = q_multsr_sat_32x32_16(x0[i], vol,
+							      Q_SHIFT_BITS_32(15, VOL_RAMP_Y, 15));
+				vol += delta;
+#if CONFIG_COMP_PEAK_VOL
+				tmp = MAX(abs(x0[i]), tmp);
+#endif
+			}
+			cd->ramp_vol[j] = vol;
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = MAX(tmp, cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		remaining_samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+const struct comp_func_map volume_ramp_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, vol_ramp_s16_to_s16 },
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, vol_ramp_s24_to_s24 },
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, vol_ramp_s32_to_s32 },
+#endif /* CONFIG_FORMAT_S32LE */
+};
+
+const size_t volume_ramp_func_count = ARRAY_SIZE(volume_ramp_func_map);
+
 #endif
@@ -336,3 +336,275 @@ const struct comp_func_map volume_func_map[] = {
 const size_t volume_func_count = ARRAY_SIZE(volume_func_map);
 
 #endif
+
+#if defined(__XCC__) && XCHAL_HAVE_HIFI3
+
+#include <xtensa/tie/xt_hifi3.h>
+
+/* The gain ramp functions are used with and without peak volume detection.
+ * VOL_RAMP_Y is the fractional bits count of the ramp gain.
+ */
+#define VOL_RAMP_Y	(VOL_QXY_Y + VOL_RAMP_FRAC_BITS)
+
+/**
+ * \brief Multiply samples with the ramp gain.
+ * \param[in] volume Ramp gain with VOL_RAMP_Y fractional bits.
+ * \param[in] in_sample Input sample in low part as Q1.31.
+ * \return Rounded and saturated output sample as Q1.31.
+ */
+static inline ae_f32x2 vol_ramp_mult(ae_f32x2 volume, ae_f32x2 in_sample)
+{
+	ae_f64 mult;
+
+	/* Gain x Q1.31 << 1 has VOL_RAMP_Y + 32 fractional bits, shift to 47 */
+	mult = AE_MULF32S_LL(volume, in_sample);
+	mult = AE_SRAI64(mult, VOL_RAMP_Y - 15);
+	return AE_ROUND32X2F48SSYM(mult, mult);
+}
+
+#if CONFIG_FORMAT_S24LE
+/**
+ * \brief HiFi3 enabled volume processing with gain ramp from 24/32 bit to 24/32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment
+ */
+static void vol_ramp_s24_to_s24_s32(struct processing_module *mod,
+				    struct input_stream_buffer *bsource,
+				    struct output_stream_buffer *bsink, uint32_t frames,
+				    uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	ae_f32x2 in_sample = AE_ZERO32();
+	ae_f32x2 out_sample = AE_ZERO32();
+	ae_f32x2 volume;
+	ae_f32x2 delta;
+	int32_t *x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	int32_t *y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	ae_int32 *in;
+	ae_int32 *out;
+	const int channels_count = sink->channels;
+	const int inc = channels_count * sizeof(int32_t);
+	int samples = channels_count * frames;
+	int i, j, n, m;
+#if CONFIG_COMP_PEAK_VOL
+	ae_f32x2 peak;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * channels_count);
+#endif
+
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(samples);
+
+	while (samples) {
+		m = audio_stream_samples_without_wrap_s24(source, x);
+		n = MIN(m, samples);
+		m = audio_stream_samples_without_wrap_s24(sink, y);
+		n = MIN(m, n);
+		for (j = 0; j < channels_count; j++) {
+			in = (ae_int32 *)(x + j);
+			out = (ae_int32 *)(y + j);
+			volume = AE_MOVDA32(cd->ramp_vol[j]);
+			delta = AE_MOVDA32(cd->ramp_delta[j]);
+#if CONFIG_COMP_PEAK_VOL
+			peak = AE_ZERO32();
+#endif
+			for (i = 0; i < n; i += channels_count) {
+				AE_L32_XP(in_sample, in, inc);
+#if CONFIG_COMP_PEAK_VOL
+				peak = AE_MAXABS32S(in_sample, peak);
+#endif
+				out_sample = vol_ramp_mult(volume, AE_SLAI32(in_sample, 8));
+
+				/* Q1.31 to S24_LE */
+				out_sample = AE_SRAI32(out_sample, 8);
+				AE_S32_L_XP(out_sample, out, inc);
+				volume = AE_ADD32(volume, delta);
+			}
+			cd->ramp_vol[j] = AE_MOVAD32_L(volume);
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = MAX(AE_MOVAD32_L(peak) << attenuation,
+							  cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+/**
+ * \brief HiFi3 enabled volume processing with gain ramp from 32 bit to 24/32 or 32 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment
+ */
+static void vol_ramp_s32_to_s24_s32(struct processing_module *mod,
+				    struct input_stream_buffer *bsource,
+				    struct output_stream_buffer *bsink, uint32_t frames,
+				    uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	ae_f32x2 in_sample = AE_ZERO32();
+	ae_f32x2 out_sample = AE_ZERO32();
+	ae_f32x2 volume;
+	ae_f32x2 delta;
+	int32_t *x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	int32_t *y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	ae_int32 *in;
+	ae_int32 *out;
+	const int channels_count = sink->channels;
+	const int inc = channels_count * sizeof(int32_t);
+	int samples = channels_count * frames;
+	int i, j, n, m;
+#if CONFIG_COMP_PEAK_VOL
+	ae_f32x2 peak;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * channels_count);
+#endif
+
+	bsource->consumed += VOL_S32_SAMPLES_TO_BYTES(samples);
+	bsink->size += VOL_S32_SAMPLES_TO_BYTES(samples);
+
+	while (samples) {
+		m = audio_stream_samples_without_wrap_s32(source, x);
+		n = MIN(m, samples);
+		m = audio_stream_samples_without_wrap_s32(sink, y);
+		n = MIN(m, n);
+		for (j = 0; j < channels_count; j++) {
+			in = (ae_int32 *)(x + j);
+			out = (ae_int32 *)(y + j);
+			volume = AE_MOVDA32(cd->ramp_vol[j]);
+			delta = AE_MOVDA32(cd->ramp_delta[j]);
+#if CONFIG_COMP_PEAK_VOL
+			peak = AE_ZERO32();
+#endif
+			for (i = 0; i < n; i += channels_count) {
+				AE_L32_XP(in_sample, in, inc);
+#if CONFIG_COMP_PEAK_VOL
+				peak = AE_MAXABS32S(in_sample, peak);
+#endif
+				out_sample = vol_ramp_mult(volume, in_sample);
+				AE_S32_L_XP(out_sample, out, inc);
+				volume = AE_ADD32(volume, delta);
+			}
+			cd->ramp_vol[j] = AE_MOVAD32_L(volume);
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = MAX(AE_MOVAD32_L(peak) << attenuation,
+							  cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S32LE */
+
+#if CONFIG_FORMAT_S16LE
+/**
+ * \brief HiFi3 enabled volume processing with gain ramp from 16 bit to 16 bit.
+ * \param[in,out] mod Volume processing module handle.
+ * \param[in,out] bsource Input buffer.
+ * \param[in,out] bsink Destination buffer.
+ * \param[in] frames Number of frames to process.
+ * \param[in] attenuation factor for peakmeter adjustment (unused for 16bit)
+ */
+static void vol_ramp_s16_to_s16(struct processing_module *mod, struct input_stream_buffer *bsource,
+				struct output_stream_buffer *bsink, uint32_t frames,
+				uint32_t attenuation)
+{
+	struct vol_data *cd = module_get_private_data(mod);
+	struct audio_stream __sparse_cache *source = bsource->data;
+	struct audio_stream __sparse_cache *sink = bsink->data;
+	ae_f32x2 in_sample = AE_ZERO32();
+	ae_f32x2 out_sample = AE_ZERO32();
+	ae_f32x2 volume;
+	ae_f32x2 delta;
+	int16_t *x = audio_stream_wrap(source, (char *)source->r_ptr + bsource->consumed);
+	int16_t *y = audio_stream_wrap(sink, (char *)sink->w_ptr + bsink->size);
+	int16_t *x0;
+	int16_t *y0;
+	const int channels_count = sink->channels;
+	int samples = channels_count * frames;
+	int i, j, n, m;
+#if CONFIG_COMP_PEAK_VOL
+	ae_f32x2 peak;
+
+	memset(cd->peak_regs.peak_meter, 0, sizeof(uint32_t) * channels_count);
+#endif
+
+	bsource->consumed += VOL_S16_SAMPLES_TO_BYTES(samples);
+	bsink->size += VOL_S16_SAMPLES_TO_BYTES(samples);
+
+	while (samples) {
+		m = audio_stream_samples_without_wrap_s16(source, x);
+		n = MIN(m, samples);
+		m = audio_stream_samples_without_wrap_s16(sink, y);
+		n = MIN(m, n);
+		for (j = 0; j < channels_count; j++) {
+			x0 = x + j;
+			y0 = y + j;
+			volume = AE_MOVDA32(cd->ramp_vol[j]);
+			delta = AE_MOVDA32(cd->ramp_delta[j]);
+#if CONFIG_COMP_PEAK_VOL
+			peak = AE_ZERO32();
+#endif
+			for (i = 0; i < n; i += channels_count) {
+				in_sample = AE_MOVDA32(x0[i]);
+#if CONFIG_COMP_PEAK_VOL
+				peak = AE_MAXABS32S(in_sample, peak);
+#endif
+				out_sample = vol_ramp_mult(volume, AE_SLAI32(in_sample, 16));
+
+				/* Q1.31 to Q1.15 */
+				y0[i] = AE_MOVAD16_0(AE_ROUND16X4F32SSYM(out_sample, out_sample));
+				volume = AE_ADD32(volume, delta);
+			}
+			cd->ramp_vol[j] = AE_MOVAD32_L(volume);
+#if CONFIG_COMP_PEAK_VOL
+			cd->peak_regs.peak_meter[j] = MAX(AE_MOVAD32_L(peak),
+							  cd->peak_regs.peak_meter[j]);
+#endif
+		}
+		samples -= n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+#if CONFIG_COMP_PEAK_VOL
+	peak_vol_update(cd);
+#endif
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+const struct comp_func_map volume_ramp_func_map[] = {
+#if CONFIG_FORMAT_S16LE
+	{ SOF_IPC_FRAME_S16_LE, vol_ramp_s16_to_s16 },
+#endif
+#if CONFIG_FORMAT_S24LE
+	{ SOF_IPC_FRAME_S24_4LE, vol_ramp_s24_to_s24_s32 },
+#endif
+#if CONFIG_FORMAT_S32LE
+	{ SOF_IPC_FRAME_S32_LE, vol_ramp_s32_to_s24_s32 },
+#endif
+};
+
+const size_t volume_ramp_func_count = ARRAY_SIZE(volume_ramp_func_map);
+
+#endif
@@ -240,6 +240,12 @@ int module_adapter_prepare(struct comp_dev *dev)
 		return -EINVAL;
 	}
 
+	if (mod->contiguous_view && (mod->num_input_buffers > PLATFORM_MAX_STREAMS ||
+				     mod->num_output_buffers > PLATFORM_MAX_STREAMS)) {
+		comp_warn(dev, "module_adapter_prepare(): too many buffers for contiguous_view");
+		mod->contiguous_view = false;
+	}
+
 	/* allocate memory for input buffers */
 	if (mod->num_input_buffers) {
 		mod->input_buffers =
@@ -563,7 +569,56 @@ static void module_copy_samples(struct comp_dev *dev, struct comp_buffer __spars
 	comp_update_buffer_consume(src_buffer, copy_bytes);
 }
 
-static void module_adapter_process_output(struct comp_dev *dev)
+/*
+ * Point the module output buffers straight at the write position of the local sink
+ * buffers when the whole module output fits there without a wrap. The module data
+ * pointers are saved to scratch[] and a mask of the buffers using a view is returned.
+ */
+static uint32_t module_adapter_output_views(struct processing_module *mod,
+					    void __sparse_cache **scratch)
+{
+	uint32_t out_buff_size = mod->priv.mpd.out_buff_size;
+	struct list_item *blist;
+	uint32_t views = 0;
+	int i = 0;
+
+	list_for_item(blist, &mod->sink_buffer_list) {
+		struct comp_buffer *buffer = container_of(blist, struct comp_buffer, sink_list);
+		struct comp_buffer __sparse_cache *buffer_c = buffer_acquire(buffer);
+		struct audio_stream __sparse_cache *stream = &buffer_c->stream;
+
+		if (audio_stream_get_free_bytes(stream) >= out_buff_size &&
+		    audio_stream_bytes_without_wrap(stream, stream->w_ptr) >= out_buff_size) {
+			scratch[i] = mod->output_buffers[i].data;
+			mod->output_buffers[i].data =
+				(__sparse_force void __sparse_cache *)stream->w_ptr;
+			views |= BIT(i);
+		}
+
+		buffer_release(buffer_c);
+		i++;
+	}
+
+	return views;
+}
+
+/* restore the module data pointers replaced by contiguous views */
+static void module_adapter_restore_views(struct processing_module *mod,
+					 void __sparse_cache **in_scratch, uint32_t in_views,
+					 void __sparse_cache **out_scratch, uint32_t out_views)
+{
+	int i;
+
+	for (i = 0; i < mod->num_input_buffers; i++)
+		if (in_views & BIT(i))
+			mod->input_buffers[i].data = in_scratch[i];
+
+	for (i = 0; i < mod->num_output_buffers; i++)
+		if (out_views & BIT(i))
+			mod->output_buffers[i].data = out_scratch[i];
+}
+
+static void module_adapter_process_output(struct comp_dev *dev, uint32_t out_views)
 {
 	struct processing_module *mod = comp_get_drvdata(dev);
 	struct comp_buffer *sink;
@@ -583,8 +638,11 @@ static void module_adapter_process_output(struct comp_dev *dev)
 			buffer = container_of(blist, struct comp_buffer, sink_list);
 			buffer_c = buffer_acquire(buffer);
 
-			ca_copy_from_module_to_sink(&buffer_c->stream, mod->output_buffers[i].data,
-						    mod->output_buffers[i].size);
+			/* module wrote straight into the buffer when using a view */
+			if (!(out_views & BIT(i)))
+				ca_copy_from_module_to_sink(&buffer_c->stream,
+							    mod->output_buffers[i].data,
+							    mod->output_buffers[i].size);
 			audio_stream_produce(&buffer_c->stream, mod->output_buffers[i].size);
 			buffer_release(buffer_c);
 		}
@@ -813,8 +871,12 @@ int module_adapter_copy(struct comp_dev *dev)
 	struct comp_buffer *source, *sink;
 	struct comp_buffer __sparse_cache *sink_c = NULL;
 	struct list_item *blist;
+	void __sparse_cache *in_scratch[PLATFORM_MAX_STREAMS];
+	void __sparse_cache *out_scratch[PLATFORM_MAX_STREAMS];
 	size_t size = MAX(mod->deep_buff_bytes, mod->period_bytes);
 	uint32_t min_free_frames = UINT_MAX;
+	uint32_t in_views = 0;
+	uint32_t out_views = 0;
 	int ret, i = 0;
 
 	comp_dbg(dev, "module_adapter_copy(): start");
@@ -856,15 +918,29 @@ int module_adapter_copy(struct comp_dev *dev)
 		mod->input_buffers[i].size = bytes_to_process;
 		mod->input_buffers[i].consumed = 0;
 
-		ca_copy_from_source_to_module(&src_c->stream, mod->input_buffers[i].data,
-					      md->mpd.in_buff_size, bytes_to_process);
+		/* read straight from the source buffer when the data does not wrap */
+		if (mod->contiguous_view &&
+		    audio_stream_bytes_without_wrap(&src_c->stream, src_c->stream.r_ptr) >=
+		    bytes_to_process) {
+			in_scratch[i] = mod->input_buffers[i].data;
+			mod->input_buffers[i].data =
+				(__sparse_force void __sparse_cache *)src_c->stream.r_ptr;
+			in_views |= BIT(i);
+		} else {
+			ca_copy_from_source_to_module(&src_c->stream, mod->input_buffers[i].data,
+						      md->mpd.in_buff_size, bytes_to_process);
+		}
 		buffer_release(src_c);
 
 		i++;
 	}
 
+	if (mod->contiguous_view)
+		out_views = module_adapter_output_views(mod, out_scratch);
+
 	ret = module_process(mod, mod->input_buffers, mod->num_input_buffers,
 			     mod->output_buffers, mod->num_output_buffers);
+	module_adapter_restore_views(mod, in_scratch, in_views, out_scratch, out_views);
 	if (ret) {
 		if (ret != -ENOSPC && ret != -ENODATA) {
 			comp_err(dev, "module_adapter_copy() error %x: module processing failed",
@@ -886,12 +962,13 @@ int module_adapter_copy(struct comp_dev *dev)
 		comp_update_buffer_consume(src_c, mod->input_buffers[i].consumed);
 		buffer_release(src_c);
 
-		bzero((__sparse_force void *)mod->input_buffers[i].data, size);
+		if (!mod->contiguous_view)
+			bzero((__sparse_force void *)mod->input_buffers[i].data, size);
 		mod->input_buffers[i].size = 0;
 		mod->input_buffers[i].consumed = 0;
 		i++;
 	}
-	module_adapter_process_output(dev);
+	module_adapter_process_output(dev, out_views);
 
 	return 0;
 
@@ -900,7 +977,8 @@ out:
 		mod->output_buffers[i].size = 0;
 
 	for (i = 0; i < mod->num_input_buffers; i++) {
-		bzero((__sparse_force void *)mod->input_buffers[i].data, size);
+		if (!mod->contiguous_view)
+			bzero((__sparse_force void *)mod->input_buffers[i].data, size);
 		mod->input_buffers[i].size = 0;
 		mod->input_buffers[i].consumed = 0;
 	}
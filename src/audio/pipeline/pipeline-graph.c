@@ -175,6 +175,13 @@ static void buffer_set_comp(struct comp_buffer *buffer, struct comp_dev *comp,
 	else
 		buffer_c->sink = comp;
 
+	/*
+	 * Both ends on the same core and the buffer not shared, produce and
+	 * consume can take the fast path, see comp_update_buffer_produce().
+	 */
+	buffer_c->spsc = buffer_c->source && buffer_c->sink && !buffer->c.shared &&
+		buffer_c->source->ipc_config.core == buffer_c->sink->ipc_config.core;
+
 	buffer_release(buffer_c);
 
 	/* The buffer might be marked as shared later, write back the cache */
@@ -182,6 +189,24 @@ static void buffer_set_comp(struct comp_buffer *buffer, struct comp_dev *comp,
 		dcache_writeback_invalidate_region(uncache_to_cache(buffer), sizeof(*buffer));
 }
 
+/* graph of a prepared pipeline changed, update its copy schedule */
+static void pipeline_graph_changed(struct comp_dev *comp)
+{
+	struct pipeline *p = comp->pipeline;
+
+	if (!p || !p->copy_sched)
+		return;
+
+	/*
+	 * Components of a stopped pipeline may be already freed, the schedule
+	 * is built again on prepare. Copy walks the graph if the build fails.
+	 */
+	if (p->status == COMP_STATE_ACTIVE || p->status == COMP_STATE_PAUSED)
+		pipeline_copy_sched_build(p);
+	else
+		pipeline_copy_sched_free(p);
+}
+
 int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 		     int dir)
 {
@@ -201,6 +226,8 @@ int pipeline_connect(struct comp_dev *comp, struct comp_buffer *buffer,
 
 	irq_local_enable(flags);
 
+	pipeline_graph_changed(comp);
+
 	return 0;
 }
 
@@ -221,6 +248,8 @@ void pipeline_disconnect(struct comp_dev *comp, struct comp_buffer *buffer, int
 	buffer_set_comp(buffer, NULL, dir);
 
 	irq_local_enable(flags);
+
+	pipeline_graph_changed(comp);
 }
 
 /* pipelines must be inactive */
@@ -241,6 +270,8 @@ int pipeline_free(struct pipeline *p)
 
 	ipc_msg_free(p->msg);
 
+	pipeline_copy_sched_free(p);
+
 	pipeline_posn_offset_put(p->posn_offset);
 
 	/* now free the pipeline */
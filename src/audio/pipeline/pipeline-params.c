@@ -321,6 +321,10 @@ static int pipeline_comp_prepare(struct comp_dev *current,
 	if (err < 0)
 		return err;
 
+	/* stream direction is known now, copy walks the graph if this fails */
+	if (current == current->pipeline->source_comp)
+		pipeline_copy_sched_build(current->pipeline);
+
 	err = comp_prepare(current);
 	if (err < 0 || err == PPL_STATUS_PATH_STOP)
 		return err;
@@ -9,6 +9,8 @@
 #include <sof/audio/component_ext.h>
 #include <sof/audio/pipeline.h>
 #include <sof/lib/dai.h>
+#include <rtos/alloc.h>
+#include <rtos/interrupt.h>
 #include <rtos/wait.h>
 #include <sof/list.h>
 #include <rtos/spinlock.h>
@@ -109,6 +111,77 @@ static int pipeline_comp_copy(struct comp_dev *current,
 	return err;
 }
 
+/* walk direction and start of pipeline copy */
+static struct comp_dev *pipeline_copy_start(struct pipeline *p, int *dir)
+{
+	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
+		*dir = PPL_DIR_UPSTREAM;
+		return p->sink_comp;
+	}
+
+	*dir = PPL_DIR_DOWNSTREAM;
+	return p->source_comp;
+}
+
+/* components are copied before the ones walked from them */
+static int pipeline_copy_sched_downstream(struct pipeline_copy_sched *sched)
+{
+	struct pipeline_copy_entry *entry;
+	int err;
+	int i = 0;
+
+	while (i < sched->count) {
+		entry = &sched->entries[i];
+
+		/* skip inactive component and everything behind it */
+		if (!comp_is_active(entry->comp)) {
+			i = entry->walk_end;
+			continue;
+		}
+
+		err = comp_copy(entry->comp);
+		if (err < 0 || err == PPL_STATUS_PATH_STOP)
+			return err;
+
+		i++;
+	}
+
+	return 0;
+}
+
+/* components are copied after the ones walked from them */
+static int pipeline_copy_sched_upstream(struct pipeline_copy_sched *sched)
+{
+	struct pipeline_copy_entry *entry;
+	int top = 0;
+	int err;
+	int i = 0;
+
+	for (;;) {
+		/* copy pending components once their walk is done */
+		while (top && (i == sched->count ||
+			       sched->entries[sched->pending[top - 1]].walk_end <= i)) {
+			entry = &sched->entries[sched->pending[--top]];
+			err = comp_copy(entry->comp);
+			if (err < 0 || err == PPL_STATUS_PATH_STOP)
+				return err;
+		}
+
+		if (i == sched->count)
+			return 0;
+
+		entry = &sched->entries[i];
+
+		/* skip inactive component and everything behind it */
+		if (!comp_is_active(entry->comp)) {
+			i = entry->walk_end;
+			continue;
+		}
+
+		sched->pending[top++] = i++;
+	}
+}
+
 /* Copy data across all pipeline components.
  * For capture pipelines it always starts from source component
  * and continues downstream and for playback pipelines it first
@@ -116,6 +189,7 @@ static int pipeline_comp_copy(struct comp_dev *current,
  */
 int pipeline_copy(struct pipeline *p)
 {
+	struct pipeline_copy_sched *sched = p->copy_sched;
 	struct pipeline_data data;
 	struct pipeline_walk_context walk_ctx = {
 		.comp_func = pipeline_comp_copy,
@@ -123,28 +197,148 @@ int pipeline_copy(struct pipeline *p)
 		.skip_incomplete = true,
 	};
 	struct comp_dev *start;
-	uint32_t dir;
+	int dir;
 	int ret;
 
-	if (p->source_comp->direction == SOF_IPC_STREAM_PLAYBACK) {
-		dir = PPL_DIR_UPSTREAM;
-		start = p->sink_comp;
+	start = pipeline_copy_start(p, &dir);
+
+	if (sched && sched->start == start && sched->dir == dir) {
+		/* same walk as below, without revisiting the graph */
+		if (dir == PPL_DIR_UPSTREAM)
+			ret = pipeline_copy_sched_upstream(sched);
+		else
+			ret = pipeline_copy_sched_downstream(sched);
 	} else {
-		dir = PPL_DIR_DOWNSTREAM;
-		start = p->source_comp;
+		data.start = start;
+		data.p = p;
+
+		ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
 	}
 
+	if (ret < 0)
+		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
+			 ret, dev_comp_id(start), dir);
+
+	return ret;
+}
+
+struct pipeline_sched_data {
+	struct comp_dev *start;
+	struct pipeline_copy_entry *entries;	/* NULL when only counting */
+	int count;
+};
+
+/* record components in the order pipeline_comp_copy() walks them */
+static int pipeline_comp_sched(struct comp_dev *current,
+			       struct comp_buffer *calling_buf,
+			       struct pipeline_walk_context *ctx, int dir)
+{
+	struct pipeline_sched_data *sched_data = ctx->comp_data;
+	int index = sched_data->count;
+	int err;
+
+	if (!comp_is_single_pipeline(current, sched_data->start))
+		return 0;
+
+	if (index == PPL_COPY_SCHED_MAX)
+		return -E2BIG;
+
+	sched_data->count++;
+
+	err = pipeline_for_each_comp(current, ctx, dir);
+	if (err < 0)
+		return err;
+
+	if (sched_data->entries) {
+		sched_data->entries[index].comp = current;
+		sched_data->entries[index].walk_end = sched_data->count;
+	}
+
+	return 0;
+}
+
+int pipeline_copy_sched_build(struct pipeline *p)
+{
+	struct pipeline_sched_data data;
+	struct pipeline_walk_context walk_ctx = {
+		.comp_func = pipeline_comp_sched,
+		.comp_data = &data,
+		.skip_incomplete = true,
+	};
+	struct pipeline_copy_sched *sched;
+	struct pipeline_copy_sched *old;
+	struct comp_dev *start;
+	uint32_t flags;
+	size_t size;
+	int dir;
+	int ret;
+
+	if (!p->source_comp || !p->sink_comp)
+		return 0;
+
+	start = pipeline_copy_start(p, &dir);
+
+	/* count the components first */
 	data.start = start;
-	data.p = p;
+	data.entries = NULL;
+	data.count = 0;
 
 	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
 	if (ret < 0)
-		pipe_err(p, "pipeline_copy(): ret = %d, start->comp.id = %u, dir = %u",
-			 ret, dev_comp_id(start), dir);
+		goto err;
+
+	size = sizeof(*sched) + data.count * (sizeof(sched->entries[0]) + sizeof(uint16_t));
+	sched = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!sched) {
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	sched->start = start;
+	sched->dir = dir;
+	sched->count = data.count;
+	sched->pending = (uint16_t *)&sched->entries[data.count];
+
+	data.entries = sched->entries;
+	data.count = 0;
+
+	ret = walk_ctx.comp_func(start, NULL, &walk_ctx, dir);
+	if (ret < 0) {
+		rfree(sched);
+		goto err;
+	}
+
+	pipe_dbg(p, "pipeline_copy_sched_build(), %u components", sched->count);
+
+	/* copy runs in the pipeline task, swap the schedule atomically */
+	irq_local_disable(flags);
+	old = p->copy_sched;
+	p->copy_sched = sched;
+	irq_local_enable(flags);
+
+	rfree(old);
+
+	return 0;
 
+err:
+	pipe_err(p, "pipeline_copy_sched_build(): ret = %d, copy walks the graph", ret);
+	pipeline_copy_sched_free(p);
 	return ret;
 }
 
+void pipeline_copy_sched_free(struct pipeline *p)
+{
+	struct pipeline_copy_sched *old;
+	uint32_t flags;
+
+	irq_local_disable(flags);
+	old = p->copy_sched;
+	p->copy_sched = NULL;
+	irq_local_enable(flags);
+
+	rfree(old);
+}
+
 /* only collect scheduling components */
 static int pipeline_comp_list(struct comp_dev *current,
 			      struct comp_buffer *calling_buf,
@@ -11,6 +11,7 @@
 #include <sof/audio/component.h>
 #include <sof/audio/pipeline.h>
 #include <sof/audio/audio_stream.h>
+#include <sof/audio/data_blob.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/src/src.h>
@@ -31,12 +32,17 @@
 #include <ipc/stream.h>
 #include <ipc/topology.h>
 #include <ipc4/base-config.h>
+#include <user/src.h>
 #include <user/trace.h>
 #include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
 
-#if SRC_SHORT || CONFIG_COMP_SRC_TINY
+#if CONFIG_COMP_SRC_BLOB
+/* No built-in conversions, the coefficients are loaded from a blob */
+#define MAX_FIR_DELAY_SIZE SOF_SRC_MAX_FIR_DELAY
+#define MAX_OUT_DELAY_SIZE SOF_SRC_MAX_OUT_DELAY
+#elif SRC_SHORT || CONFIG_COMP_SRC_TINY
 #include <sof/audio/coefficients/src/src_tiny_int16_define.h>
 #include <sof/audio/coefficients/src/src_tiny_int16_table.h>
 #elif CONFIG_COMP_SRC_SMALL
@@ -52,9 +58,13 @@
 #error "No valid configuration selected for SRC"
 #endif
 
-/* The FIR maximum lengths are per channel so need to multiply them */
-#define MAX_FIR_DELAY_SIZE_XNCH (PLATFORM_MAX_CHANNELS * MAX_FIR_DELAY_SIZE)
-#define MAX_OUT_DELAY_SIZE_XNCH (PLATFORM_MAX_CHANNELS * MAX_OUT_DELAY_SIZE)
+/* The FIR maximum lengths are per channel so need to multiply them. A
+ * coefficients blob can need longer delay lines than the built-in set.
+ */
+#define MAX_FIR_DELAY_SIZE_XNCH \
+	(PLATFORM_MAX_CHANNELS * MAX(MAX_FIR_DELAY_SIZE, SOF_SRC_MAX_FIR_DELAY))
+#define MAX_OUT_DELAY_SIZE_XNCH \
+	(PLATFORM_MAX_CHANNELS * MAX(MAX_OUT_DELAY_SIZE, SOF_SRC_MAX_OUT_DELAY))
 
 LOG_MODULE_REGISTER(src, CONFIG_SOF_LOG_LEVEL);
 
@@ -88,6 +98,10 @@ struct comp_data {
 #endif /* CONFIG_IPC_MAJOR_4 */
 	struct polyphase_src src;
 	struct src_param param;
+	struct comp_data_blob_handler *model_handler;
+	struct sof_src_config *config;	/* Coefficients blob, NULL if not set */
+	struct src_stage blob_stage1;
+	struct src_stage blob_stage2;
 	int32_t *delay_lines;
 	uint32_t sink_rate;
 	uint32_t source_rate;
@@ -120,6 +134,12 @@ static int src_out_delay_length(struct src_stage *s)
 	return 1 + (s->num_of_subfilters - 1) * s->odm;
 }
 
+/* Single tap pass-through for 1:1 and for the second stage of a single
+ * stage conversion.
+ */
+static struct src_stage src_stage_bypass = { 0, 0, 1, 1, 1, 1, 1, 0, -1, NULL };
+
+#if !CONFIG_COMP_SRC_BLOB
 /* Returns index of a matching sample rate */
 static int src_find_fs(int fs_list[], int list_length, int fs)
 {
@@ -131,6 +151,153 @@ static int src_find_fs(int fs_list[], int list_length, int fs)
 	}
 	return -EINVAL;
 }
+#endif
+
+/* Sets a polyphase stage from a blob stage, the members are const */
+static void src_blob_stage_init(struct src_stage *stage, const struct sof_src_stage *cfg,
+				const void *coefs)
+{
+	const struct src_stage s = {
+		.idm = cfg->idm,
+		.odm = cfg->odm,
+		.num_of_subfilters = cfg->num_of_subfilters,
+		.subfilter_length = cfg->subfilter_length,
+		.filter_length = cfg->filter_length,
+		.blk_in = cfg->blk_in,
+		.blk_out = cfg->blk_out,
+		.halfband = cfg->halfband,
+		.shift = cfg->shift,
+		.coefs = coefs,
+	};
+
+	memcpy_s(stage, sizeof(*stage), &s, sizeof(s));
+}
+
+/* Checks a blob stage, the values are bounded before they are multiplied */
+static bool src_blob_stage_valid(struct src_stage *s)
+{
+	/* Optimized SRC requires subfilter length multiple of 4 */
+	if (s->num_of_subfilters < 1 || s->num_of_subfilters > SOF_SRC_MAX_OUT_DELAY ||
+	    s->subfilter_length < 4 || s->subfilter_length > SOF_SRC_MAX_FIR_DELAY ||
+	    (s->subfilter_length & 0x3) > 0 ||
+	    s->idm < 0 || s->idm > SOF_SRC_MAX_FIR_DELAY ||
+	    s->odm < 0 || s->odm > SOF_SRC_MAX_OUT_DELAY ||
+	    s->blk_in < 1 || s->blk_in > SOF_SRC_MAX_FIR_DELAY ||
+	    s->blk_out != s->num_of_subfilters)
+		return false;
+
+	/* The FIR cores round by the shift, there are no half-band cores */
+	if (s->shift < SOF_SRC_MIN_SHIFT || s->shift > SOF_SRC_MAX_SHIFT || s->halfband)
+		return false;
+
+	return s->filter_length == s->num_of_subfilters * s->subfilter_length &&
+	       src_fir_delay_length(s) <= SOF_SRC_MAX_FIR_DELAY &&
+	       src_out_delay_length(s) <= SOF_SRC_MAX_OUT_DELAY;
+}
+
+/* Checks a coefficients blob, also used as the blob handler validator */
+static int src_validate_config(struct comp_dev *dev, void *new_data, uint32_t new_data_size)
+{
+	const size_t coef_bytes = SRC_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+	struct sof_src_config *config = new_data;
+	struct src_stage stage;
+	uint64_t rate_in;
+	uint64_t rate_out;
+	size_t size;
+	int i;
+
+	if (new_data_size < sizeof(*config) || config->size != new_data_size ||
+	    new_data_size > SOF_SRC_MAX_SIZE) {
+		comp_err(dev, "src_validate_config(), invalid size %u", new_data_size);
+		return -EINVAL;
+	}
+
+	if (config->coef_bits != coef_bytes * 8) {
+		comp_err(dev, "src_validate_config(), coef_bits %u, need %u",
+			 config->coef_bits, coef_bytes * 8);
+		return -EINVAL;
+	}
+
+	if (config->num_stages < 1 || config->num_stages > SOF_SRC_MAX_STAGES ||
+	    !config->source_rate || config->source_rate == config->sink_rate) {
+		comp_err(dev, "src_validate_config(), invalid %u stages for %u to %u Hz",
+			 config->num_stages, config->source_rate, config->sink_rate);
+		return -EINVAL;
+	}
+
+	size = sizeof(*config);
+	rate_in = config->source_rate;
+	rate_out = config->sink_rate;
+	for (i = 0; i < config->num_stages; i++) {
+		src_blob_stage_init(&stage, &config->stage[i], NULL);
+		if (!src_blob_stage_valid(&stage)) {
+			comp_err(dev, "src_validate_config(), invalid stage %d", i + 1);
+			return -EINVAL;
+		}
+
+		size += stage.filter_length * coef_bytes;
+		rate_in *= stage.blk_out;
+		rate_out *= stage.blk_in;
+	}
+
+	if (size > new_data_size || rate_in != rate_out) {
+		comp_err(dev, "src_validate_config(), coefficients size %u or ratio mismatch",
+			 size);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Sets the polyphase stages from the current coefficients blob */
+static void src_blob_stages_init(struct comp_data *cd)
+{
+	struct sof_src_config *config = cd->config;
+	const size_t coef_bytes = SRC_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+	const uint8_t *coefs = (const uint8_t *)config->data;
+
+	src_blob_stage_init(&cd->blob_stage1, &config->stage[0], coefs);
+	if (config->num_stages > 1) {
+		coefs += config->stage[0].filter_length * coef_bytes;
+		src_blob_stage_init(&cd->blob_stage2, &config->stage[1], coefs);
+	} else {
+		memcpy_s(&cd->blob_stage2, sizeof(cd->blob_stage2), &src_stage_bypass,
+			 sizeof(src_stage_bypass));
+	}
+}
+
+/* Selects the conversion from the coefficients blob if it is for the
+ * rates, otherwise from the built-in table.
+ */
+static int src_find_stages(struct comp_data *cd, struct src_param *a, int fs_in, int fs_out)
+{
+	struct sof_src_config *config = cd->config;
+
+	a->idx_in = -EINVAL;
+	a->idx_out = -EINVAL;
+	if (config && config->source_rate == fs_in && config->sink_rate == fs_out) {
+		a->stage1 = &cd->blob_stage1;
+		a->stage2 = &cd->blob_stage2;
+		return 0;
+	}
+
+#if CONFIG_COMP_SRC_BLOB
+	if (fs_in != fs_out)
+		return -EINVAL;
+
+	a->stage1 = &src_stage_bypass;
+	a->stage2 = &src_stage_bypass;
+#else
+	a->idx_in = src_find_fs(src_in_fs, NUM_IN_FS, fs_in);
+	a->idx_out = src_find_fs(src_out_fs, NUM_OUT_FS, fs_out);
+	if (a->idx_in < 0 || a->idx_out < 0)
+		return -EINVAL;
+
+	a->stage1 = src_table1[a->idx_out][a->idx_in];
+	a->stage2 = src_table2[a->idx_out][a->idx_in];
+#endif
+	return 0;
+}
 
 /* Calculates buffers to allocate for a SRC mode */
 static int src_buffer_lengths(struct comp_dev *dev, struct comp_data *cd,
@@ -156,18 +323,16 @@ static int src_buffer_lengths(struct comp_dev *dev, struct comp_data *cd,
 	}
 
 	a->nch = nch;
-	a->idx_in = src_find_fs(src_in_fs, NUM_IN_FS, fs_in);
-	a->idx_out = src_find_fs(src_out_fs, NUM_OUT_FS, fs_out);
 
 	/* Check that both in and out rates are supported */
-	if (a->idx_in < 0 || a->idx_out < 0) {
+	if (src_find_stages(cd, a, fs_in, fs_out) < 0) {
 		comp_err(dev, "src_buffer_lengths(): rates not supported, fs_in: %u, fs_out: %u",
 			 fs_in, fs_out);
 		return -EINVAL;
 	}
 
-	stage1 = src_table1[a->idx_out][a->idx_in];
-	stage2 = src_table2[a->idx_out][a->idx_in];
+	stage1 = a->stage1;
+	stage2 = a->stage2;
 
 	/* Check from stage1 parameter for a deleted in/out rate combination.*/
 	if (stage1->filter_length < 1) {
@@ -300,29 +465,25 @@ void src_polyphase_reset(struct polyphase_src *src)
 int src_polyphase_init(struct polyphase_src *src, struct src_param *p,
 		       int32_t *delay_lines_start)
 {
-	struct src_stage *stage1;
-	struct src_stage *stage2;
 	int n_stages;
 	int ret;
 
-	if (p->idx_in < 0 || p->idx_out < 0)
+	if (!p->stage1 || !p->stage2)
 		return -EINVAL;
 
 	/* Get setup for 2 stage conversion */
-	stage1 = src_table1[p->idx_out][p->idx_in];
-	stage2 = src_table2[p->idx_out][p->idx_in];
-	ret = init_stages(stage1, stage2, src, p, 2, delay_lines_start);
+	ret = init_stages(p->stage1, p->stage2, src, p, 2, delay_lines_start);
 	if (ret < 0)
 		return -EINVAL;
 
 	/* Get number of stages used for optimize opportunity. 2nd
 	 * stage length is one if conversion needs only one stage.
-	 * If input and output rate is the same return 0 to
-	 * use a simple copy function instead of 1 stage FIR with one
-	 * tap.
+	 * If input and output rate is the same, seen as the single
+	 * tap 1st stage, return 0 to use a simple copy function
+	 * instead of 1 stage FIR with one tap.
 	 */
 	n_stages = (src->stage2->filter_length == 1) ? 1 : 2;
-	if (src_in_fs[p->idx_in] == src_out_fs[p->idx_out])
+	if (src->stage1->filter_length == 1)
 		n_stages = 0;
 
 	/* If filter length for first stage is zero this is a deleted
@@ -332,6 +493,12 @@ int src_polyphase_init(struct polyphase_src *src, struct src_param *p,
 	if (src->stage1->filter_length == 0)
 		return -EINVAL;
 
+#if SRC_GENERIC
+	/* Select the FIR core for the channels count once here */
+	src->state1.fir_filter = src_fir_get(p->nch);
+	src->state2.fir_filter = src->state1.fir_filter;
+#endif
+
 	return n_stages;
 }
 
@@ -760,6 +927,14 @@ static int src_params_general(struct comp_dev *dev, struct comp_data *cd,
 	cd->source_frames = dev->frames * cd->source_rate / cd->sink_rate;
 	cd->sink_frames = dev->frames;
 
+	/* A new coefficients blob is taken into use at stream start */
+	cd->config = NULL;
+	if (comp_is_new_data_blob_available(cd->model_handler) ||
+	    comp_is_current_data_blob_valid(cd->model_handler)) {
+		cd->config = comp_get_data_blob(cd->model_handler, NULL, NULL);
+		src_blob_stages_init(cd);
+	}
+
 	/* Allocate needed memory for delay lines */
 	comp_info(dev, "src_params(), source_rate = %u, sink_rate = %u, format = %d",
 		  cd->source_rate, cd->sink_rate, source_c->stream.frame_fmt);
@@ -931,6 +1106,15 @@ static int src_init(struct processing_module *mod)
 
 	memcpy_s(&cd->ipc_config, sizeof(cd->ipc_config), cfg->init_data, sizeof(cd->ipc_config));
 
+	/* Optional coefficients blob, applied only when not active */
+	cd->model_handler = comp_data_blob_handler_new_ext(dev, true, NULL, NULL);
+	if (!cd->model_handler) {
+		comp_err(dev, "src_init(): comp_data_blob_handler_new_ext() failed.");
+		rfree(cd);
+		return -ENOMEM;
+	}
+
+	comp_data_blob_set_validator(cd->model_handler, src_validate_config);
 	cd->delay_lines = NULL;
 	cd->src_func = src_fallback;
 	cd->polyphase_func = NULL;
@@ -1005,13 +1189,23 @@ static int src_set_config(struct processing_module *mod, uint32_t config_id,
 			  const uint8_t *fragment, size_t fragment_size, uint8_t *response,
 			  size_t response_size)
 {
-	return -EINVAL;
+	struct comp_data *cd = module_get_private_data(mod);
+
+	comp_info(mod->dev, "src_set_config()");
+
+	return comp_data_blob_set(cd->model_handler, pos, data_offset_size, fragment,
+				  fragment_size);
 }
 
 static int src_get_config(struct processing_module *mod, uint32_t config_id,
 			  uint32_t *data_offset_size, uint8_t *fragment, size_t fragment_size)
 {
-	return -EINVAL;
+	struct sof_ipc_ctrl_data *cdata = (struct sof_ipc_ctrl_data *)fragment;
+	struct comp_data *cd = module_get_private_data(mod);
+
+	comp_info(mod->dev, "src_get_config()");
+
+	return comp_data_blob_get_cmd(cd->model_handler, cdata, fragment_size);
 }
 
 static int src_reset(struct processing_module *mod)
@@ -1035,6 +1229,7 @@ static int src_free(struct processing_module *mod)
 	/* Free dynamically reserved buffers for SRC algorithm */
 	rfree(cd->delay_lines);
 
+	comp_data_blob_handler_free(cd->model_handler);
 	rfree(cd);
 	return 0;
 }
@@ -1082,6 +1277,16 @@ static struct comp_dev *src_new(const struct comp_driver *drv,
 	comp_set_drvdata(dev, cd);
 	memcpy_s(&cd->ipc_config, sizeof(cd->ipc_config), spec, sizeof(cd->ipc_config));
 
+	/* Optional coefficients blob, applied only when not active */
+	cd->model_handler = comp_data_blob_handler_new_ext(dev, true, NULL, NULL);
+	if (!cd->model_handler) {
+		comp_cl_err(&comp_src, "src_new(): comp_data_blob_handler_new_ext() failed.");
+		rfree(cd);
+		rfree(dev);
+		return NULL;
+	}
+
+	comp_data_blob_set_validator(cd->model_handler, src_validate_config);
 	cd->delay_lines = NULL;
 	cd->src_func = src_fallback;
 	cd->polyphase_func = NULL;
@@ -1100,6 +1305,7 @@ static void src_free(struct comp_dev *dev)
 	/* Free dynamically reserved buffers for SRC algorithm */
 	rfree(cd->delay_lines);
 
+	comp_data_blob_handler_free(cd->model_handler);
 	rfree(cd);
 	rfree(dev);
 }
@@ -1119,6 +1325,29 @@ static int src_ctrl_cmd(struct comp_dev *dev, struct sof_ipc_ctrl_data *cdata)
 	return -EINVAL;
 }
 
+static int src_cmd_set_data(struct comp_dev *dev, struct sof_ipc_ctrl_data *cdata)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+
+	if (cdata->cmd == SOF_CTRL_CMD_BINARY)
+		return comp_data_blob_set_cmd(cd->model_handler, cdata);
+
+	comp_err(dev, "src_cmd_set_data() error: invalid cdata->cmd");
+	return -EINVAL;
+}
+
+static int src_cmd_get_data(struct comp_dev *dev, struct sof_ipc_ctrl_data *cdata,
+			    int max_size)
+{
+	struct comp_data *cd = comp_get_drvdata(dev);
+
+	if (cdata->cmd == SOF_CTRL_CMD_BINARY)
+		return comp_data_blob_get_cmd(cd->model_handler, cdata, max_size);
+
+	comp_err(dev, "src_cmd_get_data() error: invalid cdata->cmd");
+	return -EINVAL;
+}
+
 /* used to pass standard and bespoke commands (with data) to component */
 static int src_cmd(struct comp_dev *dev, int cmd, void *data,
 		   int max_data_size)
@@ -1128,8 +1357,17 @@ static int src_cmd(struct comp_dev *dev, int cmd, void *data,
 
 	comp_info(dev, "src_cmd()");
 
-	if (cmd == COMP_CMD_SET_VALUE)
+	switch (cmd) {
+	case COMP_CMD_SET_VALUE:
 		ret = src_ctrl_cmd(dev, cdata);
+		break;
+	case COMP_CMD_SET_DATA:
+		ret = src_cmd_set_data(dev, cdata);
+		break;
+	case COMP_CMD_GET_DATA:
+		ret = src_cmd_get_data(dev, cdata, max_data_size);
+		break;
+	}
 
 	return ret;
 }
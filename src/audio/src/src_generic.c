@@ -14,15 +14,16 @@
 
 #include <sof/audio/format.h>
 #include <sof/audio/src/src.h>
+#include <sof/platform.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #if SRC_SHORT /* 16 bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch,
-				      const int shift, const int nch)
+void src_fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
+			    int32_t *fir_start, int32_t *fir_end,
+			    const int taps_x_nch,
+			    const int shift, const int nch)
 {
 	int64_t y0;
 	int64_t y1;
@@ -112,10 +113,10 @@ static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
 
 #else /* 32bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch, const int shift,
-				      const int nch)
+void src_fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
+			    int32_t *fir_start, int32_t *fir_end,
+			    const int taps_x_nch, const int shift,
+			    const int nch)
 {
 	int64_t y0;
 	int64_t y1;
@@ -208,6 +209,152 @@ static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
 
 #endif /* 32bit coefficients version */
 
+#if SRC_SHORT
+#define SRC_FIR_QSHIFT	15 /* Q2.46 -> Q2.31 */
+#else
+#define SRC_FIR_QSHIFT	23 /* Qx.54 -> Qx.31 */
+#endif
+
+/* Coefficient in Q1.15 or in Q1.23 for multiply with Q1.31 data */
+static inline int32_t src_fir_coef(const void *cp, int i)
+{
+#if SRC_SHORT
+	return ((const int16_t *)cp)[i];
+#else
+	return ((const int32_t *)cp)[i] >> 8;
+#endif
+}
+
+/*
+ * FIR core for a channels count known at compile time. All channels of a
+ * frame are computed in the same pass, so the circular wrap split is done
+ * once per sub-filter and the channels loops are fully unrolled when this
+ * is inlined with a constant nch. The subfilter length is a multiple of
+ * four so the taps loop is unrolled by four when there is no wrap. The
+ * accumulation order is the same as in src_fir_filter_generic() so the
+ * output is bit exact with it.
+ */
+static inline void fir_filter_nch(int32_t *rp, const void *cp, int32_t *wp,
+				  int32_t *fir_start, int32_t *fir_end,
+				  const int taps_x_nch, const int shift,
+				  const int nch)
+{
+	int64_t y[PLATFORM_MAX_CHANNELS];
+	const int qshift = SRC_FIR_QSHIFT + shift;
+	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
+	const int taps = taps_x_nch / nch;
+	int32_t *data;
+	int32_t c;
+	int frames;
+	int n1;
+	int i;
+	int k;
+
+	/* Data of the frame starts nch - 1 samples before rp. Note that
+	 * initialization code ensures that circular wrap does not happen
+	 * mid-frame.
+	 */
+	data = rp - (nch - 1);
+	frames = (fir_end - data) / nch; /* Frames until wrap */
+	n1 = (taps < frames) ? taps : frames;
+
+	for (k = 0; k < nch; k++)
+		y[k] = rnd;
+
+	if (n1 == taps && !(taps & 0x3)) {
+		for (i = 0; i < taps; i += 4) {
+			c = src_fir_coef(cp, i);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[k];
+
+			c = src_fir_coef(cp, i + 1);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[nch + k];
+
+			c = src_fir_coef(cp, i + 2);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[2 * nch + k];
+
+			c = src_fir_coef(cp, i + 3);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[3 * nch + k];
+
+			data += 4 * nch;
+		}
+	} else {
+		for (i = 0; i < n1; i++, data += nch) {
+			c = src_fir_coef(cp, i);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[k];
+		}
+
+		/* Continue from fir_start after the circular wrap */
+		data = fir_start;
+		for (; i < taps; i++, data += nch) {
+			c = src_fir_coef(cp, i);
+			for (k = 0; k < nch; k++)
+				y[k] += (int64_t)c * data[k];
+		}
+	}
+
+	/* Channels are in reverse order in the delay line */
+	for (k = 0; k < nch; k++)
+		wp[k] = sat_int32(y[nch - 1 - k] >> qshift);
+}
+
+static void fir_filter_1ch(int32_t *rp, const void *cp, int32_t *wp,
+			   int32_t *fir_start, int32_t *fir_end,
+			   const int taps_x_nch, const int shift, const int nch)
+{
+	fir_filter_nch(rp, cp, wp, fir_start, fir_end, taps_x_nch, shift, 1);
+}
+
+static void fir_filter_2ch(int32_t *rp, const void *cp, int32_t *wp,
+			   int32_t *fir_start, int32_t *fir_end,
+			   const int taps_x_nch, const int shift, const int nch)
+{
+	fir_filter_nch(rp, cp, wp, fir_start, fir_end, taps_x_nch, shift, 2);
+}
+
+static void fir_filter_4ch(int32_t *rp, const void *cp, int32_t *wp,
+			   int32_t *fir_start, int32_t *fir_end,
+			   const int taps_x_nch, const int shift, const int nch)
+{
+	fir_filter_nch(rp, cp, wp, fir_start, fir_end, taps_x_nch, shift, 4);
+}
+
+static void fir_filter_6ch(int32_t *rp, const void *cp, int32_t *wp,
+			   int32_t *fir_start, int32_t *fir_end,
+			   const int taps_x_nch, const int shift, const int nch)
+{
+	fir_filter_nch(rp, cp, wp, fir_start, fir_end, taps_x_nch, shift, 6);
+}
+
+static void fir_filter_8ch(int32_t *rp, const void *cp, int32_t *wp,
+			   int32_t *fir_start, int32_t *fir_end,
+			   const int taps_x_nch, const int shift, const int nch)
+{
+	fir_filter_nch(rp, cp, wp, fir_start, fir_end, taps_x_nch, shift, 8);
+}
+
+src_fir_func src_fir_get(int nch)
+{
+	switch (nch) {
+	case 1:
+		return fir_filter_1ch;
+	case 2:
+		return fir_filter_2ch;
+	case 4:
+		return fir_filter_4ch;
+	case 6:
+		return fir_filter_6ch;
+	case 8:
+		return fir_filter_8ch;
+	default:
+		return src_fir_filter_generic;
+	}
+}
+
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 void src_polyphase_stage_cir(struct src_stage_prm *s)
 {
@@ -273,8 +420,8 @@ void src_polyphase_stage_cir(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp, fir_delay, fir_end,
-					   taps_x_nch, cfg->shift, nch);
+			fir->fir_filter(rp, cp, wp, fir_delay, fir_end,
+					taps_x_nch, cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
@@ -371,8 +518,8 @@ void src_polyphase_stage_cir_s16(struct src_stage_prm *s)
 		src_inc_wrap(&rp, fir_end, fir_size);
 		wp = fir->out_rp;
 		for (i = 0; i < cfg->num_of_subfilters; i++) {
-			fir_filter_generic(rp, cp, wp, fir_delay, fir_end,
-					   taps_x_nch, cfg->shift, nch);
+			fir->fir_filter(rp, cp, wp, fir_delay, fir_end,
+					taps_x_nch, cfg->shift, nch);
 			wp += nch_x_odm;
 			cp = (char *)cp + subfilter_size;
 			src_inc_wrap(&wp, out_delay_end, out_size);
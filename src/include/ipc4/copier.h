@@ -226,11 +226,29 @@ struct ipc4_data_segment_enabled {
 	uint32_t data_seg_size;
 } __attribute__((packed, aligned(4)));
 
-/* One of copy_single_channel_cXX() to mux/demux channels into/from copier multi_endpoint_buffer */
-typedef void (* channel_copy_func)(struct audio_stream __sparse_cache *dst,
-				   int dst_channel,
-				   const struct audio_stream __sparse_cache *src,
-				   int src_channel, int frame_count);
+/* Channel of the ALH multi-gateway stream and its place in one of the endpoint buffers */
+struct copier_chmap_item {
+	uint8_t endp_idx;
+	uint8_t endp_channel;
+	uint8_t channel;
+};
+
+/* Channel map between copier multi_endpoint_buffer and the endpoint buffers */
+struct copier_chmap {
+	uint32_t channels;	/* multi_endpoint_buffer channels */
+	uint32_t endp_num;
+	uint32_t endp_channels[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	uint32_t count;		/* mapped channels */
+	struct copier_chmap_item item[SOF_IPC_MAX_CHANNELS];
+};
+
+/* One of the mux/demux_cXX() to copy frames without wrap into/from multi_endpoint_buffer */
+typedef void (*channel_map_copy_func)(const struct copier_chmap *map, void *multi_ptr,
+				      void **endp_ptr, uint32_t frames);
+
+/* PCM conversion in linear memory with the output shifted right by attenuation */
+typedef void (*copier_att_lin_func)(const void *psrc, void *pdst, uint32_t samples,
+				    uint32_t attenuation);
 
 struct copier_data {
 	/*
@@ -245,7 +263,9 @@ struct copier_data {
 
 	/* buffer to mux/demux data from/to multiple endpoint buffers for ALH multi-gateway case */
 	struct comp_buffer *multi_endpoint_buffer;
-	channel_copy_func copy_single_channel;
+	struct copier_chmap chmap;
+	channel_map_copy_func mux;
+	channel_map_copy_func demux;
 
 	bool bsource_buffer;
 
@@ -259,6 +279,8 @@ struct copier_data {
 
 	struct ipc4_audio_format out_fmt[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
 	pcm_converter_func converter[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	/* first output pin with the same format and converter, converted only once */
+	uint8_t conversion_pin[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
 	uint64_t input_total_data_processed;
 	uint64_t output_total_data_processed;
 	struct host_data *hd;
@@ -268,4 +290,10 @@ struct copier_data {
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer __sparse_cache *sink, int frame);
 
+/* Returns the conversion with attenuation fused in for the plain converter from in to out
+ * format, or NULL when there is none and the attenuation has to be applied separately.
+ */
+copier_att_lin_func get_attenuated_converter(pcm_converter_func converter,
+					     enum sof_ipc_frame in, enum sof_ipc_frame out);
+
 #endif
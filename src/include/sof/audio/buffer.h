@@ -159,6 +159,7 @@ struct comp_buffer {
 
 	bool hw_params_configured; /**< indicates whether hw params were set */
 	bool walking;		/**< indicates if the buffer is being walked */
+	bool spsc;		/**< single producer and consumer on one core */
 };
 
 /* Only to be used for synchronous same-core notifications! */
@@ -177,6 +177,13 @@ static inline int comp_prepare(struct comp_dev *dev)
 
 int comp_copy(struct comp_dev *dev);
 
+#if CONFIG_LIBRARY
+/**
+ * Testbench profiler hook. When set, comp_copy() calls it in place of the
+ * component copy() op and the hook is responsible for calling the op.
+ */
+extern int (*comp_copy_hook)(struct comp_dev *dev);
+#endif
 
 /** See comp_ops::get_attribute */
 static inline int comp_get_attribute(struct comp_dev *dev, uint32_t type,
@@ -8,8 +8,10 @@
 #ifndef __SOF_AUDIO_KPB_H__
 #define __SOF_AUDIO_KPB_H__
 
+#include <sof/compiler_attributes.h>
 #include <sof/trace/trace.h>
 #include <user/trace.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(__XCC__)
@@ -157,6 +159,9 @@ struct history_data {
 	size_t buffered; /**< amount of buffered data */
 	size_t free; /** spce we can use to write new data */
 	struct history_buffer *c_hb; /**< current buffer used for writing */
+	uint32_t valid_bits; /**< valid bits of stream samples */
+	uint32_t container_bytes; /**< stream bytes per sample */
+	uint32_t sample_bytes; /**< history buffer bytes per sample */
 };
 
 enum ipc4_kpb_module_config_params {
@@ -171,6 +176,20 @@ struct kpb_micselector_config {
 	/* channel bit set to 1 implies channel selection */
 	uint32_t mask;
 };
+
+void *kpb_alloc_largest_block(uint32_t caps, size_t max_size,
+			      size_t frame_bytes, size_t *size);
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+struct audio_stream;
+
+void kpb_pack_32b(const struct audio_stream __sparse_cache *source, int ioffset,
+		  void *linear_sink, unsigned int samples,
+		  const struct history_data *hd);
+void kpb_unpack_32b(const void *linear_source, struct audio_stream __sparse_cache *sink,
+		    unsigned int samples, const struct history_data *hd);
+#endif
+
 #ifdef UNIT_TEST
 void sys_comp_kpb_init(void);
 #endif
@@ -63,11 +63,11 @@ struct mfcc_pre_emph {
 
 struct mfcc_fft {
 #if MFCC_FFT_BITS == 16
-	struct icomplex16 *fft_buf; /**< fft_padded_size */
-	struct icomplex16 *fft_out; /**< fft_padded_size */
+	int16_t *fft_buf; /**< fft_padded_size real samples */
+	struct icomplex16 *fft_out; /**< fft_padded_size / 2 + 1 used */
 #elif MFCC_FFT_BITS == 32
-	struct icomplex32 *fft_buf; /**< fft_padded_size */
-	struct icomplex32 *fft_out; /**< fft_padded_size */
+	int32_t *fft_buf; /**< fft_padded_size real samples */
+	struct icomplex32 *fft_out; /**< fft_padded_size / 2 + 1 used */
 #else
 #error "MFCC_FFT_BITS needs to be 16 or 32"
 #endif
@@ -76,9 +76,9 @@ struct mfcc_fft {
 	int fft_size;
 	int fft_padded_size;
 	int fft_hop_size;
-	int fft_buf_size;
+	int fft_buf_size; /**< fft_buf bytes */
 	int half_fft_size;
-	size_t fft_buffer_size; /**< bytes */
+	size_t fft_buffer_size; /**< fft_out bytes */
 };
 
 struct mfcc_cepstral_lifter {
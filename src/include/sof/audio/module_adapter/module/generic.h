@@ -189,6 +189,14 @@ struct processing_module {
 	 */
 	bool simple_copy;
 
+	/*
+	 * flag set by a module processing raw bytes from the module input and output buffers
+	 * that can work on the source and sink buffer memory directly. When the period data
+	 * does not wrap, the input and output buffer data point into the audio streams and the
+	 * copies to and from the module buffers and the input buffer clearing are skipped.
+	 */
+	bool contiguous_view;
+
 	/* module-specific flags for comp_verify_params() */
 	uint32_t verify_params_flags;
 
@@ -49,6 +49,30 @@ struct ipc_msg;
 #define PPL_DIR_DOWNSTREAM	0
 #define PPL_DIR_UPSTREAM	1
 
+/* max number of components visited by the pipeline copy walk */
+#define PPL_COPY_SCHED_MAX	UINT16_MAX
+
+/** \brief Component visited by the pipeline copy walk. */
+struct pipeline_copy_entry {
+	struct comp_dev *comp;
+	uint16_t walk_end;	/**< index after the components walked from comp */
+};
+
+/**
+ * \brief Pipeline copy walk flattened into an array.
+ *
+ * Entries are in the order the walk reaches them, components walked from
+ * an entry follow it up to walk_end. This allows the copy to skip whole
+ * branches behind inactive components just like the recursive walk does.
+ */
+struct pipeline_copy_sched {
+	struct comp_dev *start;		/**< component the walk starts from */
+	int dir;			/**< walk direction */
+	uint16_t count;			/**< number of entries */
+	uint16_t *pending;		/**< upstream copy stack, count items */
+	struct pipeline_copy_entry entries[];
+};
+
 /*
  * Audio pipeline.
  */
@@ -81,6 +105,8 @@ struct pipeline {
 	struct comp_dev *source_comp;
 	/* sink component for this pipe */
 	struct comp_dev *sink_comp;
+	/* flattened copy walk, NULL to walk the graph on each copy */
+	struct pipeline_copy_sched *copy_sched;
 
 	struct list_item list;	/**< list in walk context */
 
@@ -292,6 +318,22 @@ int pipeline_trigger_run(struct pipeline *p, struct comp_dev *host, int cmd);
  */
 int pipeline_copy(struct pipeline *p);
 
+/**
+ * \brief Flattens the copy walk of the pipeline into an array.
+ *
+ * Called when the pipeline is prepared and when its graph changes, copy
+ * walks the graph when the schedule is missing.
+ * \param[in] p pipeline.
+ * \return 0 on success.
+ */
+int pipeline_copy_sched_build(struct pipeline *p);
+
+/**
+ * \brief Frees the flattened copy walk of the pipeline.
+ * \param[in] p pipeline.
+ */
+void pipeline_copy_sched_free(struct pipeline *p);
+
 /**
  * \brief Get time pipeline timestamps from host to dai.
  * \param[in] p pipeline.
@@ -26,6 +26,8 @@ struct src_param {
 	int idx_in;
 	int idx_out;
 	int nch;
+	struct src_stage *stage1;	/* Selected conversion, from table or blob */
+	struct src_stage *stage2;
 };
 
 struct src_stage {
@@ -41,6 +43,11 @@ struct src_stage {
 	const void *coefs; /* Can be int16_t or int32_t depending on config */
 };
 
+/* FIR core for one output frame of a polyphase sub-filter */
+typedef void (*src_fir_func)(int32_t *rp, const void *cp, int32_t *wp0,
+			     int32_t *fir_start, int32_t *fir_end,
+			     const int taps_x_nch, const int shift, const int nch);
+
 struct src_state {
 	int fir_delay_size;	/* samples */
 	int out_delay_size;	/* samples */
@@ -48,6 +55,7 @@ struct src_state {
 	int32_t *out_delay;
 	int32_t *fir_wp;
 	int32_t *out_rp;
+	src_fir_func fir_filter;	/* FIR core for the channels count */
 };
 
 struct polyphase_src {
@@ -115,6 +123,12 @@ void src_polyphase_stage_cir(struct src_stage_prm *s);
 void src_polyphase_stage_cir_s16(struct src_stage_prm *s);
 #endif /* CONFIG_FORMAT_S16LE */
 
+src_fir_func src_fir_get(int nch);
+
+void src_fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
+			    int32_t *fir_start, int32_t *fir_end,
+			    const int taps_x_nch, const int shift, const int nch);
+
 int32_t src_input_rates(void);
 
 int32_t src_output_rates(void);
@@ -110,16 +110,17 @@ struct sof_ipc_ctrl_value_chan;
 #define VOL_S32_SAMPLES_TO_BYTES(s)	((s) << 2)
 
 /**
- * \brief volume processing function interface
+ * \brief Extra fractional bits of the per frame interpolated ramp gain.
+ * The ramp gain is Qx.y with y = VOL_QXY_Y + VOL_RAMP_FRAC_BITS, it fits
+ * int32_t since VOL_MAX is below 2^23.
  */
-typedef void (*vol_scale_func)(struct processing_module *mod, struct input_stream_buffer *source,
-			struct output_stream_buffer *sink, uint32_t frames, uint32_t attenuation);
+#define VOL_RAMP_FRAC_BITS	7
 
 /**
- * \brief volume interface for function getting nearest zero crossing frame
+ * \brief volume processing function interface
  */
-typedef uint32_t (*vol_zc_func)(const struct audio_stream __sparse_cache *source,
-				uint32_t frames, int64_t *prev_sum);
+typedef void (*vol_scale_func)(struct processing_module *mod, struct input_stream_buffer *source,
+			struct output_stream_buffer *sink, uint32_t frames, uint32_t attenuation);
 
 /**
  * \brief Function for volume ramp shape function
@@ -139,6 +140,10 @@ struct vol_data {
 	int32_t mvolume[SOF_IPC_MAX_CHANNELS];	/**< mute volume */
 	int32_t rvolume[SOF_IPC_MAX_CHANNELS];	/**< ramp start volume */
 	int32_t ramp_coef[SOF_IPC_MAX_CHANNELS]; /**< parameter for slope */
+	/**< interpolated ramp gain, VOL_RAMP_FRAC_BITS extra fraction bits */
+	int32_t ramp_vol[SOF_IPC_MAX_CHANNELS];
+	/**< ramp gain increment per frame, same format as ramp_vol */
+	int32_t ramp_delta[SOF_IPC_MAX_CHANNELS];
 	/**< store current volume 4 times for scale_vol function */
 	int32_t *vol;
 	uint32_t initial_ramp;			/**< ramp space in ms */
@@ -154,7 +159,7 @@ struct vol_data {
 	bool muted[SOF_IPC_MAX_CHANNELS];	/**< set if channel is muted */
 	bool ramp_finished;			/**< control ramp launch */
 	vol_scale_func scale_vol;		/**< volume processing function */
-	vol_zc_func zc_get;			/**< function getting nearest zero crossing frame */
+	vol_scale_func scale_vol_ramp;		/**< volume processing function with ramp */
 	bool copy_gain;				/**< control copy gain or not */
 	uint32_t attenuation;			/**< peakmeter adjustment in range [0 - 31] */
 };
@@ -171,51 +176,60 @@ extern const struct comp_func_map volume_func_map[];
 /** \brief Number of processing functions. */
 extern const size_t volume_func_count;
 
-/** \brief Volume zero crossing functions map. */
-struct comp_zc_func_map {
-	uint16_t frame_fmt;	/**< frame format */
-	vol_zc_func func;	/**< volume zc function */
-};
+/**
+ * \brief Map of formats with ramp processing functions. The ramp functions
+ * interpolate the gain per frame from ramp_vol with ramp_delta steps.
+ */
+extern const struct comp_func_map volume_ramp_func_map[];
+
+/** \brief Number of ramp processing functions. */
+extern const size_t volume_ramp_func_count;
 
 #if CONFIG_IPC_MAJOR_3
 /**
- * \brief Retrievies volume processing function.
+ * \brief Retrievies volume processing function from a map.
  * \param[in,out] dev Volume base component device.
  * \param[in] sinkb Sink buffer to match against
+ * \param[in] map Processing functions map
+ * \param[in] count Number of functions in map
  */
-static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
-							 struct comp_buffer __sparse_cache *sinkb)
+static inline vol_scale_func vol_get_map_function(struct comp_dev *dev,
+						  struct comp_buffer __sparse_cache *sinkb,
+						  const struct comp_func_map *map, size_t count)
 {
 	int i;
 
 	/* map the volume function for source and sink buffers */
-	for (i = 0; i < volume_func_count; i++) {
-		if (sinkb->stream.frame_fmt != volume_func_map[i].frame_fmt)
+	for (i = 0; i < count; i++) {
+		if (sinkb->stream.frame_fmt != map[i].frame_fmt)
 			continue;
 
-		return volume_func_map[i].func;
+		return map[i].func;
 	}
 
 	return NULL;
 }
 #else
 /**
- * \brief Retrievies volume processing function.
+ * \brief Retrievies volume processing function from a map.
  * \param[in,out] dev Volume base component device.
  * \param[in] sinkb Sink buffer to match against
+ * \param[in] map Processing functions map
+ * \param[in] count Number of functions in map
  */
-static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
-							 struct comp_buffer __sparse_cache *sinkb)
+static inline vol_scale_func vol_get_map_function(struct comp_dev *dev,
+						  struct comp_buffer __sparse_cache *sinkb,
+						  const struct comp_func_map *map, size_t count)
 {
 	struct processing_module *mod = comp_get_drvdata(dev);
 
 	switch (mod->priv.cfg.base_cfg.audio_fmt.valid_bit_depth) {
 	case IPC4_DEPTH_16BIT:
-		return volume_func_map[0].func;
+		return map[0].func;
 	case IPC4_DEPTH_24BIT:
-		return volume_func_map[1].func;
+		return map[1].func;
 	case IPC4_DEPTH_32BIT:
-		return volume_func_map[2].func;
+		return map[2].func;
 	default:
 		comp_err(dev, "vol_get_processing_function(): unsupported depth %d",
 			 mod->priv.cfg.base_cfg.audio_fmt.depth);
@@ -224,6 +238,28 @@ static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
 }
 #endif
 
+/**
+ * \brief Retrievies volume processing function.
+ * \param[in,out] dev Volume base component device.
+ * \param[in] sinkb Sink buffer to match against
+ */
+static inline vol_scale_func vol_get_processing_function(struct comp_dev *dev,
+							 struct comp_buffer __sparse_cache *sinkb)
+{
+	return vol_get_map_function(dev, sinkb, volume_func_map, volume_func_count);
+}
+
+/**
+ * \brief Retrievies volume processing function with per frame gain ramp.
+ * \param[in,out] dev Volume base component device.
+ * \param[in] sinkb Sink buffer to match against
+ */
+static inline vol_scale_func vol_get_ramp_function(struct comp_dev *dev,
+						   struct comp_buffer __sparse_cache *sinkb)
+{
+	return vol_get_map_function(dev, sinkb, volume_ramp_func_map, volume_ramp_func_count);
+}
+
 static inline void peak_vol_update(struct vol_data *cd)
 {
 #if CONFIG_COMP_PEAK_VOL
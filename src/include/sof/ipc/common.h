@@ -43,6 +43,9 @@ extern struct tr_ctx ipc_tr;
 #define ipc_get_ppl_sink_comp(ipc, ppl_id) \
 	ipc_get_ppl_comp(ipc, ppl_id, PPL_DIR_DOWNSTREAM)
 
+/* buckets of the component id and pipeline id indexes, power of two */
+#define IPC_COMP_HASH_SIZE	32
+
 #define IPC_TASK_INLINE		BIT(0)
 #define IPC_TASK_IN_THREAD	BIT(1)
 #define IPC_TASK_SECONDARY_CORE	BIT(2)
@@ -61,6 +64,8 @@ struct ipc {
 	unsigned int core;		/* core, processing the IPC */
 
 	struct list_item comp_list;	/* list of component devices */
+	struct list_item comp_id_hash[IPC_COMP_HASH_SIZE];	/* comp_list by id */
+	struct list_item comp_ppl_hash[IPC_COMP_HASH_SIZE];	/* comp_list by pipeline id */
 
 	/* processing task */
 	struct task ipc_task;
@@ -72,6 +77,12 @@ struct ipc {
 	void *private;
 };
 
+/* IPC4 ids have the instance in the upper half, fold it into the bucket index */
+static inline uint32_t ipc_comp_hash(uint32_t id)
+{
+	return (id ^ (id >> 16)) & (IPC_COMP_HASH_SIZE - 1);
+}
+
 #define ipc_set_drvdata(ipc, data) \
 	((ipc)->private = data)
 #define ipc_get_drvdata(ipc) \
@@ -84,6 +84,8 @@ struct ipc_comp_dev {
 
 	/* lists */
 	struct list_item list;		/* list in components */
+	struct list_item id_list;	/* list in id hash bucket */
+	struct list_item ppl_list;	/* list in pipeline id hash bucket */
 };
 
 /**
@@ -166,6 +168,19 @@ int ipc_comp_disconnect(struct ipc *ipc, ipc_pipe_comp_connect *connect);
  */
 struct ipc_comp_dev *ipc_get_comp_by_id(struct ipc *ipc, uint32_t id);
 
+/**
+ * \brief Add IPC component device to the component list and its indexes.
+ * @param ipc The global IPC context.
+ * @param icd The component device, with type, ID and device already set.
+ */
+void ipc_comp_dev_add(struct ipc *ipc, struct ipc_comp_dev *icd);
+
+/**
+ * \brief Remove IPC component device from the component list and its indexes.
+ * @param icd The component device.
+ */
+void ipc_comp_dev_del(struct ipc_comp_dev *icd);
+
 /**
  * \brief Get component device from pipeline ID and type.
  * @param ipc The global IPC context.
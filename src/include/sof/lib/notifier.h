@@ -12,6 +12,7 @@
 #include <sof/list.h>
 #include <rtos/spinlock.h>
 #include <rtos/sof.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* notifier target core masks */
@@ -90,6 +91,12 @@ void notifier_unregister_all(void *receiver_data_filter, void *caller_id_filter)
 
 void notifier_notify_remote(void);
 
+/* check for callbacks of an event type on this core before building the event */
+static inline bool notifier_has_callbacks(enum notify_id type)
+{
+	return !list_is_empty(&(*arch_notify_get())->list[type]);
+}
+
 /* data_size is required to manage cache coherency for notifications
  * across cores.
  */
@@ -49,12 +49,30 @@ struct fft_plan {
 	struct icomplex32 *outb32;	/* pointer to output integer complex buffer */
 	struct icomplex16 *inb16;	/* pointer to input integer complex buffer */
 	struct icomplex16 *outb16;	/* pointer to output integer complex buffer */
+	bool real;	/* real input plan, executed with fft_execute_real_16/32() */
 };
 
+/* twiddle factors, defined in fft_16.c and fft_32.c for all FFT versions */
+extern const int16_t twiddle_real_16[FFT_SIZE_MAX];
+extern const int16_t twiddle_imag_16[FFT_SIZE_MAX];
+extern const int32_t twiddle_real_32[FFT_SIZE_MAX];
+extern const int32_t twiddle_imag_32[FFT_SIZE_MAX];
+
 /* interfaces of the library */
 struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits);
 void fft_execute_16(struct fft_plan *plan, bool ifft);
 void fft_execute_32(struct fft_plan *plan, bool ifft);
 void fft_plan_free(struct fft_plan *plan16);
 
+/*
+ * Real input FFT. The size real samples in inb are packed as size / 2 complex
+ * samples and transformed with a half length complex FFT, a post-twiddle stage
+ * splits the result into size / 2 + 1 complex bins in outb. The outb buffer must
+ * have room for size / 2 + 1 complex values. The scaling is the same 1/size as for
+ * a complex FFT of the same size.
+ */
+struct fft_plan *fft_plan_new_real(void *inb, void *outb, uint32_t size, int bits);
+void fft_execute_real_16(struct fft_plan *plan);
+void fft_execute_real_32(struct fft_plan *plan);
+
 #endif /* __SOF_FFT_H__ */
@@ -13,6 +13,9 @@
 
 #define IIR_DF1_NUM_STATE 4
 
+/* Max channels run in lockstep by the multi-channel IIR */
+#define IIR_DF1_MULTI_MAX_CH 8
+
 #if defined __XCC__
 #include <xtensa/config/core-isa.h>
 #if XCHAL_HAVE_HIFI3
@@ -37,6 +40,21 @@ struct iir_state_df1 {
 	int32_t *delay; /* Pointer to IIR delay line */
 };
 
+/*
+ * Multi-channel IIR state, runs the same biquads structure for all the
+ * channels in lockstep. Coefficients and delays are stored channels
+ * interleaved, e.g. {a2 ch0, a2 ch1, ..., a1 ch0, a1 ch1, ...}.
+ */
+struct iir_multi_state_df1 {
+	unsigned int channels; /* Channels count, even, zero if not used */
+	unsigned int biquads; /* Number of IIR 2nd order sections total */
+	unsigned int biquads_in_series; /* Number of IIR 2nd order sections
+					 * in series.
+					 */
+	int32_t *coef; /* Pointer to interleaved IIR coefficients */
+	int32_t *delay; /* Pointer to interleaved IIR delay line */
+};
+
 struct sof_eq_iir_header;
 
 int iir_init_coef_df1(struct iir_state_df1 *iir,
@@ -50,6 +68,15 @@ void iir_reset_df1(struct iir_state_df1 *iir);
 
 int32_t iir_df1(struct iir_state_df1 *iir, int32_t x);
 
+int iir_multi_size_df1(struct iir_state_df1 *iir, int nch);
+
+void iir_init_multi_df1(struct iir_multi_state_df1 *multi, struct iir_state_df1 *iir,
+			int nch, int32_t *data);
+
+void iir_reset_multi_df1(struct iir_multi_state_df1 *multi);
+
+void iir_df1_multi(struct iir_multi_state_df1 *multi, int32_t *x);
+
 /* Inline functions */
 #if IIR_DF1_HIFI3
 #include "iir_df1_hifi3.h"
@@ -10,6 +10,17 @@
 
 #include <stdint.h>
 
+/* Q1.31 IIR output to s16 and s24 */
+static inline int16_t iir_df1_out_s16(int32_t y)
+{
+	return sat_int16(Q_SHIFT_RND(y, 31, 15));
+}
+
+static inline int32_t iir_df1_out_s24(int32_t y)
+{
+	return sat_int24(Q_SHIFT_RND(y, 31, 23));
+}
+
 static inline int16_t iir_df1_s16(struct iir_state_df1 *iir, int16_t x)
 {
 	return sat_int16(Q_SHIFT_RND(iir_df1(iir, ((int32_t)x) << 16), 31, 15));
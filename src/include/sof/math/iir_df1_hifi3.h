@@ -11,6 +11,21 @@
 #include <xtensa/tie/xt_hifi3.h>
 #include <stdint.h>
 
+/* Q1.31 IIR output to s16 and s24 */
+static inline int16_t iir_df1_out_s16(int32_t y)
+{
+	ae_f32x2 v = y;
+
+	return AE_ROUND16X4F32SSYM(v, v);
+}
+
+static inline int32_t iir_df1_out_s24(int32_t y)
+{
+	ae_f32x2 v = y;
+
+	return AE_SRAI32(AE_SLAI32S(AE_SRAI32R(v, 8), 8), 8);
+}
+
 static inline int16_t iir_df1_s16(struct iir_state_df1 *iir, int16_t x)
 {
 	ae_f32x2 y = iir_df1(iir, ((int32_t)x) << 16);
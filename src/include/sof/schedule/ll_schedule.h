@@ -41,6 +41,14 @@ int schedule_task_init_ll(struct task *task,
 			  const struct sof_uuid_entry *uid, uint16_t type,
 			  uint16_t priority, enum task_state (*run)(void *data),
 			  void *data, uint16_t core, uint32_t flags);
+
+#if CONFIG_LIBRARY
+/* testbench: host threads emulating cores, pipelines can be spread over them */
+#define SCHEDULE_LL_VCORES	8
+
+/* testbench: run one LL tick on core when domain is full synchronous */
+int schedule_ll_run_tick(int core);
+#endif
 #else
 int zephyr_ll_scheduler_init(struct ll_schedule_domain *domain);
 
@@ -18,6 +18,9 @@
 struct ipc_msg;
 struct sof;
 
+/* size of the per core trace ring, a power of two */
+#define DMA_TRACE_CORE_SIZE	(DMA_TRACE_LOCAL_SIZE / 2)
+
 struct dma_trace_buf {
 	void *w_ptr;		/* buffer write pointer */
 	void *r_ptr;		/* buffer read position */
@@ -27,6 +30,18 @@ struct dma_trace_buf {
 	uint32_t avail;		/* bytes available to read */
 };
 
+/* Per core trace ring in coherent memory. Filled only by its own core and
+ * drained to dma_trace_buf by trace_work() on the primary core, so the cores
+ * never contend for a lock when logging.
+ */
+struct dma_trace_core {
+	void *addr;			/* ring base address */
+	uint32_t w_pos;			/* free running write position */
+	uint32_t r_pos;			/* free running read position */
+	uint32_t dropped_entries;	/* amount of dropped entries */
+	uint32_t dropped_reported;	/* dropped entries already logged */
+};
+
 struct dma_trace_data {
 	struct dma_sg_config config;
 	struct dma_trace_buf dmatb;
@@ -45,7 +60,7 @@ struct dma_trace_data {
 	uint32_t dma_copy_align;	/* Minimal chunk of data possible to be
 					 *  copied by dma connected to host
 					 */
-	uint32_t dropped_entries;	/* amount of dropped entries */
+	struct dma_trace_core core[CONFIG_CORE_COUNT];
 	struct k_spinlock lock;		/* dma trace lock */
 	uint64_t time_delta;		/* difference between the host time */
 };
@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __USER_SRC_H__
+#define __USER_SRC_H__
+
+#include <stdint.h>
+
+#define SOF_SRC_MAX_STAGES	2	/* Conversion is done in one or two stages */
+#define SOF_SRC_MAX_SIZE	65536	/* Max size for the blob in bytes */
+#define SOF_SRC_MAX_FIR_DELAY	1024	/* Max stage FIR delay line length per channel */
+#define SOF_SRC_MAX_OUT_DELAY	1024	/* Max stage output delay line length per channel */
+#define SOF_SRC_MIN_SHIFT	0	/* Min stage FIR output shift */
+#define SOF_SRC_MAX_SHIFT	3	/* Max stage FIR output shift */
+
+/*
+ * sof_src_config data[]
+ *
+ * coef_stage1[stage[0].filter_length];  int16_t or int32_t per coef_bits
+ * coef_stage2[stage[1].filter_length];  Present if num_stages is two
+ *
+ * The coefficients of a stage are ordered as num_of_subfilters polyphase
+ * sub-filters of subfilter_length taps each. The sub-filter length must
+ * be a multiple of four.
+ */
+
+struct sof_src_stage {
+	int32_t idm;			/* Input delay line step between sub-filters */
+	int32_t odm;			/* Output delay line step between sub-filters */
+	int32_t num_of_subfilters;	/* Number of polyphase sub-filters, L */
+	int32_t subfilter_length;	/* Taps per sub-filter */
+	int32_t filter_length;		/* num_of_subfilters * subfilter_length */
+	int32_t blk_in;			/* Input frames per block, M */
+	int32_t blk_out;		/* Output frames per block, L */
+	int32_t halfband;		/* Reserved, set to zero */
+	int32_t shift;			/* Output shift of the filter, 0 to 3 */
+	int32_t reserved;		/* To keep data 64 bit aligned */
+} __attribute__((packed));
+
+struct sof_src_config {
+	uint32_t size;			/* Size of entire struct */
+	uint32_t source_rate;		/* Input rate in Hz */
+	uint32_t sink_rate;		/* Output rate in Hz */
+	uint16_t num_stages;		/* 1 or 2 */
+	uint16_t coef_bits;		/* 16 or 32, must match the firmware build */
+	uint32_t reserved[4];		/* For future */
+	struct sof_src_stage stage[SOF_SRC_MAX_STAGES];
+
+	int32_t data[];
+} __attribute__((packed));
+
+#endif /* __USER_SRC_H__ */
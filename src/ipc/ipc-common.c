@@ -89,8 +89,8 @@ struct ipc_comp_dev *ipc_get_comp_by_id(struct ipc *ipc, uint32_t id)
 	struct ipc_comp_dev *icd;
 	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, &ipc->comp_id_hash[ipc_comp_hash(id)]) {
+		icd = container_of(clist, struct ipc_comp_dev, id_list);
 		if (icd->id == id)
 			return icd;
 	}
@@ -98,8 +98,26 @@ struct ipc_comp_dev *ipc_get_comp_by_id(struct ipc *ipc, uint32_t id)
 	return NULL;
 }
 
-/* Walks through the list of components looking for a sink/source endpoint component
- * of the given pipeline
+/* The id and pipeline id indexes keep the order of comp_list, so lookups find
+ * the same device as a walk of comp_list would.
+ */
+void ipc_comp_dev_add(struct ipc *ipc, struct ipc_comp_dev *icd)
+{
+	list_item_append(&icd->list, &ipc->comp_list);
+	list_item_append(&icd->id_list, &ipc->comp_id_hash[ipc_comp_hash(icd->id)]);
+	list_item_append(&icd->ppl_list,
+			 &ipc->comp_ppl_hash[ipc_comp_hash(ipc_comp_pipe_id(icd))]);
+}
+
+void ipc_comp_dev_del(struct ipc_comp_dev *icd)
+{
+	list_item_del(&icd->list);
+	list_item_del(&icd->id_list);
+	list_item_del(&icd->ppl_list);
+}
+
+/* Walks through the components of the given pipeline looking for a sink/source
+ * endpoint component
  */
 struct ipc_comp_dev *ipc_get_ppl_comp(struct ipc *ipc, uint32_t pipeline_id, int dir)
 {
@@ -109,8 +127,8 @@ struct ipc_comp_dev *ipc_get_ppl_comp(struct ipc *ipc, uint32_t pipeline_id, int
 	struct list_item *clist, *blist;
 	struct ipc_comp_dev *next_ppl_icd = NULL;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, &ipc->comp_ppl_hash[ipc_comp_hash(pipeline_id)]) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
 		if (icd->type != COMP_TYPE_COMPONENT)
 			continue;
 
@@ -247,6 +265,8 @@ void ipc_schedule_process(struct ipc *ipc)
 
 int ipc_init(struct sof *sof)
 {
+	int i;
+
 	tr_dbg(&ipc_tr, "ipc_init()");
 
 	/* init ipc data */
@@ -257,6 +277,10 @@ int ipc_init(struct sof *sof)
 	k_spinlock_init(&sof->ipc->lock);
 	list_init(&sof->ipc->msg_list);
 	list_init(&sof->ipc->comp_list);
+	for (i = 0; i < IPC_COMP_HASH_SIZE; i++) {
+		list_init(&sof->ipc->comp_id_hash[i]);
+		list_init(&sof->ipc->comp_ppl_hash[i]);
+	}
 
 #ifdef __ZEPHYR__
 	k_work_init_delayable(&sof->ipc->z_delayed_work, ipc_work_handler);
@@ -323,7 +323,7 @@ int ipc_comp_free(struct ipc *ipc, uint32_t comp_id)
 
 	icd->cd = NULL;
 
-	list_item_del(&icd->list);
+	ipc_comp_dev_del(icd);
 	rfree(icd);
 
 	return 0;
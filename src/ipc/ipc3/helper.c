@@ -293,8 +293,8 @@ struct ipc_comp_dev *ipc_get_comp_by_ppl_id(struct ipc *ipc, uint16_t type, uint
 	struct ipc_comp_dev *icd;
 	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
+	list_for_item(clist, &ipc->comp_ppl_hash[ipc_comp_hash(ppl_id)]) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
 		if (icd->type != type)
 			continue;
 		if (!cpu_is_me(icd->core))
@@ -402,7 +402,7 @@ int ipc_pipeline_new(struct ipc *ipc, ipc_pipe_new *_pipe_desc)
 	ipc_pipe->id = pipe_desc->comp_id;
 
 	/* add new pipeline to the list */
-	list_item_append(&ipc_pipe->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, ipc_pipe);
 
 	return 0;
 }
@@ -435,7 +435,7 @@ int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id)
 		return ret;
 	}
 	ipc_pipe->pipeline = NULL;
-	list_item_del(&ipc_pipe->list);
+	ipc_comp_dev_del(ipc_pipe);
 	rfree(ipc_pipe);
 
 	return 0;
@@ -474,7 +474,7 @@ int ipc_buffer_new(struct ipc *ipc, const struct sof_ipc_buffer *desc)
 	ibd->id = desc->comp.id;
 
 	/* add new buffer to the list */
-	list_item_append(&ibd->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, ibd);
 
 	return ret;
 }
@@ -569,7 +569,7 @@ int ipc_buffer_free(struct ipc *ipc, uint32_t buffer_id)
 
 	/* free buffer and remove from list */
 	buffer_free(ibd->cb);
-	list_item_del(&ibd->list);
+	ipc_comp_dev_del(ibd);
 	rfree(ibd);
 
 	return 0;
@@ -670,7 +670,7 @@ int ipc_comp_new(struct ipc *ipc, ipc_comp *_comp)
 	icd->id = comp->id;
 
 	/* add new component to the list */
-	list_item_append(&icd->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, icd);
 
 	return 0;
 }
@@ -504,7 +504,7 @@ static int ipc4_process_chain_dma(struct ipc4_message_request *ipc4)
 		return IPC4_INVALID_CHAIN_STATE_TRANSITION;
 
 	if (!cdma.primary.r.allocate && !cdma.primary.r.enable)
-		list_item_del(&cdma_comp->list);
+		ipc_comp_dev_del(cdma_comp);
 
 	return IPC4_SUCCESS;
 #else
@@ -126,23 +126,27 @@ struct ipc_comp_dev *ipc_get_comp_by_ppl_id(struct ipc *ipc, uint16_t type, uint
 	struct ipc_comp_dev *icd;
 	struct list_item *clist;
 
-	list_for_item(clist, &ipc->comp_list) {
-		icd = container_of(clist, struct ipc_comp_dev, list);
-		if (icd->type != type)
-			continue;
-
-		/* For IPC4, ipc_comp_dev.id field is equal to Pipeline ID
-		 * in case of type COMP_TYPE_PIPELINE - can check directly here
-		 */
-		if (type == COMP_TYPE_PIPELINE) {
-			if (icd->id == ppl_id)
-				return icd;
-		} else {
-			if (!cpu_is_me(icd->core))
-				continue;
-			if (ipc_comp_pipe_id(icd) == ppl_id)
+	/* For IPC4, ipc_comp_dev.id field is equal to Pipeline ID
+	 * in case of type COMP_TYPE_PIPELINE - can look it up by id directly here
+	 */
+	if (type == COMP_TYPE_PIPELINE) {
+		list_for_item(clist, &ipc->comp_id_hash[ipc_comp_hash(ppl_id)]) {
+			icd = container_of(clist, struct ipc_comp_dev, id_list);
+			if (icd->type == type && icd->id == ppl_id)
 				return icd;
 		}
+
+		return NULL;
+	}
+
+	list_for_item(clist, &ipc->comp_ppl_hash[ipc_comp_hash(ppl_id)]) {
+		icd = container_of(clist, struct ipc_comp_dev, ppl_list);
+		if (icd->type != type)
+			continue;
+		if (!cpu_is_me(icd->core))
+			continue;
+		if (ipc_comp_pipe_id(icd) == ppl_id)
+			return icd;
 	}
 	return NULL;
 }
@@ -196,7 +200,7 @@ static int ipc4_create_pipeline(struct ipc4_pipeline_create *pipe_desc)
 	ipc_pipe->pipeline->attributes = pipe_desc->extension.r.attributes;
 
 	/* add new pipeline to the list */
-	list_item_append(&ipc_pipe->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, ipc_pipe);
 
 	return IPC4_SUCCESS;
 }
@@ -295,7 +299,7 @@ int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id)
 	}
 
 	ipc_pipe->pipeline = NULL;
-	list_item_del(&ipc_pipe->list);
+	ipc_comp_dev_del(ipc_pipe);
 	rfree(ipc_pipe);
 
 	return IPC4_SUCCESS;
@@ -701,7 +705,7 @@ int ipc4_add_comp_dev(struct comp_dev *dev)
 
 	tr_dbg(&ipc_tr, "ipc4_add_comp_dev add comp %x", icd->id);
 	/* add new component to the list */
-	list_item_append(&icd->list, &ipc->comp_list);
+	ipc_comp_dev_add(ipc, icd);
 
 	return IPC4_SUCCESS;
 };
@@ -172,6 +172,65 @@ static void *rmalloc_sys(struct mm_heap *heap, uint32_t flags, int caps, size_t
 	return ptr;
 }
 
+/*
+ * Block usage is kept as a bitmap of 16 bit words, one word for each 16
+ * blocks of a map. The word of blocks [n, n + 15] is stored in the header
+ * of block n, so finding a free block or the end of a free run checks 16
+ * blocks at a time instead of walking every header.
+ */
+#define BLOCK_MASK_BITS		16
+#define BLOCK_MASK_LOW		(BLOCK_MASK_BITS - 1)
+#define BLOCK_MASK_ALL		((1 << BLOCK_MASK_BITS) - 1)
+
+static inline uint32_t block_used_mask(struct block_map *map, int index)
+{
+	return map->block[index & ~BLOCK_MASK_LOW].used_mask;
+}
+
+/* mark blocks [index, index + count) as used or free */
+static void block_set_used(struct block_map *map, int index, int count, bool used)
+{
+	struct block_hdr *hdr;
+	uint32_t bits;
+	int n;
+
+	while (count > 0) {
+		n = MIN(count, BLOCK_MASK_BITS - (index & BLOCK_MASK_LOW));
+		bits = ((1 << n) - 1) << (index & BLOCK_MASK_LOW);
+		hdr = &map->block[index & ~BLOCK_MASK_LOW];
+
+		if (used)
+			hdr->used_mask |= bits;
+		else
+			hdr->used_mask &= ~bits;
+
+		index += n;
+		count -= n;
+	}
+}
+
+/* first block from index on that is used or free, map->count if none */
+static int block_find(struct block_map *map, int index, bool used)
+{
+	uint32_t word;
+
+	while (index < map->count) {
+		word = block_used_mask(map, index);
+		if (!used)
+			word = ~word & BLOCK_MASK_ALL;
+
+		word >>= index & BLOCK_MASK_LOW;
+		if (word) {
+			index += ffs(word) - 1;
+			return MIN(index, map->count);
+		}
+
+		index = (index | BLOCK_MASK_LOW) + 1;
+	}
+
+	return map->count;
+}
+
 /* At this point the pointer we have should be unaligned
  * (it was checked level higher) and be power of 2
  */
@@ -195,7 +254,6 @@ static void *alloc_block_index(struct mm_heap *heap, int level,
 	struct block_map *map = &heap->map[level];
 	struct block_hdr *hdr;
 	void *ptr;
-	int i;
 
 	if (index < 0)
 		index = map->first_free;
@@ -207,21 +265,14 @@ static void *alloc_block_index(struct mm_heap *heap, int level,
 	ptr = align_ptr(heap, alignment, ptr, hdr);
 
 	hdr->size = 1;
-	hdr->used = 1;
+	block_set_used(map, index, 1, true);
 
 	heap->info.used += map->block_size;
 	heap->info.free -= map->block_size;
 
+	/* find next free, or past the end of the map when full */
 	if (index == map->first_free)
-		/* find next free */
-		for (i = map->first_free; i < map->count; ++i) {
-			hdr = &map->block[i];
-
-			if (hdr->used == 0) {
-				map->first_free = i;
-				break;
-			}
-		}
+		map->first_free = block_find(map, index + 1, false);
 
 	return ptr;
 }
@@ -240,10 +291,11 @@ static void *alloc_cont_blocks(struct mm_heap *heap, int level,
 	struct block_hdr *hdr;
 	void *ptr = NULL, *unaligned_ptr;
 	unsigned int current;
-	unsigned int count = 0;			/* keep compiler quiet */
+	unsigned int end;
+	unsigned int count = 0;
 	unsigned int start = 0;			/* keep compiler quiet */
 	uintptr_t blk_start = 0, aligned = 0;	/* keep compiler quiet */
-	size_t found = 0, total_bytes = bytes;
+	size_t total_bytes = bytes;
 
 	/* check if we have enough consecutive blocks for requested
 	 * allocation size.
@@ -252,55 +304,46 @@ static void *alloc_cont_blocks(struct mm_heap *heap, int level,
 		return NULL;
 
 	/*
-	 * Walk all blocks in the map, beginning with the first free one, until
-	 * a sufficiently large sequence is found, in which the first block
+	 * Walk the free runs of the map, beginning with the first free block,
+	 * until one is found that is large enough from its first block that
 	 * contains an address with the requested alignment.
 	 */
-	for (current = map->first_free, hdr = map->block + current;
-	     current < map->count && found < total_bytes;
-	     current++, hdr++) {
-		if (hdr->used) {
-			/* Restart the search */
-			found = 0;
-			count = 0;
-			total_bytes = bytes;
-			continue;
-		}
+	for (current = block_find(map, map->first_free, false); current < map->count;
+	     current = block_find(map, end, false)) {
+		end = block_find(map, current, true);
 
-		if (!found) {
-			/* A possible beginning of a sequence */
-			blk_start = map->base + current * map->block_size;
-			start = current;
+		for (start = current; start < end; start++) {
+			blk_start = map->base + start * map->block_size;
 
 			/* Check if we can start a sequence here */
-			if (alignment) {
-				aligned = ALIGN_UP(blk_start, alignment);
-
-				if (blk_start & (alignment - 1) &&
-				    aligned >= blk_start + map->block_size)
-					/*
-					 * This block doesn't contain an address
-					 * with required alignment, it is useless
-					 * as the beginning of the sequence
-					 */
-					continue;
-
-				/*
-				 * Found a potentially suitable beginning of a
-				 * sequence, from here we'll check if we get
-				 * enough blocks
-				 */
-				total_bytes += aligned - blk_start;
-			} else {
+			if (!alignment) {
 				aligned = blk_start;
+				break;
 			}
+
+			aligned = ALIGN_UP(blk_start, alignment);
+
+			/*
+			 * A block that doesn't contain an address with required
+			 * alignment is useless as the beginning of the sequence
+			 */
+			if (!(blk_start & (alignment - 1)) ||
+			    aligned < blk_start + map->block_size)
+				break;
 		}
 
-		count++;
-		found += map->block_size;
+		if (start == end)
+			continue;
+
+		total_bytes = bytes + aligned - blk_start;
+		count = SOF_DIV_ROUND_UP(total_bytes, map->block_size);
+		if (start + count <= end)
+			break;
+
+		count = 0;
 	}
 
-	if (found < total_bytes) {
+	if (!count) {
 		tr_err(&mem_tr, "failed to allocate %u", total_bytes);
 		goto out;
 	}
@@ -317,23 +360,18 @@ static void *alloc_cont_blocks(struct mm_heap *heap, int level,
 	heap->info.used += count * map->block_size;
 	heap->info.free -= count * map->block_size;
 
+	block_set_used(map, start, count, true);
+
 	/*
 	 * if .first_free has to be updated, set it to first free block or past
 	 * the end of the map
 	 */
-	if (map->first_free == start) {
-		for (current = map->first_free + count, hdr = &map->block[current];
-		     current < map->count && hdr->used;
-		     current++, hdr++)
-			;
-
-		map->first_free = current;
-	}
+	if (map->first_free == start)
+		map->first_free = block_find(map, start + count, false);
 
 	/* update each block */
 	for (current = start; current < start + count; current++) {
 		hdr = &map->block[current];
-		hdr->used = 1;
 		hdr->unaligned_ptr = unaligned_ptr;
 	}
 
@@ -530,10 +568,11 @@ static void free_block(void *ptr)
 	/* free block header and continuous blocks */
 	used_blocks = block + hdr->size;
 
+	block_set_used(block_map, block, hdr->size, false);
+
 	for (i = block; i < used_blocks; i++) {
 		hdr = &block_map->block[i];
 		hdr->size = 0;
-		hdr->used = 0;
 		hdr->unaligned_ptr = NULL;
 		block_map->free_count++;
 		heap->info.used -= block_map->block_size;
@@ -824,7 +863,6 @@ static void *alloc_heap_buffer(struct mm_heap *heap, uint32_t flags,
 
 	/* will request fit in single block */
 	for (i = 0, map = heap->map; i < heap->blocks; i++, map++) {
-		struct block_hdr *hdr;
 		uintptr_t free_start;
 
 		if (map->block_size < bytes || !map->free_count)
@@ -844,15 +882,11 @@ static void *alloc_heap_buffer(struct mm_heap *heap, uint32_t flags,
 		 * For performance reasons we could first check the power-of-2
 		 * case. This can be added as an optimization later.
 		 */
-		for (j = map->first_free, hdr = map->block + j,
-		     free_start = map->base + map->block_size * j;
-		     j < map->count;
-		     j++, hdr++, free_start += map->block_size) {
+		for (j = block_find(map, map->first_free, false); j < map->count;
+		     j = block_find(map, j + 1, false)) {
 			uintptr_t aligned;
 
-			if (hdr->used)
-				continue;
-
+			free_start = map->base + map->block_size * j;
 			aligned = ALIGN_UP(free_start, alignment);
 
 			if (aligned + bytes > free_start + map->block_size)
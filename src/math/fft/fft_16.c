@@ -8,8 +8,6 @@
 #include <sof/audio/format.h>
 #include <sof/common.h>
 #include <sof/math/fft.h>
-
-#ifdef FFT_GENERIC
 #include <sof/audio/coefficients/fft/twiddle_16.h>
 
 /*
@@ -63,6 +61,17 @@ static inline void icomplex16_shift(const struct icomplex16 *input, int16_t n,
 	}
 }
 
+#ifdef FFT_GENERIC
+
+/* multiply by -j */
+static inline void icomplex16_mul_neg_j(const struct icomplex16 *in, struct icomplex16 *out)
+{
+	int16_t real = in->real;
+
+	out->real = in->imag;
+	out->imag = sat_int16(-((int32_t)real));
+}
+
 /**
  * \brief Execute the 16-bits Fast Fourier Transform (FFT) or Inverse FFT (IFFT)
  *	  For the configured fft_pan.
@@ -73,11 +82,17 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 {
 	struct icomplex16 tmp1;
 	struct icomplex16 tmp2;
+	struct icomplex16 a0;
+	struct icomplex16 a1;
+	struct icomplex16 b0;
+	struct icomplex16 b1;
 	struct icomplex16 *inb;
 	struct icomplex16 *outb;
 	int depth;
-	int top;
-	int bottom;
+	int p0;
+	int p1;
+	int p2;
+	int p3;
 	int index;
 	int i;
 	int j;
@@ -85,7 +100,7 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	int m;
 	int n;
 
-	if (!plan || !plan->bit_reverse_idx)
+	if (!plan || !plan->bit_reverse_idx || plan->real)
 		return;
 
 	inb = plan->inb16;
@@ -100,13 +115,28 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
+	for (i = 0; i < plan->size; ++i)
 		icomplex16_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
 
-	/* step 2: loop to do FFT transform in smaller size */
-	for (depth = 1; depth <= plan->len; ++depth) {
+	/* step 2: one radix-2 stage if the FFT length is an odd power of two */
+	depth = 0;
+	if (plan->len & 1) {
+		for (k = 0; k < plan->size; k += 2) {
+			tmp1 = outb[k];
+			icomplex16_add(&tmp1, &outb[k + 1], &outb[k]);
+			icomplex16_sub(&tmp1, &outb[k + 1], &outb[k + 1]);
+		}
+		depth = 1;
+	}
+
+	/*
+	 * step 3: radix-4 stages, each replaces two radix-2 stages. After the
+	 * bit reverse the four sub transforms of size n in a block of size m
+	 * are for the input samples with index 0, 2, 1 and 3 modulo 4.
+	 */
+	for (depth += 2; depth <= plan->len; depth += 2) {
 		m = 1 << depth;
-		n = m >> 1;
+		n = m >> 2;
 		i = FFT_SIZE_MAX >> depth;
 
 		/* doing FFT transforms in size m */
@@ -114,17 +144,33 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 			/* doing one FFT transform for size m */
 			for (j = 0; j < n; ++j) {
 				index = i * j;
-				top = k + j;
-				bottom = top + n;
+				p0 = k + j;
+				p1 = p0 + n;
+				p2 = p1 + n;
+				p3 = p2 + n;
+
+				/* a = p0 +/- W^2j * p1 */
+				tmp1.real = twiddle_real_16[2 * index];
+				tmp1.imag = twiddle_imag_16[2 * index];
+				icomplex16_mul(&tmp1, &outb[p1], &tmp2);
+				icomplex16_add(&outb[p0], &tmp2, &a0);
+				icomplex16_sub(&outb[p0], &tmp2, &a1);
+
+				/* b = W^j * p2 +/- W^3j * p3 */
 				tmp1.real = twiddle_real_16[index];
 				tmp1.imag = twiddle_imag_16[index];
-				/* calculate the accumulator: twiddle * bottom */
-				icomplex16_mul(&tmp1, &outb[bottom], &tmp2);
-				tmp1 = outb[top];
-				/* calculate the top output: top = top + accumulate */
-				icomplex16_add(&tmp1, &tmp2, &outb[top]);
-				/* calculate the bottom output: bottom = top - accumulate */
-				icomplex16_sub(&tmp1, &tmp2, &outb[bottom]);
+				icomplex16_mul(&tmp1, &outb[p2], &b0);
+				tmp1.real = twiddle_real_16[3 * index];
+				tmp1.imag = twiddle_imag_16[3 * index];
+				icomplex16_mul(&tmp1, &outb[p3], &tmp2);
+				icomplex16_sub(&b0, &tmp2, &b1);
+				icomplex16_add(&b0, &tmp2, &b0);
+				icomplex16_mul_neg_j(&b1, &b1);
+
+				icomplex16_add(&a0, &b0, &outb[p0]);
+				icomplex16_add(&a1, &b1, &outb[p1]);
+				icomplex16_sub(&a0, &b0, &outb[p2]);
+				icomplex16_sub(&a1, &b1, &outb[p3]);
 			}
 		}
 	}
@@ -141,3 +187,66 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 }
 #endif
+
+/**
+ * \brief Execute the 16-bits FFT for a real input plan.
+ *	  The packed input is transformed with a half length complex FFT, the
+ *	  even and odd sample spectra E and O are then separated from it and
+ *	  combined as X[k] = E[k] + W^k * O[k] into size / 2 + 1 output bins.
+ * \param[in] plan - pointer to fft_plan from fft_plan_new_real().
+ */
+void fft_execute_real_16(struct fft_plan *plan)
+{
+	struct fft_plan half;
+	struct icomplex16 *outb;
+	struct icomplex16 even;
+	struct icomplex16 odd;
+	struct icomplex16 tw;
+	struct icomplex16 tmp;
+	struct icomplex16 a;
+	struct icomplex16 b;
+	int index;
+	int k;
+	int m;
+
+	if (!plan || !plan->real || !plan->inb16 || !plan->outb16)
+		return;
+
+	/* the packed samples are a complex sequence of half length */
+	half = *plan;
+	half.size = plan->size >> 1;
+	half.len = plan->len - 1;
+	half.real = false;
+	fft_execute_16(&half, false);
+
+	/* the extra halving keeps the 1/N scale of the full length FFT */
+	outb = plan->outb16;
+	m = half.size;
+	a = outb[0];
+	outb[0].real = ((int32_t)a.real + a.imag + 1) >> 1;
+	outb[0].imag = 0;
+	outb[m].real = ((int32_t)a.real - a.imag + 1) >> 1;
+	outb[m].imag = 0;
+
+	index = FFT_SIZE_MAX >> plan->len;
+	for (k = 1; k <= m >> 1; k++) {
+		a = outb[k];
+		b = outb[m - k];
+
+		/* E = (Z[k] + conj(Z[m - k])) / 2, O = -j * (Z[k] - conj(Z[m - k])) / 2 */
+		even.real = ((int32_t)a.real + b.real + 1) >> 1;
+		even.imag = ((int32_t)a.imag - b.imag + 1) >> 1;
+		odd.real = ((int32_t)a.imag + b.imag + 1) >> 1;
+		odd.imag = ((int32_t)b.real - a.real + 1) >> 1;
+
+		tw.real = twiddle_real_16[index * k];
+		tw.imag = twiddle_imag_16[index * k];
+		icomplex16_mul(&tw, &odd, &tmp);
+
+		/* X[k] = E + W^k * O, X[m - k] = conj(E - W^k * O) */
+		outb[k].real = ((int32_t)even.real + tmp.real + 1) >> 1;
+		outb[k].imag = ((int32_t)even.imag + tmp.imag + 1) >> 1;
+		outb[m - k].real = ((int32_t)even.real - tmp.real + 1) >> 1;
+		outb[m - k].imag = ((int32_t)tmp.imag - even.imag + 1) >> 1;
+	}
+}
@@ -9,8 +9,6 @@
 #include <sof/common.h>
 #include <rtos/alloc.h>
 #include <sof/math/fft.h>
-
-#ifdef FFT_GENERIC
 #include <sof/audio/coefficients/fft/twiddle_32.h>
 
 /*
@@ -36,8 +34,11 @@ static inline void icomplex32_sub(const struct icomplex32 *in1, const struct ico
 static inline void icomplex32_mul(const struct icomplex32 *in1, const struct icomplex32 *in2,
 				  struct icomplex32 *out)
 {
-	out->real = ((int64_t)in1->real * in2->real - (int64_t)in1->imag * in2->imag) >> 31;
-	out->imag = ((int64_t)in1->real * in2->imag + (int64_t)in1->imag * in2->real) >> 31;
+	int64_t real = (int64_t)in1->real * in2->real - (int64_t)in1->imag * in2->imag;
+	int64_t imag = (int64_t)in1->real * in2->imag + (int64_t)in1->imag * in2->real;
+
+	out->real = Q_SHIFT_RND(real, 62, 31);
+	out->imag = Q_SHIFT_RND(imag, 62, 31);
 }
 
 /* complex conjugate */
@@ -60,6 +61,17 @@ static inline void icomplex32_shift(const struct icomplex32 *input, int32_t n,
 	}
 }
 
+#ifdef FFT_GENERIC
+
+/* multiply by -j */
+static inline void icomplex32_mul_neg_j(const struct icomplex32 *in, struct icomplex32 *out)
+{
+	int32_t real = in->real;
+
+	out->real = in->imag;
+	out->imag = -real;
+}
+
 /**
  * \brief Execute the 32-bits Fast Fourier Transform (FFT) or Inverse FFT (IFFT)
  *	  For the configured fft_pan.
@@ -70,11 +82,17 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 {
 	struct icomplex32 tmp1;
 	struct icomplex32 tmp2;
+	struct icomplex32 a0;
+	struct icomplex32 a1;
+	struct icomplex32 b0;
+	struct icomplex32 b1;
 	struct icomplex32 *inb;
 	struct icomplex32 *outb;
 	int depth;
-	int top;
-	int bottom;
+	int p0;
+	int p1;
+	int p2;
+	int p3;
 	int index;
 	int i;
 	int j;
@@ -82,7 +100,7 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	int m;
 	int n;
 
-	if (!plan || !plan->bit_reverse_idx)
+	if (!plan || !plan->bit_reverse_idx || plan->real)
 		return;
 
 	inb = plan->inb32;
@@ -97,13 +115,28 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
+	for (i = 0; i < plan->size; ++i)
 		icomplex32_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
 
-	/* step 2: loop to do FFT transform in smaller size */
-	for (depth = 1; depth <= plan->len; ++depth) {
+	/* step 2: one radix-2 stage if the FFT length is an odd power of two */
+	depth = 0;
+	if (plan->len & 1) {
+		for (k = 0; k < plan->size; k += 2) {
+			tmp1 = outb[k];
+			icomplex32_add(&tmp1, &outb[k + 1], &outb[k]);
+			icomplex32_sub(&tmp1, &outb[k + 1], &outb[k + 1]);
+		}
+		depth = 1;
+	}
+
+	/*
+	 * step 3: radix-4 stages, each replaces two radix-2 stages. After the
+	 * bit reverse the four sub transforms of size n in a block of size m
+	 * are for the input samples with index 0, 2, 1 and 3 modulo 4.
+	 */
+	for (depth += 2; depth <= plan->len; depth += 2) {
 		m = 1 << depth;
-		n = m >> 1;
+		n = m >> 2;
 		i = FFT_SIZE_MAX >> depth;
 
 		/* doing FFT transforms in size m */
@@ -111,17 +144,33 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 			/* doing one FFT transform for size m */
 			for (j = 0; j < n; ++j) {
 				index = i * j;
-				top = k + j;
-				bottom = top + n;
+				p0 = k + j;
+				p1 = p0 + n;
+				p2 = p1 + n;
+				p3 = p2 + n;
+
+				/* a = p0 +/- W^2j * p1 */
+				tmp1.real = twiddle_real_32[2 * index];
+				tmp1.imag = twiddle_imag_32[2 * index];
+				icomplex32_mul(&tmp1, &outb[p1], &tmp2);
+				icomplex32_add(&outb[p0], &tmp2, &a0);
+				icomplex32_sub(&outb[p0], &tmp2, &a1);
+
+				/* b = W^j * p2 +/- W^3j * p3 */
 				tmp1.real = twiddle_real_32[index];
 				tmp1.imag = twiddle_imag_32[index];
-				/* calculate the accumulator: twiddle * bottom */
-				icomplex32_mul(&tmp1, &outb[bottom], &tmp2);
-				tmp1 = outb[top];
-				/* calculate the top output: top = top + accumulate */
-				icomplex32_add(&tmp1, &tmp2, &outb[top]);
-				/* calculate the bottom output: bottom = top - accumulate */
-				icomplex32_sub(&tmp1, &tmp2, &outb[bottom]);
+				icomplex32_mul(&tmp1, &outb[p2], &b0);
+				tmp1.real = twiddle_real_32[3 * index];
+				tmp1.imag = twiddle_imag_32[3 * index];
+				icomplex32_mul(&tmp1, &outb[p3], &tmp2);
+				icomplex32_sub(&b0, &tmp2, &b1);
+				icomplex32_add(&b0, &tmp2, &b0);
+				icomplex32_mul_neg_j(&b1, &b1);
+
+				icomplex32_add(&a0, &b0, &outb[p0]);
+				icomplex32_add(&a1, &b1, &outb[p1]);
+				icomplex32_sub(&a0, &b0, &outb[p2]);
+				icomplex32_sub(&a1, &b1, &outb[p3]);
 			}
 		}
 	}
@@ -139,3 +188,66 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 }
 
 #endif
+
+/**
+ * \brief Execute the 32-bits FFT for a real input plan.
+ *	  The packed input is transformed with a half length complex FFT, the
+ *	  even and odd sample spectra E and O are then separated from it and
+ *	  combined as X[k] = E[k] + W^k * O[k] into size / 2 + 1 output bins.
+ * \param[in] plan - pointer to fft_plan from fft_plan_new_real().
+ */
+void fft_execute_real_32(struct fft_plan *plan)
+{
+	struct fft_plan half;
+	struct icomplex32 *outb;
+	struct icomplex32 even;
+	struct icomplex32 odd;
+	struct icomplex32 tw;
+	struct icomplex32 tmp;
+	struct icomplex32 a;
+	struct icomplex32 b;
+	int index;
+	int k;
+	int m;
+
+	if (!plan || !plan->real || !plan->inb32 || !plan->outb32)
+		return;
+
+	/* the packed samples are a complex sequence of half length */
+	half = *plan;
+	half.size = plan->size >> 1;
+	half.len = plan->len - 1;
+	half.real = false;
+	fft_execute_32(&half, false);
+
+	/* the extra halving keeps the 1/N scale of the full length FFT */
+	outb = plan->outb32;
+	m = half.size;
+	a = outb[0];
+	outb[0].real = ((int64_t)a.real + a.imag) >> 1;
+	outb[0].imag = 0;
+	outb[m].real = ((int64_t)a.real - a.imag) >> 1;
+	outb[m].imag = 0;
+
+	index = FFT_SIZE_MAX >> plan->len;
+	for (k = 1; k <= m >> 1; k++) {
+		a = outb[k];
+		b = outb[m - k];
+
+		/* E = (Z[k] + conj(Z[m - k])) / 2, O = -j * (Z[k] - conj(Z[m - k])) / 2 */
+		even.real = ((int64_t)a.real + b.real) >> 1;
+		even.imag = ((int64_t)a.imag - b.imag) >> 1;
+		odd.real = ((int64_t)a.imag + b.imag) >> 1;
+		odd.imag = ((int64_t)b.real - a.real) >> 1;
+
+		tw.real = twiddle_real_32[index * k];
+		tw.imag = twiddle_imag_32[index * k];
+		icomplex32_mul(&tw, &odd, &tmp);
+
+		/* X[k] = E + W^k * O, X[m - k] = conj(E - W^k * O) */
+		outb[k].real = ((int64_t)even.real + tmp.real) >> 1;
+		outb[k].imag = ((int64_t)even.imag + tmp.imag) >> 1;
+		outb[m - k].real = ((int64_t)even.real - tmp.real) >> 1;
+		outb[m - k].imag = ((int64_t)tmp.imag - even.imag) >> 1;
+	}
+}
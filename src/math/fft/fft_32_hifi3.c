@@ -10,7 +10,6 @@
 #include <sof/math/fft.h>
 
 #ifdef FFT_HIFI3
-#include <sof/audio/coefficients/fft/twiddle_32.h>
 #include <xtensa/tie/xt_hifi3.h>
 
 void fft_execute_32(struct fft_plan *plan, bool ifft)
@@ -33,13 +32,13 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	int size = plan->size;
 	int len = plan->len;
 
-	if (!plan || !plan->bit_reverse_idx)
+	if (!plan || !plan->bit_reverse_idx || plan->real)
 		return;
 
 	if (!plan->inb32 || !plan->outb32)
 		return;
 
-	inx = (ae_int32x2 *)plan->inb32 + 1;
+	inx = (ae_int32x2 *)plan->inb32;
 	outx = (ae_int32x2 *)plan->outb32;
 
 	/* convert to complex conjugate for ifft */
@@ -54,7 +53,7 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
 	inu = AE_LA64_PP(inx);
-	for (i = 1; i < size; ++i) {
+	for (i = 0; i < size; ++i) {
 		AE_LA32X2_IP(sample, inu, inx);
 		sample = AE_SRAA32S(sample, len);
 		out = &outx[plan->bit_reverse_idx[i]];
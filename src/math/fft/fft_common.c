@@ -11,7 +11,8 @@
 #include <rtos/alloc.h>
 #include <sof/math/fft.h>
 
-struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
+static struct fft_plan *fft_plan_init(void *inb, void *outb, uint32_t size, int bits,
+				      bool real)
 {
 	struct fft_plan *plan;
 	int lim = 1;
@@ -47,22 +48,44 @@ struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
 
 	plan->size = lim;
 	plan->len = len;
+	plan->real = real;
+
+	/* real input is transformed with a half length complex FFT */
+	if (real) {
+		if (len < 2 || lim > FFT_SIZE_MAX) {
+			rfree(plan);
+			return NULL;
+		}
+
+		lim >>= 1;
+		len--;
+	}
 
 	plan->bit_reverse_idx = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-					plan->size * sizeof(uint16_t));
+					lim * sizeof(uint16_t));
 	if (!plan->bit_reverse_idx) {
 		rfree(plan);
 		return NULL;
 	}
 
 	/* set up the bit reverse index */
-	for (i = 1; i < plan->size; ++i)
+	for (i = 1; i < lim; ++i)
 		plan->bit_reverse_idx[i] = (plan->bit_reverse_idx[i >> 1] >> 1) |
 					   ((i & 1) << (len - 1));
 
 	return plan;
 }
 
+struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
+{
+	return fft_plan_init(inb, outb, size, bits, false);
+}
+
+struct fft_plan *fft_plan_new_real(void *inb, void *outb, uint32_t size, int bits)
+{
+	return fft_plan_init(inb, outb, size, bits, true);
+}
+
 void fft_plan_free(struct fft_plan *plan)
 {
 	if (!plan)
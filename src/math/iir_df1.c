@@ -50,3 +50,56 @@ void iir_reset_df1(struct iir_state_df1 *iir)
 	 * omitting setting iir->delay to NULL.
 	 */
 }
+
+/*
+ * Size of interleaved coefficients and delay lines for running the channels
+ * in lockstep. The channels count must be even and all channels need the
+ * same biquads structure, otherwise -EINVAL is returned.
+ */
+int iir_multi_size_df1(struct iir_state_df1 *iir, int nch)
+{
+	int i;
+
+	if (nch < 2 || nch > IIR_DF1_MULTI_MAX_CH || nch & 1)
+		return -EINVAL;
+
+	for (i = 0; i < nch; i++) {
+		if (!iir[i].biquads || iir[i].biquads != iir[0].biquads ||
+		    iir[i].biquads_in_series != iir[0].biquads_in_series)
+			return -EINVAL;
+	}
+
+	return (SOF_EQ_IIR_NBIQUAD + IIR_DF1_NUM_STATE) * iir[0].biquads * nch *
+		sizeof(int32_t);
+}
+
+/*
+ * Copy the per channel coefficients to interleaved order. The data size is
+ * given by iir_multi_size_df1() and it must be cleared by caller.
+ */
+void iir_init_multi_df1(struct iir_multi_state_df1 *multi, struct iir_state_df1 *iir,
+			int nch, int32_t *data)
+{
+	int num_coef = SOF_EQ_IIR_NBIQUAD * iir[0].biquads;
+	int ch;
+	int i;
+
+	multi->channels = nch;
+	multi->biquads = iir[0].biquads;
+	multi->biquads_in_series = iir[0].biquads_in_series;
+	multi->coef = data;
+	multi->delay = data + num_coef * nch;
+
+	for (i = 0; i < num_coef; i++)
+		for (ch = 0; ch < nch; ch++)
+			multi->coef[i * nch + ch] = iir[ch].coef[i];
+}
+
+void iir_reset_multi_df1(struct iir_multi_state_df1 *multi)
+{
+	multi->channels = 0;
+	multi->biquads = 0;
+	multi->biquads_in_series = 0;
+	multi->coef = NULL;
+	multi->delay = NULL;
+}
@@ -106,4 +106,75 @@ int32_t iir_df1(struct iir_state_df1 *iir, int32_t x)
 	return sat_int32(out);
 }
 
+/* Multi-channel DF1 IIR, channels in lockstep for one frame in x[] */
+
+void iir_df1_multi(struct iir_multi_state_df1 *multi, int32_t *x)
+{
+	int64_t out[IIR_DF1_MULTI_MAX_CH];
+	int32_t in[IIR_DF1_MULTI_MAX_CH];
+	int32_t *coefp = multi->coef;
+	int32_t *delay = multi->delay;
+	int32_t *a2, *a1, *b2, *b1, *b0, *shift, *gain;
+	int32_t *y2, *y1, *x2, *x1;
+	int32_t tmp;
+	int64_t acc;
+	int nch = multi->channels;
+	int nseries = multi->biquads_in_series;
+	int ch;
+	int i;
+	int j;
+
+	for (ch = 0; ch < nch; ch++)
+		out[ch] = 0;
+
+	/* Same computation as in iir_df1() with each coefficient and delay
+	 * a vector of channels. The inner loop over channels has no
+	 * dependencies between iterations.
+	 */
+	for (j = 0; j < multi->biquads; j += nseries) {
+		for (ch = 0; ch < nch; ch++)
+			in[ch] = x[ch];
+
+		for (i = 0; i < nseries; i++) {
+			a2 = coefp;
+			a1 = a2 + nch;
+			b2 = a1 + nch;
+			b1 = b2 + nch;
+			b0 = b1 + nch;
+			shift = b0 + nch;
+			gain = shift + nch;
+			y2 = delay;
+			y1 = y2 + nch;
+			x2 = y1 + nch;
+			x1 = x2 + nch;
+			for (ch = 0; ch < nch; ch++) {
+				acc = ((int64_t)a2[ch]) * y2[ch];
+				acc += ((int64_t)a1[ch]) * y1[ch];
+				acc += ((int64_t)b2[ch]) * x2[ch];
+				acc += ((int64_t)b1[ch]) * x1[ch];
+				acc += ((int64_t)b0[ch]) * in[ch];
+				tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+
+				y2[ch] = y1[ch];
+				y1[ch] = tmp;
+				x2[ch] = x1[ch];
+				x1[ch] = in[ch];
+
+				acc = ((int64_t)gain[ch]) * tmp;
+				acc = Q_SHIFT_RND(acc, 45 + shift[ch], 31);
+				in[ch] = sat_int32(acc);
+			}
+
+			coefp += SOF_EQ_IIR_NBIQUAD * nch;
+			delay += IIR_DF1_NUM_STATE * nch;
+		}
+
+		for (ch = 0; ch < nch; ch++)
+			out[ch] += (int64_t)in[ch];
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		x[ch] = sat_int32(out[ch]);
+}
+
 #endif
@@ -122,4 +122,94 @@ int32_t iir_df1(struct iir_state_df1 *iir, int32_t x)
 	return out;
 }
 
+/* Multi-channel DF1 IIR, channels in lockstep for one frame in x[]. The
+ * interleaved coefficients and delays of a channels pair are loaded with
+ * one 64 bit load, the high word is the even channel.
+ */
+
+void iir_df1_multi(struct iir_multi_state_df1 *multi, int32_t *x)
+{
+	ae_int32x2 out[IIR_DF1_MULTI_MAX_CH / 2];
+	ae_int32x2 in[IIR_DF1_MULTI_MAX_CH / 2];
+	ae_int64 acc_h;
+	ae_int64 acc_l;
+	ae_int32x2 a2, a1, b2, b1, b0, shift, gain;
+	ae_int32x2 y2, y1, x2, x1;
+	ae_int32x2 tmp;
+	ae_int32x2 *xp = (ae_int32x2 *)x;
+	ae_int32x2 *coefp;
+	ae_int32x2 *delayp;
+	int32_t *coef = multi->coef;
+	int32_t *delay = multi->delay;
+	int npairs = multi->channels >> 1;
+	int nch = multi->channels;
+	int nseries = multi->biquads_in_series;
+	int p;
+	int i;
+	int j;
+
+	for (p = 0; p < npairs; p++)
+		out[p] = AE_ZERO32();
+
+	for (j = 0; j < multi->biquads; j += nseries) {
+		for (p = 0; p < npairs; p++)
+			in[p] = xp[p];
+
+		for (i = 0; i < nseries; i++) {
+			for (p = 0; p < npairs; p++) {
+				coefp = (ae_int32x2 *)(coef + 2 * p);
+				delayp = (ae_int32x2 *)(delay + 2 * p);
+				a2 = coefp[0];
+				a1 = coefp[npairs];
+				b2 = coefp[2 * npairs];
+				b1 = coefp[3 * npairs];
+				b0 = coefp[4 * npairs];
+				shift = coefp[5 * npairs];
+				gain = coefp[6 * npairs];
+				y2 = delayp[0];
+				y1 = delayp[npairs];
+				x2 = delayp[2 * npairs];
+				x1 = delayp[3 * npairs];
+
+				/* Same operations as in iir_df1() for both channels */
+				acc_h = AE_MULF32R_HH(a2, y2);
+				AE_MULAF32R_HH(acc_h, a1, y1);
+				AE_MULAF32R_HH(acc_h, b2, x2);
+				AE_MULAF32R_HH(acc_h, b1, x1);
+				AE_MULAF32R_HH(acc_h, b0, in[p]);
+				acc_l = AE_MULF32R_LL(a2, y2);
+				AE_MULAF32R_LL(acc_l, a1, y1);
+				AE_MULAF32R_LL(acc_l, b2, x2);
+				AE_MULAF32R_LL(acc_l, b1, x1);
+				AE_MULAF32R_LL(acc_l, b0, in[p]);
+				acc_h = AE_SLAI64S(acc_h, 1);
+				acc_l = AE_SLAI64S(acc_l, 1);
+				tmp = AE_ROUND32X2F48SSYM(acc_h, acc_l);
+
+				delayp[0] = y1;
+				delayp[npairs] = tmp;
+				delayp[2 * npairs] = x1;
+				delayp[3 * npairs] = in[p];
+
+				acc_h = AE_MULF32R_HH(gain, tmp);
+				acc_l = AE_MULF32R_LL(gain, tmp);
+				acc_h = AE_SLAI64S(acc_h, 17);
+				acc_l = AE_SLAI64S(acc_l, 17);
+				acc_h = AE_SRAA64(acc_h, AE_MOVAD32_H(shift));
+				acc_l = AE_SRAA64(acc_l, AE_MOVAD32_L(shift));
+				in[p] = AE_ROUND32X2F48SSYM(acc_h, acc_l);
+			}
+
+			coef += SOF_EQ_IIR_NBIQUAD * nch;
+			delay += IIR_DF1_NUM_STATE * nch;
+		}
+
+		for (p = 0; p < npairs; p++)
+			out[p] = AE_ADD32S(out[p], in[p]);
+	}
+
+	for (p = 0; p < npairs; p++)
+		xp[p] = out[p];
+}
+
 #endif
@@ -28,6 +28,8 @@ DECLARE_SOF_UUID("ll-schedule", ll_sched_uuid, 0x77de2074, 0x828c, 0x4044,
 
 DECLARE_TR_CTX(ll_tr, SOF_UUID(ll_sched_uuid), LOG_LEVEL_INFO);
 
+STATIC_ASSERT(SCHEDULE_LL_VCORES >= CONFIG_CORE_COUNT, vcores_cover_dsp_cores);
+
 struct ll_vcore {
 	struct list_item list; /* list of tasks in priority queue */
 	pthread_mutex_t list_mutex;
@@ -38,6 +40,9 @@ struct ll_vcore {
 
 static int tick_period_us;
 
+/* tasks are run by the caller with schedule_ll_run_tick(), no LL threads */
+static bool ll_full_sync;
+
 /**
  * Implement an override of how cores defined in SOF topology
  * are mapped to host cores.
@@ -58,14 +63,65 @@ static unsigned int sof_host_core_base(void)
 	return host_core;
 }
 
-static void *ll_thread(void *data)
+/*
+ * Run all queued tasks of the virtual core once. Returns the number of
+ * tasks that were run or -ENODATA when the task list is empty.
+ */
+static int ll_run_tasks(struct ll_vcore *vc)
 {
-	struct ll_vcore *vc = data;
-	struct timespec ts, td0, td1;
+	struct timespec td0, td1;
 	struct list_item *tlist, *tlist_;
 	struct task *task;
-	int err;
 	uint64_t delta;
+	int count = 0;
+
+	/* LL time slice now running at this point */
+	pthread_mutex_lock(&vc->list_mutex);
+
+	/* list empty then return */
+	if (list_is_empty(&vc->list)) {
+		pthread_mutex_unlock(&vc->list_mutex);
+		return -ENODATA;
+	}
+
+	/* iterate through the task list */
+	list_for_item_safe(tlist, tlist_, &vc->list) {
+		task = container_of(tlist, struct task, list);
+
+		/* only run queued tasks */
+		if (task->state == SOF_TASK_STATE_QUEUED) {
+			task->state = SOF_TASK_STATE_RUNNING;
+			pthread_mutex_unlock(&vc->list_mutex);
+
+			/* run task and time it */
+			clock_gettime(CLOCK_MONOTONIC, &td0);
+			task->ops.run(task->data);
+			clock_gettime(CLOCK_MONOTONIC, &td1);
+
+			pthread_mutex_lock(&vc->list_mutex);
+
+			/* only re-queue if not cancelled */
+			if (task->state == SOF_TASK_STATE_RUNNING)
+				task->state = SOF_TASK_STATE_QUEUED;
+
+			/* Calculate average task exec time */
+			delta = (td1.tv_sec - td0.tv_sec) * 1000000;
+			delta += (td1.tv_nsec - td0.tv_nsec) / 1000;
+			task->start += delta;
+			count++;
+		}
+	}
+
+	pthread_mutex_unlock(&vc->list_mutex);
+
+	return count;
+}
+
+static void *ll_thread(void *data)
+{
+	struct ll_vcore *vc = data;
+	struct timespec ts;
+	int err;
 	cpu_set_t cpuset;
 	pthread_t thread;
 
@@ -107,44 +163,10 @@ static void *ll_thread(void *data)
 			}
 		}
 
-		/* LL time slice now running at this point */
-		pthread_mutex_lock(&vc->list_mutex);
-
-		/* list empty then return */
-		if (list_is_empty(&vc->list)) {
-			pthread_mutex_unlock(&vc->list_mutex);
+		if (ll_run_tasks(vc) == -ENODATA) {
 			fprintf(stdout, "LL scheduler thread exit - list empty\n");
 			break;
 		}
-
-		/* iterate through the task list */
-		list_for_item_safe(tlist, tlist_, &vc->list) {
-			task = container_of(tlist, struct task, list);
-
-			/* only run queued tasks */
-			if (task->state == SOF_TASK_STATE_QUEUED) {
-				task->state = SOF_TASK_STATE_RUNNING;
-				pthread_mutex_unlock(&vc->list_mutex);
-
-				/* run task and time it */
-				clock_gettime(CLOCK_MONOTONIC, &td0);
-				task->ops.run(task->data);
-				clock_gettime(CLOCK_MONOTONIC, &td1);
-
-				pthread_mutex_lock(&vc->list_mutex);
-
-				/* only re-queue if not cancelled */
-				if (task->state == SOF_TASK_STATE_RUNNING)
-					task->state = SOF_TASK_STATE_QUEUED;
-
-				/* Calculate average task exec time */
-				delta = (td1.tv_sec - td0.tv_sec) * 1000000;
-				delta += (td1.tv_nsec - td0.tv_nsec) / 1000;
-				task->start += delta;
-			}
-		}
-
-		pthread_mutex_unlock(&vc->list_mutex);
 	}
 
 out:
@@ -157,7 +179,7 @@ out:
 static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			    uint64_t period)
 {
-	struct ll_vcore *vc = data;
+	struct ll_vcore *vc = (struct ll_vcore *)data + task->core;
 	pthread_attr_t attr;
 	struct sched_param param;
 	int err;
@@ -172,6 +194,10 @@ static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 	task->start = 0;
 	pthread_mutex_unlock(&vc->list_mutex);
 
+	/* tasks are ticked by the caller in full synchronous mode */
+	if (ll_full_sync)
+		return 0;
+
 	/* is vcore thread running ? */
 	if (!vc->vcore_ready) {
 		/* do we have elevated privileges to attempt RT priority */
@@ -210,7 +236,7 @@ static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 create:
 		/* nope, so start thread for this virtual core */
 		err = pthread_create(&vc->thread_id, valid_attr ? &attr : NULL,
-				     ll_thread, &vc[task->core]);
+				     ll_thread, vc);
 		if (err < 0) {
 			fprintf(stderr, "error: failed to create LL thread for vcore %d %s\n",
 				task->core, strerror(err));
@@ -231,7 +257,7 @@ static void ll_scheduler_free(void *data, uint32_t flags)
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_cancel(void *data, struct task *task)
 {
-	struct ll_vcore *vc = data;
+	struct ll_vcore *vc = (struct ll_vcore *)data + task->core;
 
 	pthread_mutex_lock(&vc->list_mutex);
 	/* delete task */
@@ -239,7 +265,7 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 	list_item_del(&task->list);
 
 	/* list empty then return */
-	if (list_is_empty(&vc->list)) {
+	if (list_is_empty(&vc->list) && !ll_full_sync) {
 		pthread_mutex_unlock(&vc->list_mutex);
 		pthread_join(vc->thread_id, NULL);
 	} else {
@@ -252,14 +278,14 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_free(void *data, struct task *task)
 {
-	struct ll_vcore *vc = data;
+	struct ll_vcore *vc = (struct ll_vcore *)data + task->core;
 
 	pthread_mutex_lock(&vc->list_mutex);
 	task->state = SOF_TASK_STATE_FREE;
 	list_item_del(&task->list);
 
 	/* list empty then return */
-	if (list_is_empty(&vc->list)) {
+	if (list_is_empty(&vc->list) && !ll_full_sync) {
 		pthread_mutex_unlock(&vc->list_mutex);
 		pthread_join(vc->thread_id, NULL);
 	} else {
@@ -287,6 +313,17 @@ int schedule_task_init_ll(struct task *task,
 				  data, core, flags);
 }
 
+/* run one LL tick on the virtual core, used in full synchronous mode */
+int schedule_ll_run_tick(int core)
+{
+	struct ll_vcore *vcore = scheduler_get_data(SOF_SCHEDULE_LL_TIMER);
+
+	if (!vcore || core < 0 || core >= SCHEDULE_LL_VCORES)
+		return -EINVAL;
+
+	return ll_run_tasks(&vcore[core]);
+}
+
 /* initialize scheduler */
 int scheduler_init_ll(struct ll_schedule_domain *domain)
 {
@@ -295,14 +332,15 @@ int scheduler_init_ll(struct ll_schedule_domain *domain)
 
 	tr_info(&ll_tr, "ll_scheduler_init()");
 	tick_period_us = domain->next_tick;
+	ll_full_sync = domain->full_sync;
 
-	vcore = calloc(sizeof(*vcore), CONFIG_CORE_COUNT);
+	vcore = calloc(sizeof(*vcore), SCHEDULE_LL_VCORES);
 	if (!vcore)
 		return -ENOMEM;
 
 	core_zero = sof_host_core_base();
 
-	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+	for (i = 0; i < SCHEDULE_LL_VCORES; i++) {
 		list_init(&vcore[i].list);
 		vcore[i].core_id = core_zero + i;
 	}
@@ -500,61 +500,6 @@ int probe_dma_remove(uint32_t count, const uint32_t *stream_tag)
 	return 0;
 }
 
-/**
- * \brief Copy data to probe buffer and update buffer pointers.
- * \param[out] pbuf DMA buffer.
- * \param[in] data pointer.
- * \param[in] bytes size.
- * \return 0 on success, error code otherwise.
- */
-static int copy_to_pbuffer(struct probe_dma_buf *pbuf, void *data,
-			   uint32_t bytes)
-{
-	uint32_t head;
-	uint32_t tail;
-
-	if (bytes == 0)
-		return 0;
-
-	/* check if there is free room in probe buffer */
-	if (pbuf->size - pbuf->avail < bytes)
-		return -EINVAL;
-
-	/* check if it will not exceed end_addr */
-	if ((char *)pbuf->end_addr - (char *)pbuf->w_ptr < bytes) {
-		head = (char *)pbuf->end_addr - (char *)pbuf->w_ptr;
-		tail = bytes - head;
-	} else {
-		head = bytes;
-		tail = 0;
-	}
-
-	/* copy data to probe buffer */
-	if (memcpy_s((void *)pbuf->w_ptr, pbuf->end_addr - pbuf->w_ptr, data, head)) {
-		tr_err(&pr_tr, "copy_to_pbuffer(): memcpy_s() failed");
-		return -EINVAL;
-	}
-	dcache_writeback_region((__sparse_force void __sparse_cache *)pbuf->w_ptr, head);
-
-	/* buffer ended so needs to do a second copy */
-	if (tail) {
-		pbuf->w_ptr = pbuf->addr;
-		if (memcpy_s((void *)pbuf->w_ptr, (char *)pbuf->end_addr - (char *)pbuf->w_ptr,
-			     (char *)data + head, tail)) {
-			tr_err(&pr_tr, "copy_to_pbuffer(): memcpy_s() failed");
-			return -EINVAL;
-		}
-		dcache_writeback_region((__sparse_force void __sparse_cache *)pbuf->w_ptr, tail);
-		pbuf->w_ptr = pbuf->w_ptr + tail;
-	} else {
-		pbuf->w_ptr = pbuf->w_ptr + head;
-	}
-
-	pbuf->avail = (uintptr_t)pbuf->avail + bytes;
-
-	return 0;
-}
-
 /**
  * \brief Copy data from probe buffer and update buffer pointers.
  * \param[out] pbuf DMA buffer.
@@ -613,22 +558,49 @@ static int copy_from_pbuffer(struct probe_dma_buf *pbuf, void *data,
 }
 
 /**
- * \brief Generate probe data packet header, update timestamp, calc crc
- *	  and copy data to probe buffer.
+ * \brief Write data to probe buffer and update write pointer.
+ *	  Free room has to be checked and cache written back by the caller.
+ * \param[out] pbuf DMA buffer.
+ * \param[in] data pointer.
+ * \param[in] bytes size.
+ * \return 0 on success, error code otherwise.
+ */
+static int pbuffer_write(struct probe_dma_buf *pbuf, const void *data,
+			 uint32_t bytes)
+{
+	uint32_t head = MIN(bytes, pbuf->end_addr - pbuf->w_ptr);
+	uint32_t tail = bytes - head;
+
+	if (head && memcpy_s((void *)pbuf->w_ptr, pbuf->end_addr - pbuf->w_ptr, data, head))
+		return -EINVAL;
+
+	pbuf->w_ptr += head;
+	if (pbuf->w_ptr >= pbuf->end_addr)
+		pbuf->w_ptr = pbuf->addr;
+
+	/* buffer ended so needs to do a second copy */
+	if (tail) {
+		if (memcpy_s((void *)pbuf->w_ptr, pbuf->size, (const char *)data + head, tail))
+			return -EINVAL;
+		pbuf->w_ptr += tail;
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Generate probe data packet header, update timestamp and calc crc.
+ * \param[out] header data packet header.
  * \param[in] buffer_id component buffer id
  * \param[in] size data size.
  * \param[in] format audio format.
- * \param[out] checksum.
- * \return 0 on success, error code otherwise.
+ * \return checksum of the packet.
  */
-static int probe_gen_header(uint32_t buffer_id, uint32_t size,
-			    uint32_t format, uint64_t *checksum)
+static uint64_t probe_gen_header(struct probe_data_packet *header, uint32_t buffer_id,
+				 uint32_t size, uint32_t format)
 {
-	struct probe_pdata *_probe = probe_get();
-	struct probe_data_packet *header;
 	uint64_t timestamp;
 
-	header = &_probe->header;
 	timestamp = sof_cycle_get_64();
 
 	header->sync_word = PROBE_EXTRACT_SYNC_WORD;
@@ -639,17 +611,76 @@ static int probe_gen_header(uint32_t buffer_id, uint32_t size,
 	header->data_size_bytes = size;
 
 	/* calc checksum to check validation by probe parse app */
-	*checksum = header->sync_word +
-		    header->buffer_id  +
-		    header->format +
-		    header->timestamp_high +
-		    header->timestamp_low +
-		    header->data_size_bytes;
+	return header->sync_word +
+	       header->buffer_id  +
+	       header->format +
+	       header->timestamp_high +
+	       header->timestamp_low +
+	       header->data_size_bytes;
+}
+
+/**
+ * \brief Copy complete data packet to extraction probe buffer.
+ *
+ * Header, data split into head and tail and checksum are written in one go,
+ * free room is checked once for the whole packet so the host never sees a
+ * truncated packet and the cache is written back once per packet. Packets
+ * of many produces are then sent to host in one DMA copy by probe_task().
+ *
+ * \param[in] buffer_id component buffer id
+ * \param[in] format audio format.
+ * \param[in] head first part of data.
+ * \param[in] head_bytes size of first part.
+ * \param[in] tail second part of data, after the source buffer wrap.
+ * \param[in] tail_bytes size of second part.
+ * \return 0 on success, error code otherwise.
+ */
+static int probe_write_packet(uint32_t buffer_id, uint32_t format,
+			      const void *head, uint32_t head_bytes,
+			      const void *tail, uint32_t tail_bytes)
+{
+	struct probe_pdata *_probe = probe_get();
+	struct probe_dma_buf *pbuf = &_probe->ext_dma.dmapb;
+	uint32_t packet_bytes;
+	uint32_t first_bytes;
+	uintptr_t start;
+	uint64_t checksum;
+	int ret;
 
-	dcache_writeback_region((__sparse_force void __sparse_cache *)header, sizeof(*header));
+	packet_bytes = sizeof(struct probe_data_packet) + head_bytes + tail_bytes +
+		       sizeof(checksum);
+
+	/* check if there is free room in probe buffer */
+	if (pbuf->size - pbuf->avail < packet_bytes)
+		return -EINVAL;
+
+	checksum = probe_gen_header(&_probe->header, buffer_id,
+				    head_bytes + tail_bytes, format);
+
+	start = pbuf->w_ptr;
+	ret = pbuffer_write(pbuf, &_probe->header, sizeof(struct probe_data_packet));
+	if (!ret)
+		ret = pbuffer_write(pbuf, head, head_bytes);
+	if (!ret)
+		ret = pbuffer_write(pbuf, tail, tail_bytes);
+	if (!ret)
+		ret = pbuffer_write(pbuf, &checksum, sizeof(checksum));
+	if (ret < 0) {
+		tr_err(&pr_tr, "probe_write_packet(): memcpy_s() failed");
+		pbuf->w_ptr = start;
+		return ret;
+	}
 
-	return copy_to_pbuffer(&_probe->ext_dma.dmapb, header,
-			       sizeof(struct probe_data_packet));
+	/* write back the packet, at most two regions */
+	first_bytes = MIN(packet_bytes, pbuf->end_addr - start);
+	dcache_writeback_region((__sparse_force void __sparse_cache *)start, first_bytes);
+	if (packet_bytes > first_bytes)
+		dcache_writeback_region((__sparse_force void __sparse_cache *)pbuf->addr,
+					packet_bytes - first_bytes);
+
+	pbuf->avail += packet_bytes;
+
+	return 0;
 }
 
 /**
@@ -769,20 +800,9 @@ static void kick_probe_task(struct probe_pdata *_probe)
 static void probe_logging_hook(uint8_t *buffer, size_t length)
 {
 	struct probe_pdata *_probe = probe_get();
-	uint64_t checksum;
 	int ret;
 
-	ret = probe_gen_header(PROBE_LOGGING_BUFFER_ID, length, 0, &checksum);
-	if (ret < 0)
-		return;
-
-	ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-			      buffer, length);
-	if (ret < 0)
-		return;
-
-	ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-			      &checksum, sizeof(checksum));
+	ret = probe_write_packet(PROBE_LOGGING_BUFFER_ID, 0, buffer, length, NULL, 0);
 	if (ret < 0)
 		return;
 
@@ -792,11 +812,11 @@ static void probe_logging_hook(uint8_t *buffer, size_t length)
 
 /**
  * \brief General extraction probe callback, called from buffer produce.
- *	  It will search for probe point connected to this buffer.
+ *	  Probe point connected to this buffer is the notification receiver.
  *	  Extraction probe: generate format, header and copy data to probe buffer.
  *	  Injection probe: find corresponding DMA, check avail data, copy data,
  *	  update pointers and request more data from host if needed.
- * \param[in] arg pointer (not used).
+ * \param[in] arg buffer id of the probe point.
  * \param[in] type of notify.
  * \param[in] data pointer.
  */
@@ -805,38 +825,30 @@ static void probe_cb_produce(void *arg, enum notify_id type, void *data)
 	struct probe_pdata *_probe = probe_get();
 	struct buffer_cb_transact *cb_data = data;
 	struct comp_buffer __sparse_cache *buffer = cb_data->buffer;
+	struct probe_point *probe_point;
 	struct probe_dma_ext *dma;
 	uint32_t buffer_id;
 	uint32_t head, tail;
 	uint32_t free_bytes = 0;
 	int32_t copy_bytes = 0;
 	int ret;
-	uint32_t i, j;
+	uint32_t j;
 	uint32_t format;
-	uint64_t checksum;
 
-	buffer_id = *(int *)arg;
+	/* probe point connected to this buffer is registered as receiver */
+	probe_point = container_of(arg, struct probe_point, buffer_id.full_id);
+	buffer_id = probe_point->buffer_id.full_id;
 
-	/* search for probe point connected to this buffer */
-	for (i = 0; i < CONFIG_PROBE_POINTS_MAX; i++)
-		if (_probe->probe_points[i].buffer_id.full_id == buffer_id)
-			break;
-
-	if (i == CONFIG_PROBE_POINTS_MAX) {
+	if (probe_point->stream_tag == PROBE_POINT_INVALID) {
 		tr_err(&pr_tr, "probe_cb_produce(): probe not found for buffer id: %d",
 		       buffer_id);
 		return;
 	}
 
-	if (_probe->probe_points[i].purpose == PROBE_PURPOSE_EXTRACTION) {
+	if (probe_point->purpose == PROBE_PURPOSE_EXTRACTION) {
 		format = probe_gen_format(buffer->stream.frame_fmt,
 					  buffer->stream.rate,
 					  buffer->stream.channels);
-		ret = probe_gen_header(buffer_id,
-				       cb_data->transaction_amount,
-				       format, &checksum);
-		if (ret < 0)
-			goto err;
 
 		/* check if transaction amount exceeds component buffer end addr */
 		/* if yes: divide copying into two stages, head and tail */
@@ -845,26 +857,14 @@ static void probe_cb_produce(void *arg, enum notify_id type, void *data)
 			head = (uintptr_t)buffer->stream.end_addr -
 			       (uintptr_t)cb_data->transaction_begin_address;
 			tail = (uintptr_t)cb_data->transaction_amount - head;
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      head);
-			if (ret < 0)
-				goto err;
-
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      buffer->stream.addr, tail);
-			if (ret < 0)
-				goto err;
 		} else {
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      cb_data->transaction_amount);
-			if (ret < 0)
-				goto err;
+			head = cb_data->transaction_amount;
+			tail = 0;
 		}
 
-		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-				      &checksum, sizeof(checksum));
+		ret = probe_write_packet(buffer_id, format,
+					 cb_data->transaction_begin_address, head,
+					 buffer->stream.addr, tail);
 		if (ret < 0)
 			goto err;
 
@@ -875,7 +875,7 @@ static void probe_cb_produce(void *arg, enum notify_id type, void *data)
 			if (_probe->inject_dma[j].stream_tag !=
 			    PROBE_DMA_INVALID &&
 			    _probe->inject_dma[j].stream_tag ==
-			    _probe->probe_points[i].stream_tag) {
+			    probe_point->stream_tag) {
 				break;
 			}
 		}
@@ -1333,9 +1333,10 @@ int probe_point_remove(uint32_t count, const uint32_t *buffer_id)
 #else
 				dev = ipc_get_comp_by_id(ipc_get(), buffer_id[i]);
 				if (dev) {
-					notifier_unregister(_probe, dev->cb,
+					notifier_unregister(&buf_id->full_id, dev->cb,
 							    NOTIFIER_ID_BUFFER_PRODUCE);
-					notifier_unregister(_probe, dev->cb, NOTIFIER_ID_BUFFER_FREE);
+					notifier_unregister(&buf_id->full_id, dev->cb,
+							    NOTIFIER_ID_BUFFER_FREE);
 				}
 #endif
 				_probe->probe_points[j].stream_tag =
@@ -10,6 +10,7 @@
 #endif
 #include <rtos/spinlock.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #if CONFIG_DEBUG_LOCKS
@@ -22,6 +23,10 @@ DECLARE_TR_CTX(sl_tr, SOF_UUID(spinlock_uuid), LOG_LEVEL_INFO);
 
 #endif
 
+#if CONFIG_LIBRARY
+bool arch_spinlock_smp;
+#endif
+
 #ifndef __ZEPHYR__
 k_spinlock_key_t _k_spin_lock_irq(struct k_spinlock *lock)
 {
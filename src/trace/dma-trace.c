@@ -10,6 +10,7 @@
 #include <sof/ipc/msg.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
+#include <rtos/interrupt.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/dma.h>
 #include <sof/lib/memory.h>
@@ -48,10 +49,146 @@ DECLARE_TR_CTX(dt_tr, SOF_UUID(dma_trace_uuid), LOG_LEVEL_INFO);
 DECLARE_SOF_UUID("dma-trace-task", dma_trace_task_uuid, 0x2b972272, 0xc5b1,
 		 0x4b7e, 0x92, 0x6f, 0x0f, 0xc5, 0xcb, 0x4c, 0x46, 0x90);
 
+#define DMA_TRACE_RECORD_WRAP	0xFFFFFFFF
+
+/** Entry header in the per core ring, entries never wrap. The ring end is
+ * skipped when it is marked with DMA_TRACE_RECORD_WRAP or too short for a
+ * header.
+ */
+struct dma_trace_record {
+	uint64_t timestamp;	/* entry time, for merging the cores */
+	uint32_t size;		/* entry size in bytes */
+	uint32_t reserved;
+};
+
+STATIC_ASSERT(!(DMA_TRACE_CORE_SIZE & (DMA_TRACE_CORE_SIZE - 1)),
+	      dma_trace_core_size_not_power_of_two);
+
 static int dma_trace_get_avail_data(struct dma_trace_data *d,
 				    struct dma_trace_buf *buffer,
 				    int avail);
 
+static inline uint32_t dtrace_record_size(uint32_t length)
+{
+	return sizeof(struct dma_trace_record) + ALIGN_UP(length, sizeof(uint64_t));
+}
+
+/** Returns the oldest entry of a core ring or NULL when the ring is empty */
+static struct dma_trace_record *dtrace_core_peek(struct dma_trace_core *core)
+{
+	struct dma_trace_record *record;
+	uint32_t offset;
+	uint32_t margin;
+
+	while (core->r_pos != core->w_pos) {
+		offset = core->r_pos & (DMA_TRACE_CORE_SIZE - 1);
+		margin = DMA_TRACE_CORE_SIZE - offset;
+		record = (struct dma_trace_record *)((char *)core->addr + offset);
+
+		if (margin >= sizeof(*record) && record->size != DMA_TRACE_RECORD_WRAP)
+			return record;
+
+		/* ring end skipped by the writer */
+		core->r_pos += margin;
+	}
+
+	return NULL;
+}
+
+/** Writes an entry to the DMA buffer, only the primary core does it */
+static int dtrace_add_event(struct dma_trace_data *d, const char *e,
+			    uint32_t length)
+{
+	struct dma_trace_buf *buffer = &d->dmatb;
+	uint32_t margin;
+	int ret;
+
+	if (buffer->size - buffer->avail < length)
+		return -ENOSPC;
+
+	margin = dtrace_calc_buf_margin(buffer);
+
+	/* check for buffer wrap */
+	if (margin > length) {
+		/* no wrap */
+		ret = memcpy_s(buffer->w_ptr, margin, e, length);
+		assert(!ret);
+		buffer->w_ptr = (char *)buffer->w_ptr + length;
+	} else {
+		/* data is bigger than remaining margin so we wrap */
+		ret = memcpy_s(buffer->w_ptr, margin, e, margin);
+		assert(!ret);
+		buffer->w_ptr = buffer->addr;
+
+		ret = memcpy_s(buffer->w_ptr, buffer->size, e + margin, length - margin);
+		assert(!ret);
+		buffer->w_ptr = (char *)buffer->w_ptr + length - margin;
+	}
+
+	buffer->avail += length;
+	d->posn.messages++;
+
+	return 0;
+}
+
+/** Moves the entries of all core rings to the DMA buffer, oldest first */
+static void dtrace_drain(struct dma_trace_data *d)
+{
+	struct dma_trace_core *oldest_core = NULL;
+	struct dma_trace_record *oldest;
+	struct dma_trace_record *record;
+	int i;
+
+	for (;;) {
+		oldest = NULL;
+		for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+			record = dtrace_core_peek(&d->core[i]);
+			if (record && (!oldest || record->timestamp < oldest->timestamp)) {
+				oldest = record;
+				oldest_core = &d->core[i];
+			}
+		}
+
+		if (!oldest)
+			return;
+
+		/* DMA buffer is full, the rest waits in the core rings */
+		if (dtrace_add_event(d, (const char *)(oldest + 1), oldest->size) < 0)
+			return;
+
+		oldest_core->r_pos += dtrace_record_size(oldest->size);
+	}
+}
+
+static void dtrace_report_dropped(struct dma_trace_data *d)
+{
+	uint32_t dropped;
+	int i;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		dropped = d->core[i].dropped_entries - d->core[i].dropped_reported;
+		if (!dropped)
+			continue;
+
+		d->core[i].dropped_reported += dropped;
+		tr_err(&dt_tr, "trace_work(): core %d number of dropped logs = %u",
+		       i, dropped);
+	}
+}
+
+/** Entries are stored to the DMA buffer through the data cache, write back
+ * the region the DMA reads before the transfer.
+ */
+static void dtrace_writeback(struct dma_trace_buf *buffer, uint32_t size)
+{
+	uint32_t head = MIN(size, (char *)buffer->end_addr - (char *)buffer->r_ptr);
+
+	dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->r_ptr, head);
+	if (size > head)
+		dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->addr,
+					size - head);
+}
+
 /** Periodically runs and starts the DMA even when the buffer is not
  * full.
  */
@@ -61,16 +198,26 @@ static enum task_state trace_work(void *data)
 	struct dma_trace_buf *buffer = &d->dmatb;
 	struct dma_sg_config *config = &d->config;
 	k_spinlock_key_t key;
-	uint32_t avail = buffer->avail;
-	int32_t size;
+	uint32_t avail;
+	int32_t size = 0;
 	uint32_t overflow;
 
 	/* The host DMA channel is not available */
 	if (!d->dc.chan)
 		return SOF_TASK_STATE_RESCHEDULE;
 
+	/* DMA trace copying is working */
+	d->copy_in_progress = 1;
+
+	/* collect entries of all cores, including the dropped logs report */
+	dtrace_report_dropped(d);
+	key = k_spin_lock(&d->lock);
+	dtrace_drain(d);
+	k_spin_unlock(&d->lock, key);
+
+	avail = buffer->avail;
 	if (!ipc_trigger_trace_xfer(avail))
-		return SOF_TASK_STATE_RESCHEDULE;
+		goto out;
 
 	/* make sure we don't write more than buffer */
 	if (avail > DMA_TRACE_LOCAL_SIZE) {
@@ -86,14 +233,12 @@ static enum task_state trace_work(void *data)
 	size = dma_trace_get_avail_data(d, buffer, avail);
 
 	/* any data to copy ? */
-	if (size == 0) {
-		return SOF_TASK_STATE_RESCHEDULE;
-	}
+	if (size == 0)
+		goto out;
 
 	d->posn.overflow = overflow;
 
-	/* DMA trace copying is working */
-	d->copy_in_progress = 1;
+	dtrace_writeback(buffer, size);
 
 	/* copy this section to host */
 	size = dma_copy_to_host(&d->dc, config, d->posn.host_offset,
@@ -237,14 +382,21 @@ int dma_trace_host_buffer(struct dma_trace_data *d,
 static void dma_trace_buffer_free(struct dma_trace_data *d)
 {
 	struct dma_trace_buf *buffer = &d->dmatb;
+	void *core_buf = d->core[0].addr;
 	k_spinlock_key_t key;
+	int i;
 
 	key = k_spin_lock(&d->lock);
 
 	rfree(buffer->addr);
 	memset(buffer, 0, sizeof(*buffer));
 
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		d->core[i].addr = NULL;
+
 	k_spin_unlock(&d->lock, key);
+
+	rfree(core_buf);
 }
 
 static int dma_trace_buffer_init(struct dma_trace_data *d)
@@ -256,9 +408,11 @@ static int dma_trace_buffer_init(struct dma_trace_data *d)
 #endif
 	struct dma_trace_buf *buffer = &d->dmatb;
 	void *buf;
+	char *core_buf;
 	k_spinlock_key_t key;
 	uint32_t addr_align;
 	int err;
+	int i;
 
 	/*
 	 * Keep the existing dtrace buffer to avoid memory leak, unlikely to
@@ -297,9 +451,24 @@ static int dma_trace_buffer_init(struct dma_trace_data *d)
 	bzero(buf, DMA_TRACE_LOCAL_SIZE);
 	dcache_writeback_region((__sparse_force void __sparse_cache *)buf, DMA_TRACE_LOCAL_SIZE);
 
+	/* core rings are shared with the primary core, keep them coherent */
+	core_buf = rballoc(SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
+			   CONFIG_CORE_COUNT * DMA_TRACE_CORE_SIZE);
+	if (!core_buf) {
+		mtrace_printf(LOG_LEVEL_ERROR, "dma_trace_buffer_init(): core alloc failed");
+		rfree(buf);
+		return -ENOMEM;
+	}
+
 	/* initialise the DMA buffer, whole sequence in section */
 	key = k_spin_lock(&d->lock);
 
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		d->core[i].addr = core_buf + i * DMA_TRACE_CORE_SIZE;
+		d->core[i].w_pos = 0;
+		d->core[i].r_pos = 0;
+	}
+
 	buffer->addr  = buf;
 	buffer->size = DMA_TRACE_LOCAL_SIZE;
 	buffer->w_ptr = buffer->addr;
@@ -530,14 +699,22 @@ void dma_trace_flush(void *t)
 {
 	struct dma_trace_data *trace_data = dma_trace_data_get();
 	struct dma_trace_buf *buffer = NULL;
+	k_spinlock_key_t key;
 	uint32_t avail;
 	int32_t size;
 	int32_t wrap_count;
 	int ret;
 
-	if (!dma_trace_initialized(trace_data))
+	/* only the primary core writes the DMA buffer */
+	if (!dma_trace_initialized(trace_data) ||
+	    cpu_get_id() != PLATFORM_PRIMARY_CORE_ID)
 		return;
 
+	/* newest entries may still wait in the core rings */
+	key = k_spin_lock(&trace_data->lock);
+	dtrace_drain(trace_data);
+	k_spin_unlock(&trace_data->lock, key);
+
 	buffer = &trace_data->dmatb;
 	avail = buffer->avail;
 
@@ -610,135 +787,89 @@ void dma_trace_off(void)
 
 }
 
-static int dtrace_calc_buf_overflow(struct dma_trace_buf *buffer,
-				    uint32_t length)
+/** Per core ring write, drops on overflow. Lock free between the cores,
+ * interrupts are only masked against the same core.
+ */
+static void dtrace_core_add_event(struct dma_trace_core *core, const char *e,
+				  uint32_t length)
 {
-	uint32_t margin;
-	uint32_t overflow_margin;
-	uint32_t overflow = 0;
-
-	margin = dtrace_calc_buf_margin(buffer);
+	struct dma_trace_record *record;
+	uint32_t record_size = dtrace_record_size(length);
+	uint32_t offset;
+	uint32_t skip = 0;
+	uint32_t flags;
+	int ret;
 
-	/* overflow calculating */
-	if (buffer->w_ptr < buffer->r_ptr)
-		overflow_margin = (char *)buffer->r_ptr -
-			(char *)buffer->w_ptr - 1;
-	else
-		overflow_margin = margin + (char *)buffer->r_ptr -
-			(char *)buffer->addr - 1;
+	irq_local_disable(flags);
 
-	if (overflow_margin < length)
-		overflow = length - overflow_margin;
+	offset = core->w_pos & (DMA_TRACE_CORE_SIZE - 1);
 
-	return overflow;
-}
+	/* entries don't wrap, skip the ring end if it is too short */
+	if (DMA_TRACE_CORE_SIZE - offset < record_size)
+		skip = DMA_TRACE_CORE_SIZE - offset;
 
-/** Ring buffer implementation, drops on overflow. */
-static void dtrace_add_event(const char *e, uint32_t length)
-{
-	struct dma_trace_data *trace_data = dma_trace_data_get();
-	struct dma_trace_buf *buffer = &trace_data->dmatb;
-	uint32_t margin;
-	uint32_t overflow;
-	int ret;
+	if (core->w_pos - core->r_pos + skip + record_size > DMA_TRACE_CORE_SIZE) {
+		/* if there is not enough memory for new log, we drop it */
+		core->dropped_entries++;
+		irq_local_enable(flags);
+		return;
+	}
 
-	margin = dtrace_calc_buf_margin(buffer);
-	overflow = dtrace_calc_buf_overflow(buffer, length);
-
-	/* tracing dropped entries */
-	if (trace_data->dropped_entries) {
-		if (!overflow) {
-			/*
-			 * if any dropped entries have appeared and there
-			 * is not any overflow, their amount will be logged
-			 */
-			uint32_t tmp_dropped_entries =
-				trace_data->dropped_entries;
-			trace_data->dropped_entries = 0;
-			/*
-			 * this trace_error invocation causes recursion,
-			 * so after it we have to recalculate margin and
-			 * overflow
-			 */
-			tr_err(&dt_tr, "dtrace_add_event(): number of dropped logs = %u",
-			       tmp_dropped_entries);
-			margin = dtrace_calc_buf_margin(buffer);
-			overflow = dtrace_calc_buf_overflow(buffer, length);
-		}
+	if (skip) {
+		record = (struct dma_trace_record *)((char *)core->addr + offset);
+		if (skip >= sizeof(*record))
+			record->size = DMA_TRACE_RECORD_WRAP;
+		offset = 0;
 	}
 
-	/* checking overflow */
-	if (!overflow) {
-		/* check for buffer wrap */
-		if (margin > length) {
-			/* no wrap */
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 length);
-			ret = memcpy_s(buffer->w_ptr, length, e, length);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						length);
-			buffer->w_ptr = (char *)buffer->w_ptr + length;
-		} else {
-			/* data is bigger than remaining margin so we wrap */
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 margin);
-			ret = memcpy_s(buffer->w_ptr, margin, e, margin);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						margin);
-			buffer->w_ptr = buffer->addr;
-
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 length - margin);
-			ret = memcpy_s(buffer->w_ptr, length - margin,
-				       e + margin, length - margin);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						length - margin);
-			buffer->w_ptr = (char *)buffer->w_ptr + length - margin;
-		}
+	record = (struct dma_trace_record *)((char *)core->addr + offset);
+	record->timestamp = sof_cycle_get_64_safe();
+	record->size = length;
+	ret = memcpy_s(record + 1, DMA_TRACE_CORE_SIZE - offset - sizeof(*record),
+		       e, length);
+	assert(!ret);
 
-		buffer->avail += length;
-		trace_data->posn.messages++;
-	} else {
-		/* if there is not enough memory for new log, we drop it */
-		trace_data->dropped_entries++;
-	}
+	/* publish the entry to trace_work() */
+	core->w_pos += skip + record_size;
 
+	irq_local_enable(flags);
+}
+
+/** Fill of the fullest core ring */
+static uint32_t dtrace_core_max_avail(struct dma_trace_data *d)
+{
+	uint32_t max_avail = 0;
+	int i;
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		max_avail = MAX(max_avail, d->core[i].w_pos - d->core[i].r_pos);
+
+	return max_avail;
 }
 
 /** Main dma-trace entry point */
 void dtrace_event(const char *e, uint32_t length)
 {
 	struct dma_trace_data *trace_data = dma_trace_data_get();
-	struct dma_trace_buf *buffer = NULL;
-	k_spinlock_key_t key;
 
 	if (!dma_trace_initialized(trace_data) ||
 	    length > DMA_TRACE_LOCAL_SIZE / 8 || length == 0) {
 		return;
 	}
 
-	buffer = &trace_data->dmatb;
-
-	key = k_spin_lock(&trace_data->lock);
-	dtrace_add_event(e, length);
+	dtrace_core_add_event(&trace_data->core[cpu_get_id()], e, length);
 
 	/* if DMA trace copying is working or secondary core
 	 * don't check if local buffer is half full
 	 */
 	if (trace_data->copy_in_progress ||
-	    cpu_get_id() != PLATFORM_PRIMARY_CORE_ID) {
-		k_spin_unlock(&trace_data->lock, key);
+	    cpu_get_id() != PLATFORM_PRIMARY_CORE_ID)
 		return;
-	}
-
-	k_spin_unlock(&trace_data->lock, key);
 
 	/* schedule copy now if buffer > 50% full */
 	if (trace_data->enabled &&
-	    buffer->avail >= (DMA_TRACE_LOCAL_SIZE / 2)) {
+	    (trace_data->dmatb.avail >= DMA_TRACE_LOCAL_SIZE / 2 ||
+	     dtrace_core_max_avail(trace_data) >= DMA_TRACE_CORE_SIZE / 2)) {
 		reschedule_task(&trace_data->dmat_work,
 				DMA_TRACE_RESCHEDULE_TIME);
 		/* reschedule should not be interrupted
@@ -746,7 +877,6 @@ void dtrace_event(const char *e, uint32_t length)
 		 */
 		trace_data->copy_in_progress = 1;
 	}
-
 }
 
 void dtrace_event_atomic(const char *e, uint32_t length)
@@ -758,5 +888,5 @@ void dtrace_event_atomic(const char *e, uint32_t length)
 		return;
 	}
 
-	dtrace_add_event(e, length);
+	dtrace_core_add_event(&trace_data->core[cpu_get_id()], e, length);
 }
@@ -12,9 +12,11 @@
 #include <rtos/timer.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
+#include <rtos/interrupt.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/mailbox.h>
 #include <sof/lib/memory.h>
+#include <sof/list.h>
 #include <sof/platform.h>
 #include <rtos/string.h>
 #include <rtos/sof.h>
@@ -38,10 +40,19 @@ struct recent_log_entry {
 	uint64_t message_ts;
 	uint64_t first_suppression_ts;
 	uint32_t trigger_count;
+	struct list_item list;	/* in LRU list when tracked, in free list otherwise */
 };
 
+/* hash table of at least twice the entries count, a power of two */
+#define RECENT_HASH_BITS	(33 - clz(CONFIG_TRACE_RECENT_ENTRIES_COUNT))
+#define RECENT_HASH_SIZE	(1 << RECENT_HASH_BITS)
+
 struct recent_trace_context {
 	struct recent_log_entry recent_entries[CONFIG_TRACE_RECENT_ENTRIES_COUNT];
+	/* open addressed, linear probing, recent_entries index + 1, 0 if empty */
+	uint16_t hash[RECENT_HASH_SIZE];
+	struct list_item lru;	/* tracked entries, the most recently seen first */
+	struct list_item free;	/* not tracked entries */
 };
 #endif /* CONFIG_TRACE_FILTERING_ADAPTIVE */
 
@@ -132,15 +143,115 @@ static inline bool trace_filter_verbosity(uint32_t lvl, const struct tr_ctx *ctx
 #endif /* CONFIG_TRACE_FILTERING_VERBOSITY */
 
 #if CONFIG_TRACE_FILTERING_ADAPTIVE
+static void recent_init(struct recent_trace_context *ctx)
+{
+	int i;
+
+	list_init(&ctx->lru);
+	list_init(&ctx->free);
+
+	for (i = 0; i < CONFIG_TRACE_RECENT_ENTRIES_COUNT; i++)
+		list_item_append(&ctx->recent_entries[i].list, &ctx->free);
+}
+
+static inline uint32_t recent_hash(uint32_t entry_id)
+{
+	/* Fibonacci hashing, entry ids are addresses in the dictionary */
+	return (entry_id * 2654435769u) >> (32 - RECENT_HASH_BITS);
+}
+
+static struct recent_log_entry *recent_find(struct recent_trace_context *ctx,
+					    uint32_t entry_id)
+{
+	struct recent_log_entry *entry;
+	uint32_t i;
+
+	for (i = recent_hash(entry_id); ctx->hash[i]; i = (i + 1) & (RECENT_HASH_SIZE - 1)) {
+		entry = &ctx->recent_entries[ctx->hash[i] - 1];
+		if (entry->entry_id == entry_id)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/** Stop tracking the entry and return it to the free list */
+static void recent_release(struct recent_trace_context *ctx,
+			   struct recent_log_entry *entry)
+{
+	uint16_t slot = entry - ctx->recent_entries + 1;
+	uint32_t i = recent_hash(entry->entry_id);
+	uint32_t j;
+	uint32_t k;
+
+	while (ctx->hash[i] != slot)
+		i = (i + 1) & (RECENT_HASH_SIZE - 1);
+
+	/* delete with backward shift, keeps probe chains without tombstones */
+	for (j = i;;) {
+		j = (j + 1) & (RECENT_HASH_SIZE - 1);
+		if (!ctx->hash[j])
+			break;
+
+		/* entry can't move before its home slot k, cyclically in (i, j] */
+		k = recent_hash(ctx->recent_entries[ctx->hash[j] - 1].entry_id);
+		if (i <= j ? i < k && k <= j : i < k || k <= j)
+			continue;
+
+		ctx->hash[i] = ctx->hash[j];
+		i = j;
+	}
+	ctx->hash[i] = 0;
+
+	memset(entry, 0, offsetof(struct recent_log_entry, list));
+	list_item_del(&entry->list);
+	list_item_append(&entry->list, &ctx->free);
+}
+
 /** Report how many times an entry was suppressed and clear it. */
-static void emit_suppressed_entry(struct recent_log_entry *entry)
+static void emit_suppressed_entry(struct recent_trace_context *ctx,
+				  struct recent_log_entry *entry)
 {
 	_log_message(trace_log_unfiltered, false, LOG_LEVEL_INFO, _TRACE_INV_CLASS, &dt_tr,
 		     _TRACE_INV_ID, _TRACE_INV_ID, "Suppressed %u similar messages: %pQ",
 		     entry->trigger_count - CONFIG_TRACE_BURST_COUNT,
 		     (void *)entry->entry_id);
 
-	memset(entry, 0, sizeof(*entry));
+	recent_release(ctx, entry);
+}
+
+/** Report the entry if it was suppressed and clear it. */
+static void recent_close(struct recent_trace_context *ctx,
+			 struct recent_log_entry *entry)
+{
+	if (entry->trigger_count > CONFIG_TRACE_BURST_COUNT)
+		emit_suppressed_entry(ctx, entry);
+	else
+		recent_release(ctx, entry);
+}
+
+/** Start tracking a new entry, evicting the least recently seen one if full */
+static struct recent_log_entry *recent_add(struct recent_trace_context *ctx,
+					   uint32_t entry_id)
+{
+	struct recent_log_entry *entry;
+	uint32_t i;
+
+	/* Make room for tracking new entry, by emitting the oldest one in the filter */
+	if (list_is_empty(&ctx->free))
+		recent_close(ctx, list_item(ctx->lru.prev, struct recent_log_entry, list));
+
+	entry = list_first_item(&ctx->free, struct recent_log_entry, list);
+	entry->entry_id = entry_id;
+
+	for (i = recent_hash(entry_id); ctx->hash[i]; i = (i + 1) & (RECENT_HASH_SIZE - 1))
+		;
+	ctx->hash[i] = entry - ctx->recent_entries + 1;
+
+	list_item_del(&entry->list);
+	list_item_prepend(&entry->list, &ctx->lru);
+
+	return entry;
 }
 
 /** Flush entries that have not been seen again in the last
@@ -149,23 +260,17 @@ static void emit_suppressed_entry(struct recent_log_entry *entry)
 static void emit_recent_entries(uint64_t current_ts)
 {
 	struct trace *trace = trace_get();
-	struct recent_log_entry *recent_entries =
-		trace->trace_core_context[cpu_get_id()].recent_entries;
-	int i;
+	struct recent_trace_context *ctx = &trace->trace_core_context[cpu_get_id()];
+	struct recent_log_entry *entry;
 
-	/* Check if any tracked entries were dormant long enough to unsuppress them */
-	for (i = 0; i < CONFIG_TRACE_RECENT_ENTRIES_COUNT; i++) {
-		if (recent_entries[i].entry_id) {
-			if (current_ts - recent_entries[i].message_ts >
-			    CONFIG_TRACE_RECENT_TIME_THRESHOLD) {
-				if (recent_entries[i].trigger_count > CONFIG_TRACE_BURST_COUNT)
-					emit_suppressed_entry(&recent_entries[i]);
-				else
-					memset(&recent_entries[i], 0, sizeof(recent_entries[i]));
-			}
-		}
-	}
+	/* The LRU list is sorted by the last seen time, dormant entries are at its tail */
+	while (!list_is_empty(&ctx->lru)) {
+		entry = list_item(ctx->lru.prev, struct recent_log_entry, list);
+		if (current_ts - entry->message_ts <= CONFIG_TRACE_RECENT_TIME_THRESHOLD)
+			break;
 
+		recent_close(ctx, entry);
+	}
 }
 
 /**
@@ -178,58 +283,46 @@ static void emit_recent_entries(uint64_t current_ts)
 static bool trace_filter_flood(uint32_t log_level, uint32_t entry, uint64_t message_ts)
 {
 	struct trace *trace = trace_get();
-	struct recent_log_entry *recent_entries =
-		trace->trace_core_context[cpu_get_id()].recent_entries;
-	struct recent_log_entry *oldest_entry = recent_entries;
-	int i;
+	struct recent_trace_context *ctx = &trace->trace_core_context[cpu_get_id()];
+	struct recent_log_entry *recent_entry;
 
 	/* don't attempt to suppress debug messages using this method, it would be uneffective */
 	if (log_level >= LOG_LEVEL_DEBUG)
 		return true;
 
 	/* check if same log entry was sent recently */
-	for (i = 0; i < CONFIG_TRACE_RECENT_ENTRIES_COUNT; i++) {
-		/* Identify the oldest (or empty) entry to evict if we have no match  */
-		if (oldest_entry->first_suppression_ts > recent_entries[i].first_suppression_ts)
-			oldest_entry = &recent_entries[i];
-
-		if (recent_entries[i].entry_id == entry) {
-			/* We have a match but include this message in this burst only if the
-			 * burst:
-			   - 1. hasn't lasted for too long;
-			   - 2. hasn't been quiet for too long.
-			 */
-			if (message_ts - recent_entries[i].first_suppression_ts <
-			    CONFIG_TRACE_RECENT_MAX_TIME &&
-			    message_ts - recent_entries[i].message_ts <
-			    CONFIG_TRACE_RECENT_TIME_THRESHOLD) {
-				recent_entries[i].trigger_count++;
-				/* Refresh last seen time */
-				recent_entries[i].message_ts = message_ts;
-
-				/* Allow the start of a burst to be printed normally */
-				return recent_entries[i].trigger_count <= CONFIG_TRACE_BURST_COUNT;
-			}
+	recent_entry = recent_find(ctx, entry);
+	if (recent_entry) {
+		/* We have a match but include this message in this burst only if the
+		 * burst:
+		   - 1. hasn't lasted for too long;
+		   - 2. hasn't been quiet for too long.
+		 */
+		if (message_ts - recent_entry->first_suppression_ts <
+		    CONFIG_TRACE_RECENT_MAX_TIME &&
+		    message_ts - recent_entry->message_ts <
+		    CONFIG_TRACE_RECENT_TIME_THRESHOLD) {
+			recent_entry->trigger_count++;
+			/* Refresh last seen time */
+			recent_entry->message_ts = message_ts;
+			list_item_del(&recent_entry->list);
+			list_item_prepend(&recent_entry->list, &ctx->lru);
+
+			/* Allow the start of a burst to be printed normally */
+			return recent_entry->trigger_count <= CONFIG_TRACE_BURST_COUNT;
+		}
 
-			/* Emit and clear this burst */
-			if (recent_entries[i].trigger_count > CONFIG_TRACE_BURST_COUNT)
-				emit_suppressed_entry(&recent_entries[i]);
-			else
-				memset(&recent_entries[i], 0, sizeof(recent_entries[i]));
+		/* Emit and clear this burst */
+		recent_close(ctx, recent_entry);
 
-			return true;
-		}
+		return true;
 	}
 
-	/* Make room for tracking new entry, by emitting the oldest one in the filter */
-	if (oldest_entry->entry_id && oldest_entry->trigger_count > CONFIG_TRACE_BURST_COUNT)
-		emit_suppressed_entry(oldest_entry);
-
 	/* Start a new burst */
-	oldest_entry->entry_id = entry;
-	oldest_entry->message_ts = message_ts;
-	oldest_entry->first_suppression_ts = message_ts;
-	oldest_entry->trigger_count = 1;
+	recent_entry = recent_add(ctx, entry);
+	recent_entry->message_ts = message_ts;
+	recent_entry->first_suppression_ts = message_ts;
+	recent_entry->trigger_count = 1;
 
 	return true;
 }
@@ -289,10 +382,16 @@ void trace_log_filtered(bool send_atomic, const void *log_entry, const struct tr
 #if CONFIG_TRACE_FILTERING_ADAPTIVE
 	if (!trace->user_filter_override) {
 		const uint64_t current_ts = sof_cycle_get_64_safe();
+		uint32_t flags;
+		bool pass;
 
+		/* filter state is per core, only guard against interrupts */
+		irq_local_disable(flags);
 		emit_recent_entries(current_ts);
+		pass = trace_filter_flood(lvl, (uint32_t)log_entry, current_ts);
+		irq_local_enable(flags);
 
-		if (!trace_filter_flood(lvl, (uint32_t)log_entry, current_ts))
+		if (!pass)
 			return;
 	}
 #endif /* CONFIG_TRACE_FILTERING_ADAPTIVE */
@@ -499,11 +598,17 @@ void trace_off(void)
 
 void trace_init(struct sof *sof)
 {
+#if CONFIG_TRACE_FILTERING_ADAPTIVE
+	int i;
+#endif
+
 	sof->trace = rzalloc(SOF_MEM_ZONE_SYS_SHARED, 0, SOF_MEM_CAPS_RAM, sizeof(*sof->trace));
 	sof->trace->enable = 1;
 	sof->trace->pos = 0;
 #if CONFIG_TRACE_FILTERING_ADAPTIVE
 	sof->trace->user_filter_override = false;
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		recent_init(&sof->trace->trace_core_context[i]);
 #endif /* CONFIG_TRACE_FILTERING_ADAPTIVE */
 	k_spinlock_init(&sof->trace->lock);
 
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/pipeline.h>
+#include <sof/lib/notifier.h>
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#define SPSC_BUFFER_SIZE	384
+#define SPSC_RUNS		4096
+
+struct spsc_data {
+	struct comp_dev source;
+	struct comp_dev sink;
+	struct comp_buffer *buf;
+};
+
+static int setup(void **state)
+{
+	struct sof_ipc_buffer desc = {
+		.size = SPSC_BUFFER_SIZE,
+	};
+	struct spsc_data *data = calloc(1, sizeof(*data));
+
+	if (!data)
+		return -ENOMEM;
+
+	data->buf = buffer_new(&desc);
+	if (!data->buf) {
+		free(data);
+		return -ENOMEM;
+	}
+
+	data->source.ipc_config.id = 1;
+	data->sink.ipc_config.id = 2;
+	list_init(&data->source.bsource_list);
+	list_init(&data->source.bsink_list);
+	list_init(&data->sink.bsource_list);
+	list_init(&data->sink.bsink_list);
+
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct spsc_data *data = *state;
+
+	buffer_free(data->buf);
+	free(data);
+
+	return 0;
+}
+
+static void spsc_connect(struct spsc_data *data)
+{
+	pipeline_connect(&data->source, data->buf, PPL_CONN_DIR_COMP_TO_BUFFER);
+	pipeline_connect(&data->sink, data->buf, PPL_CONN_DIR_BUFFER_TO_COMP);
+}
+
+static void test_audio_buffer_spsc_connect(void **state)
+{
+	struct spsc_data *data = *state;
+
+	/* flagged only once both ends are bound */
+	pipeline_connect(&data->source, data->buf, PPL_CONN_DIR_COMP_TO_BUFFER);
+	assert_false(data->buf->spsc);
+	pipeline_connect(&data->sink, data->buf, PPL_CONN_DIR_BUFFER_TO_COMP);
+	assert_true(data->buf->spsc);
+
+	pipeline_disconnect(&data->sink, data->buf, PPL_CONN_DIR_BUFFER_TO_COMP);
+	assert_false(data->buf->spsc);
+
+	/* ends on different cores */
+	data->sink.ipc_config.core = 1;
+	pipeline_connect(&data->sink, data->buf, PPL_CONN_DIR_BUFFER_TO_COMP);
+	assert_false(data->buf->spsc);
+}
+
+/* the fast path must leave the buffer in the same state as the generic one */
+static void test_audio_buffer_spsc_positions(void **state)
+{
+	struct sof_ipc_buffer desc = {
+		.size = SPSC_BUFFER_SIZE,
+	};
+	struct spsc_data *data = *state;
+	struct comp_buffer *ref = buffer_new(&desc);
+	struct comp_buffer *buf = data->buf;
+	uint32_t bytes;
+	int i;
+
+	assert_non_null(ref);
+	spsc_connect(data);
+	assert_true(buf->spsc);
+	assert_false(ref->spsc);
+
+	srand(1);
+	for (i = 0; i < SPSC_RUNS; i++) {
+		if (rand() & 1) {
+			bytes = rand() % (audio_stream_get_free_bytes(&buf->stream) + 1);
+			comp_update_buffer_produce(buf, bytes);
+			comp_update_buffer_produce(ref, bytes);
+		} else {
+			bytes = rand() % (audio_stream_get_avail_bytes(&buf->stream) + 1);
+			comp_update_buffer_consume(buf, bytes);
+			comp_update_buffer_consume(ref, bytes);
+		}
+
+		assert_int_equal(audio_stream_get_avail_bytes(&buf->stream),
+				 audio_stream_get_avail_bytes(&ref->stream));
+		assert_int_equal(audio_stream_get_free_bytes(&buf->stream),
+				 audio_stream_get_free_bytes(&ref->stream));
+		assert_int_equal((char *)buf->stream.w_ptr - (char *)buf->stream.addr,
+				 (char *)ref->stream.w_ptr - (char *)ref->stream.addr);
+		assert_int_equal((char *)buf->stream.r_ptr - (char *)buf->stream.addr,
+				 (char *)ref->stream.r_ptr - (char *)ref->stream.addr);
+	}
+
+	/* overwrite on a full buffer takes the generic path */
+	comp_update_buffer_produce(buf, audio_stream_get_free_bytes(&buf->stream));
+	comp_update_buffer_produce(buf, 4);
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), SPSC_BUFFER_SIZE);
+	assert_ptr_equal(buf->stream.w_ptr, buf->stream.r_ptr);
+
+	buffer_free(ref);
+}
+
+static int spsc_notified;
+
+static void spsc_notify_cb(void *arg, enum notify_id type, void *data)
+{
+	struct buffer_cb_transact *cb_data = data;
+
+	spsc_notified += cb_data->transaction_amount;
+}
+
+static void test_audio_buffer_spsc_notify(void **state)
+{
+	struct spsc_data *data = *state;
+
+	spsc_connect(data);
+	spsc_notified = 0;
+
+	comp_update_buffer_produce(data->buf, 16);
+	assert_int_equal(spsc_notified, 0);
+
+	/* subscribers are still notified on the fast path */
+	assert_int_equal(notifier_register(NULL, data->buf, NOTIFIER_ID_BUFFER_PRODUCE,
+					   spsc_notify_cb, 0), 0);
+	comp_update_buffer_produce(data->buf, 16);
+	assert_int_equal(spsc_notified, 16);
+
+	notifier_unregister(NULL, data->buf, NOTIFIER_ID_BUFFER_PRODUCE);
+	comp_update_buffer_produce(data->buf, 16);
+	assert_int_equal(spsc_notified, 16);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_buffer_spsc_connect,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_spsc_positions,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_buffer_spsc_notify,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/kpb.h>
+#include <sof/common.h>
+#include <rtos/alloc.h>
+#include <ipc/topology.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <cmocka.h>
+
+#define FRAME_BYTES	8
+#define MAX_BLOCKS	4
+
+/* buffer heap of limited size, a block takes its size of the heap */
+static size_t heap_free;
+static void *blocks[MAX_BLOCKS];
+static size_t block_size[MAX_BLOCKS];
+
+void *rballoc_align(uint32_t flags, uint32_t caps, size_t bytes,
+		    uint32_t alignment)
+{
+	int i;
+
+	if (bytes > heap_free)
+		return NULL;
+
+	for (i = 0; i < MAX_BLOCKS; i++) {
+		if (!blocks[i]) {
+			blocks[i] = malloc(bytes);
+			block_size[i] = bytes;
+			heap_free -= bytes;
+			return blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+void rfree(void *ptr)
+{
+	int i;
+
+	for (i = 0; i < MAX_BLOCKS; i++) {
+		if (ptr && blocks[i] == ptr) {
+			heap_free += block_size[i];
+			blocks[i] = NULL;
+			free(ptr);
+		}
+	}
+}
+
+/* allocation times are logged in us */
+uint64_t clock_us_to_ticks(int clock, uint64_t us)
+{
+	return us;
+}
+
+static void test_kpb_alloc_largest(size_t limit, size_t max_size)
+{
+	void *block;
+	size_t size;
+
+	heap_free = limit;
+	block = kpb_alloc_largest_block(SOF_MEM_CAPS_RAM, max_size, FRAME_BYTES, &size);
+
+	/* the block is the only one left and close to the heap size */
+	assert_non_null(block);
+	assert_int_equal(heap_free, limit - size);
+	assert_true(size <= limit);
+	assert_true(size + KPB_ALLOCATION_STEP > MIN(limit, max_size));
+	assert_int_equal(size % FRAME_BYTES, 0);
+
+	rfree(block);
+	assert_int_equal(heap_free, limit);
+}
+
+static void test_kpb_alloc_largest_limited(void **state)
+{
+	test_kpb_alloc_largest(150 * 1024, 200 * 1024);
+	test_kpb_alloc_largest(150 * 1024 + 100, 200 * 1024);
+	test_kpb_alloc_largest(1000, 200 * 1024);
+}
+
+static void test_kpb_alloc_largest_fits(void **state)
+{
+	test_kpb_alloc_largest(200 * 1024, 200 * 1024);
+	test_kpb_alloc_largest(300 * 1024, 200 * 1024 + 5);
+}
+
+static void test_kpb_alloc_largest_none(void **state)
+{
+	size_t size;
+
+	heap_free = 0;
+	assert_null(kpb_alloc_largest_block(SOF_MEM_CAPS_RAM, 200 * 1024, FRAME_BYTES,
+					    &size));
+	assert_int_equal(size, 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_kpb_alloc_largest_limited),
+		cmocka_unit_test(test_kpb_alloc_largest_fits),
+		cmocka_unit_test(test_kpb_alloc_largest_none),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/component.h>
+#include <sof/audio/kpb.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <cmocka.h>
+
+/* stream buffers of STREAM_SAMPLES, the samples wrap at different offsets */
+#define STREAM_SAMPLES	16
+#define SOURCE_OFFSET	10
+#define SINK_OFFSET	5
+
+struct pack_case {
+	uint32_t valid_bits;
+	uint32_t sample_bytes;
+	const char *name;
+};
+
+#define PACK_CASE(bits, bytes) \
+	{ (bits), (bytes), "test_kpb_pack_round_trip__" #bits "_bits_in_" #bytes "_bytes" }
+
+/* stored sample sizes of 24 and 16 bit history storage */
+static const struct pack_case pack_cases[] = {
+	PACK_CASE(16, 2), PACK_CASE(20, 3), PACK_CASE(24, 3), PACK_CASE(32, 3),
+	PACK_CASE(20, 2), PACK_CASE(24, 2), PACK_CASE(32, 2),
+};
+
+/* sample with valid bits sign extended to 32 bits */
+static int32_t test_sample(uint32_t valid_bits, int i)
+{
+	int sext = 32 - valid_bits;
+	uint32_t x;
+
+	switch (i) {
+	case 0:
+		return INT32_MAX >> sext;
+	case 1:
+		return INT32_MIN >> sext;
+	default:
+		x = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+		return (int32_t)(x << sext) >> sext;
+	}
+}
+
+/* sample as restored from the stored bits, rounded and saturated */
+static int32_t test_expected(const struct pack_case *pc, int32_t x)
+{
+	int shift = pc->valid_bits - pc->sample_bytes * 8;
+	int64_t max = (1LL << (pc->sample_bytes * 8 - 1)) - 1;
+	int64_t y;
+
+	if (shift <= 0)
+		return x;
+
+	y = ((int64_t)x + (1LL << (shift - 1))) >> shift;
+	y = MIN(y, max);
+	return (int32_t)((uint32_t)y << shift);
+}
+
+static void test_kpb_pack_round_trip(void **state)
+{
+	const struct pack_case *pc = *state;
+	struct history_data hd = {
+		.valid_bits = pc->valid_bits,
+		.container_bytes = sizeof(int32_t),
+		.sample_bytes = pc->sample_bytes,
+	};
+	struct audio_stream source;
+	struct audio_stream sink;
+	int32_t source_buf[STREAM_SAMPLES];
+	int32_t sink_buf[STREAM_SAMPLES];
+	uint8_t hb[STREAM_SAMPLES * 3];
+	int32_t *x;
+	int32_t *y;
+	int i;
+
+	audio_stream_init(&source, source_buf, sizeof(source_buf));
+	audio_stream_init(&sink, sink_buf, sizeof(sink_buf));
+	source.r_ptr = source_buf + SOURCE_OFFSET;
+	sink.w_ptr = sink_buf + SINK_OFFSET;
+
+	for (i = 0; i < STREAM_SAMPLES; i++)
+		source_buf[(SOURCE_OFFSET + i) % STREAM_SAMPLES] = test_sample(pc->valid_bits, i);
+
+	kpb_pack_32b(&source, 0, hb, STREAM_SAMPLES, &hd);
+	kpb_unpack_32b(hb, &sink, STREAM_SAMPLES, &hd);
+
+	for (i = 0; i < STREAM_SAMPLES; i++) {
+		x = &source_buf[(SOURCE_OFFSET + i) % STREAM_SAMPLES];
+		y = &sink_buf[(SINK_OFFSET + i) % STREAM_SAMPLES];
+		assert_int_equal(*y, test_expected(pc, *x));
+	}
+}
+
+int main(void)
+{
+	struct CMUnitTest tests[ARRAY_SIZE(pack_cases)];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(pack_cases); i++) {
+		tests[i].name = pack_cases[i].name;
+		tests[i].test_func = test_kpb_pack_round_trip;
+		tests[i].setup_func = NULL;
+		tests[i].teardown_func = NULL;
+		tests[i].initial_state = (void *)&pack_cases[i];
+	}
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <stdint.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component.h>
+#include <sof/audio/pipeline.h>
+#include <sof/audio/ipc-config.h>
+#include "pipeline_mocks.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdlib.h>
+
+#define PIPELINE_ID		1
+#define PIPELINE_ID_OTHER	2
+
+/* components of the test graph */
+enum {
+	COMP_S, COMP_A, COMP_B, COMP_C, COMP_D, COMP_X, COMP_NUM
+};
+
+#define BUFFER_NUM	6
+
+/*
+ * S -> A -> B -> D
+ *      A -> C -> D
+ *      A -> X (other pipeline)
+ */
+static const int graph[BUFFER_NUM][2] = {
+	{COMP_S, COMP_A},
+	{COMP_A, COMP_B},
+	{COMP_A, COMP_C},
+	{COMP_B, COMP_D},
+	{COMP_C, COMP_D},
+	{COMP_A, COMP_X},
+};
+
+#define MAX_COPIES	64
+
+struct copy_sched_data {
+	struct pipeline p;
+	struct comp_dev comp[COMP_NUM];
+	struct comp_buffer buffer[BUFFER_NUM];
+	int copies[MAX_COPIES];
+	int num_copies;
+	int stop_id;	/* component returning PPL_STATUS_PATH_STOP */
+};
+
+static struct copy_sched_data *test_data;
+
+static int mock_copy(struct comp_dev *dev)
+{
+	if (test_data->num_copies < MAX_COPIES)
+		test_data->copies[test_data->num_copies++] = dev_comp_id(dev);
+
+	return dev_comp_id(dev) == test_data->stop_id ? PPL_STATUS_PATH_STOP : 0;
+}
+
+static const struct comp_driver mock_drv = {
+	.ops = {
+		.copy = mock_copy,
+	},
+};
+
+static int setup(void **state)
+{
+	struct copy_sched_data *data = calloc(1, sizeof(*data));
+	struct comp_dev *dev;
+	int i;
+
+	if (!data)
+		return -ENOMEM;
+
+	data->p.pipeline_id = PIPELINE_ID;
+	data->p.status = COMP_STATE_ACTIVE;
+	data->p.source_comp = &data->comp[COMP_S];
+	data->p.sink_comp = &data->comp[COMP_D];
+	data->stop_id = -1;
+
+	for (i = 0; i < COMP_NUM; i++) {
+		dev = &data->comp[i];
+		dev->ipc_config.id = i;
+		dev->ipc_config.pipeline_id = i == COMP_X ? PIPELINE_ID_OTHER : PIPELINE_ID;
+		dev->drv = &mock_drv;
+		dev->state = COMP_STATE_ACTIVE;
+		dev->direction = SOF_IPC_STREAM_CAPTURE;
+		dev->pipeline = i == COMP_X ? NULL : &data->p;
+		list_init(&dev->bsource_list);
+		list_init(&dev->bsink_list);
+	}
+
+	for (i = 0; i < BUFFER_NUM; i++) {
+		data->buffer[i].id = i;
+		list_init(&data->buffer[i].source_list);
+		list_init(&data->buffer[i].sink_list);
+		pipeline_connect(&data->comp[graph[i][0]], &data->buffer[i],
+				 PPL_CONN_DIR_COMP_TO_BUFFER);
+		pipeline_connect(&data->comp[graph[i][1]], &data->buffer[i],
+				 PPL_CONN_DIR_BUFFER_TO_COMP);
+	}
+
+	test_data = data;
+	*state = data;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct copy_sched_data *data = *state;
+
+	pipeline_copy_sched_free(&data->p);
+	free(data);
+
+	return 0;
+}
+
+static void set_playback(struct copy_sched_data *data)
+{
+	int i;
+
+	for (i = 0; i < COMP_NUM; i++)
+		data->comp[i].direction = SOF_IPC_STREAM_PLAYBACK;
+}
+
+/* copy with the graph walk and with the schedule, both must copy the same */
+static void assert_copy_matches_walk(struct copy_sched_data *data)
+{
+	int walk_copies[MAX_COPIES];
+	int walk_num;
+	int walk_ret;
+	int ret;
+	int i;
+
+	pipeline_copy_sched_free(&data->p);
+	data->num_copies = 0;
+	walk_ret = pipeline_copy(&data->p);
+	walk_num = data->num_copies;
+	for (i = 0; i < walk_num; i++)
+		walk_copies[i] = data->copies[i];
+
+	assert_int_equal(pipeline_copy_sched_build(&data->p), 0);
+	assert_non_null(data->p.copy_sched);
+	data->num_copies = 0;
+	ret = pipeline_copy(&data->p);
+
+	assert_int_equal(ret, walk_ret);
+	assert_int_equal(data->num_copies, walk_num);
+	assert_memory_equal(data->copies, walk_copies, walk_num * sizeof(int));
+}
+
+static void test_audio_pipeline_copy_sched_downstream(void **state)
+{
+	struct copy_sched_data *data = *state;
+	const int expected[] = {COMP_S, COMP_A, COMP_C, COMP_D, COMP_B, COMP_D};
+
+	assert_copy_matches_walk(data);
+
+	/* D is reached over both branches, other pipeline is not walked */
+	assert_int_equal(data->p.copy_sched->count, 6);
+	assert_int_equal(data->num_copies, 6);
+	assert_memory_equal(data->copies, expected, sizeof(expected));
+}
+
+static void test_audio_pipeline_copy_sched_downstream_inactive(void **state)
+{
+	struct copy_sched_data *data = *state;
+	const int expected[] = {COMP_S, COMP_A, COMP_B, COMP_D};
+
+	data->comp[COMP_C].state = COMP_STATE_PAUSED;
+	assert_copy_matches_walk(data);
+
+	assert_int_equal(data->num_copies, 4);
+	assert_memory_equal(data->copies, expected, sizeof(expected));
+}
+
+static void test_audio_pipeline_copy_sched_upstream(void **state)
+{
+	struct copy_sched_data *data = *state;
+	const int expected[] = {COMP_S, COMP_A, COMP_C, COMP_S, COMP_A, COMP_B, COMP_D};
+
+	set_playback(data);
+	assert_copy_matches_walk(data);
+
+	assert_ptr_equal(data->p.copy_sched->start, &data->comp[COMP_D]);
+	assert_int_equal(data->num_copies, 7);
+	assert_memory_equal(data->copies, expected, sizeof(expected));
+}
+
+static void test_audio_pipeline_copy_sched_upstream_inactive(void **state)
+{
+	struct copy_sched_data *data = *state;
+	const int expected[] = {COMP_S, COMP_A, COMP_C, COMP_D};
+
+	set_playback(data);
+	data->comp[COMP_B].state = COMP_STATE_PAUSED;
+	assert_copy_matches_walk(data);
+
+	assert_int_equal(data->num_copies, 4);
+	assert_memory_equal(data->copies, expected, sizeof(expected));
+}
+
+static void test_audio_pipeline_copy_sched_path_stop(void **state)
+{
+	struct copy_sched_data *data = *state;
+
+	data->stop_id = COMP_C;
+	assert_copy_matches_walk(data);
+	assert_int_equal(data->num_copies, 3);
+
+	set_playback(data);
+	data->stop_id = COMP_A;
+	assert_copy_matches_walk(data);
+	assert_int_equal(data->num_copies, 2);
+}
+
+static void test_audio_pipeline_copy_sched_disconnect(void **state)
+{
+	struct copy_sched_data *data = *state;
+	const int expected[] = {COMP_S, COMP_A, COMP_C, COMP_B, COMP_D};
+
+	assert_int_equal(pipeline_copy_sched_build(&data->p), 0);
+
+	/* active pipeline, schedule follows the graph */
+	pipeline_disconnect(&data->comp[COMP_C], &data->buffer[4],
+			    PPL_CONN_DIR_COMP_TO_BUFFER);
+	pipeline_disconnect(&data->comp[COMP_D], &data->buffer[4],
+			    PPL_CONN_DIR_BUFFER_TO_COMP);
+	assert_non_null(data->p.copy_sched);
+	assert_int_equal(data->p.copy_sched->count, 5);
+
+	data->num_copies = 0;
+	pipeline_copy(&data->p);
+	assert_int_equal(data->num_copies, 5);
+	assert_memory_equal(data->copies, expected, sizeof(expected));
+
+	/* stopped pipeline drops the schedule until prepared again */
+	data->p.status = COMP_STATE_READY;
+	pipeline_disconnect(&data->comp[COMP_B], &data->buffer[3],
+			    PPL_CONN_DIR_COMP_TO_BUFFER);
+	assert_null(data->p.copy_sched);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_downstream,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_downstream_inactive,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_upstream,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_upstream_inactive,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_path_stop,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_audio_pipeline_copy_sched_disconnect,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
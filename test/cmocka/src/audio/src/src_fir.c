@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <sof/audio/src/src_config.h>
+#include <sof/audio/src/src.h>
+#include <sof/common.h>
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_MAX_CH		8
+#define TEST_BLOCKS		40
+#define TEST_TIMES		3
+
+#if SRC_SHORT
+typedef int16_t test_coef_t;
+#else
+typedef int32_t test_coef_t;
+#endif
+
+/* Stages structure as used for 48 kHz to 44.1 kHz conversion, random coefficients */
+static test_coef_t test_coef1[640];
+static test_coef_t test_coef2[1120];
+
+static struct src_stage test_stage1 = {
+	6, 7, 8, 80, 640, 7, 8, 0, 0, test_coef1
+};
+
+static struct src_stage test_stage2 = {
+	1, 1, 20, 56, 1120, 21, 20, 0, 1, test_coef2
+};
+
+struct test_src {
+	struct src_state state;
+	int32_t *delay;
+	int32_t *y;
+};
+
+static void test_src_init(struct test_src *t, struct src_stage *stage, int nch, int y_size)
+{
+	int fir_size = nch * (stage->subfilter_length + (stage->num_of_subfilters - 1) *
+			      stage->idm + stage->blk_in);
+	int out_size = nch * (1 + (stage->num_of_subfilters - 1) * stage->odm);
+
+	t->delay = calloc(fir_size + out_size, sizeof(int32_t));
+	t->y = calloc(y_size, sizeof(int32_t));
+	assert_non_null(t->delay);
+	assert_non_null(t->y);
+
+	t->state.fir_delay_size = fir_size;
+	t->state.out_delay_size = out_size;
+	t->state.fir_delay = t->delay;
+	t->state.out_delay = t->delay + fir_size;
+	t->state.fir_wp = &t->state.fir_delay[fir_size - 1];
+	t->state.out_rp = t->state.out_delay;
+}
+
+static void test_src_free(struct test_src *t)
+{
+	free(t->delay);
+	free(t->y);
+}
+
+static void test_coef_fill(test_coef_t *coef, int n, bool full_scale)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		coef[i] = (test_coef_t)(rand() << 16 ^ rand());
+		if (!full_scale)
+			coef[i] >>= 4;
+	}
+}
+
+/* Run a stage with the generic and the channels count specific FIR cores */
+static void test_src_fir_stage(struct src_stage *stage, int nch, bool full_scale)
+{
+	struct src_stage_prm s;
+	struct test_src ref;
+	struct test_src dut;
+	const int x_size = nch * stage->blk_in * TEST_TIMES;
+	const int y_size = nch * stage->blk_out * TEST_TIMES;
+	int32_t *x;
+	int i;
+	int n;
+
+	srand(nch);
+	test_coef_fill((test_coef_t *)stage->coefs, stage->filter_length, full_scale);
+	test_src_init(&ref, stage, nch, y_size);
+	test_src_init(&dut, stage, nch, y_size);
+	ref.state.fir_filter = src_fir_filter_generic;
+	dut.state.fir_filter = src_fir_get(nch);
+
+	x = malloc(x_size * sizeof(int32_t));
+	assert_non_null(x);
+
+	memset(&s, 0, sizeof(s));
+	s.nch = nch;
+	s.times = TEST_TIMES;
+	s.x_end_addr = x + x_size;
+	s.x_size = x_size * sizeof(int32_t);
+	s.y_size = y_size * sizeof(int32_t);
+	s.stage = stage;
+
+	/* enough blocks for the delay lines to wrap a number of times */
+	for (n = 0; n < TEST_BLOCKS; n++) {
+		for (i = 0; i < x_size; i++)
+			x[i] = rand() << 16 ^ rand();
+
+		s.state = &ref.state;
+		s.x_rptr = x;
+		s.y_wptr = ref.y;
+		s.y_end_addr = ref.y + y_size;
+		src_polyphase_stage_cir(&s);
+
+		s.state = &dut.state;
+		s.x_rptr = x;
+		s.y_wptr = dut.y;
+		s.y_end_addr = dut.y + y_size;
+		src_polyphase_stage_cir(&s);
+
+		assert_memory_equal(ref.y, dut.y, y_size * sizeof(int32_t));
+	}
+
+	free(x);
+	test_src_free(&dut);
+	test_src_free(&ref);
+}
+
+static void test_src_fir_48_to_44(void **state)
+{
+	const int channels[] = {1, 2, 3, 4, 6, 8};
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(channels); i++) {
+		test_src_fir_stage(&test_stage1, channels[i], false);
+		test_src_fir_stage(&test_stage2, channels[i], false);
+	}
+}
+
+static void test_src_fir_saturate(void **state)
+{
+	int nch;
+
+	(void)state;
+
+	for (nch = 1; nch <= TEST_MAX_CH; nch++)
+		test_src_fir_stage(&test_stage1, nch, true);
+}
+
+static void test_src_fir_get(void **state)
+{
+	(void)state;
+
+	/* other channels counts use the generic FIR core */
+	assert_ptr_equal(src_fir_get(3), src_fir_filter_generic);
+	assert_ptr_equal(src_fir_get(5), src_fir_filter_generic);
+	assert_ptr_not_equal(src_fir_get(2), src_fir_filter_generic);
+	assert_ptr_not_equal(src_fir_get(8), src_fir_filter_generic);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_src_fir_48_to_44),
+		cmocka_unit_test(test_src_fir_saturate),
+		cmocka_unit_test(test_src_fir_get),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
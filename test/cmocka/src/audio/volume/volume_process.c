@@ -72,6 +72,8 @@ static int setup(void **state)
 
 	/* set processing function and volume */
 	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev, vol_state->sinks[0]);
+	cd->scale_vol_ramp = vol_get_ramp_function(vol_state->mod->dev, vol_state->sinks[0]);
+	cd->channels = vol_state->parameters.channels;
 	set_volume(cd->volume, vol_parameters->volume, vol_state->parameters.channels);
 
 	/* assign test state */
@@ -256,12 +258,8 @@ static void verify_s32_to_s24_s32(struct processing_module *mod,
 }
 #endif /* CONFIG_FORMAT_S32LE */
 
-static void test_audio_vol(void **state)
+static void fill_source(struct processing_module_test_data *vol_state)
 {
-	struct processing_module_test_data *vol_state = *state;
-	struct processing_module *mod = vol_state->mod;
-	struct vol_data *cd = module_get_private_data(mod);
-
 	switch (vol_state->sinks[0]->stream.frame_fmt) {
 	case SOF_IPC_FRAME_S16_LE:
 		fill_source_s16(vol_state);
@@ -277,7 +275,15 @@ static void test_audio_vol(void **state)
 		/* TODO: add 3LE support */
 		break;
 	}
+}
+
+static void test_audio_vol(void **state)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
 
+	fill_source(vol_state);
 	vol_state->input_buffers[0]->consumed = 0;
 	vol_state->output_buffers[0]->size = 0;
 
@@ -287,6 +293,45 @@ static void test_audio_vol(void **state)
 	vol_state->verify(mod, vol_state->sinks[0], vol_state->sources[0]);
 }
 
+static void test_audio_vol_ramp(void **state)
+{
+	struct processing_module_test_data *vol_state = *state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
+	int32_t ramp_vol;
+	int i;
+
+	/* ramp with zero increment must match the constant gain */
+	for (i = 0; i < cd->channels; i++) {
+		cd->ramp_vol[i] = cd->volume[i] << VOL_RAMP_FRAC_BITS;
+		cd->ramp_delta[i] = 0;
+	}
+
+	fill_source(vol_state);
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+
+	cd->scale_vol_ramp(mod, vol_state->input_buffers[0], vol_state->output_buffers[0],
+			   mod->dev->frames, cd->attenuation);
+
+	vol_state->verify(mod, vol_state->sinks[0], vol_state->sources[0]);
+
+	/* the gain is incremented once per frame */
+	for (i = 0; i < cd->channels; i++)
+		cd->ramp_delta[i] = -(i + 1);
+
+	vol_state->input_buffers[0]->consumed = 0;
+	vol_state->output_buffers[0]->size = 0;
+
+	cd->scale_vol_ramp(mod, vol_state->input_buffers[0], vol_state->output_buffers[0],
+			   mod->dev->frames, cd->attenuation);
+
+	for (i = 0; i < cd->channels; i++) {
+		ramp_vol = (cd->volume[i] << VOL_RAMP_FRAC_BITS) - (i + 1) * mod->dev->frames;
+		assert_int_equal(cd->ramp_vol[i], ramp_vol);
+	}
+}
+
 static struct processing_module_test_parameters test_parameters[] = {
 #if CONFIG_FORMAT_S16LE
 	{ 2, 48, 1, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE,   verify_s16_to_s16 },
@@ -306,10 +351,11 @@ int main(void)
 {
 	struct vol_test_parameters *parameters;
 	uint32_t volume_values[] = {VOL_MAX, VOL_ZERO_DB, VOL_MINUS_80DB};
-	int num_tests = ARRAY_SIZE(test_parameters) * ARRAY_SIZE(volume_values);
+	int num_params = ARRAY_SIZE(test_parameters) * ARRAY_SIZE(volume_values);
+	int num_tests = num_params * 2;
 	int i, j;
 
-	parameters = test_calloc(num_tests, sizeof(struct vol_test_parameters));
+	parameters = test_calloc(num_params, sizeof(struct vol_test_parameters));
 	for (i = 0; i < ARRAY_SIZE(test_parameters); i++) {
 		for (j = 0; j < ARRAY_SIZE(volume_values); j++) {
 			parameters[i * ARRAY_SIZE(test_parameters) + j].volume = volume_values[j];
@@ -320,12 +366,18 @@ int main(void)
 
 	struct CMUnitTest tests[num_tests];
 
-	for (i = 0; i < num_tests; i++) {
+	for (i = 0; i < num_params; i++) {
 		tests[i].name = "test_audio_vol";
 		tests[i].test_func = test_audio_vol;
 		tests[i].setup_func = setup;
 		tests[i].teardown_func = teardown;
 		tests[i].initial_state = &parameters[i];
+
+		tests[num_params + i].name = "test_audio_vol_ramp";
+		tests[num_params + i].test_func = test_audio_vol_ramp;
+		tests[num_params + i].setup_func = setup;
+		tests[num_params + i].teardown_func = teardown;
+		tests[num_params + i].initial_state = &parameters[i];
 	}
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -21,9 +21,13 @@
 enum test_type {
 	TEST_BULK = 0,
 	TEST_ZERO,
-	TEST_IMMEDIATE_FREE
+	TEST_IMMEDIATE_FREE,
+	TEST_STRESS
 };
 
+/* alloc and free rounds of the stress test */
+#define TEST_STRESS_ROUNDS	256
+
 struct test_case {
 	size_t alloc_size;
 	int alloc_zone;
@@ -200,6 +204,17 @@ static struct test_case test_cases[] = {
 		  2, TEST_BULK, "rballoc_dma"),
 	TEST_CASE(256, SOF_MEM_ZONE_BUFFER, SOF_MEM_CAPS_RAM | SOF_MEM_CAPS_DMA,
 		  2, TEST_BULK, "rballoc_dma"),
+
+	/*
+	 * stress tests, random frees leave the heaps fragmented
+	 */
+
+	TEST_CASE(16,   SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 64, TEST_STRESS,
+		  "stress"),
+	TEST_CASE(200,  SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 16, TEST_STRESS,
+		  "stress"),
+	TEST_CASE(1500, SOF_MEM_ZONE_BUFFER, SOF_MEM_CAPS_RAM, 16, TEST_STRESS,
+		  "stress"),
 };
 
 static int setup(void **state)
@@ -304,6 +319,51 @@ static void test_lib_alloc_zero(struct test_case *tc)
 	free(all_mem);
 }
 
+static void assert_no_overlap(void **mem, struct test_case *tc)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < tc->alloc_num; ++i)
+		for (j = i + 1; j < tc->alloc_num; ++j)
+			assert_true((char *)mem[i] + tc->alloc_size <= (char *)mem[j] ||
+				    (char *)mem[j] + tc->alloc_size <= (char *)mem[i]);
+}
+
+static void test_lib_alloc_stress(struct test_case *tc)
+{
+	void **all_mem = calloc(tc->alloc_num, sizeof(void *));
+	uint32_t seed = 1;
+	int round;
+	int i;
+
+	for (round = 0; round < TEST_STRESS_ROUNDS; ++round) {
+		/* refill the slots freed by the previous round */
+		for (i = 0; i < tc->alloc_num; ++i) {
+			if (!all_mem[i]) {
+				all_mem[i] = alloc(tc);
+				assert_non_null(all_mem[i]);
+			}
+		}
+
+		assert_no_overlap(all_mem, tc);
+
+		/* free about half of the objects */
+		for (i = 0; i < tc->alloc_num; ++i) {
+			seed = seed * 1103515245 + 12345;
+			if (seed & 0x10000) {
+				rfree(all_mem[i]);
+				all_mem[i] = NULL;
+			}
+		}
+	}
+
+	for (i = 0; i < tc->alloc_num; ++i)
+		rfree(all_mem[i]);
+
+	free(all_mem);
+}
+
 static void test_lib_alloc(void **state)
 {
 	struct test_case *tc = *((struct test_case **)state);
@@ -320,6 +380,10 @@ static void test_lib_alloc(void **state)
 	case TEST_IMMEDIATE_FREE:
 		test_lib_alloc_immediate_free(tc);
 		break;
+
+	case TEST_STRESS:
+		test_lib_alloc_stress(tc);
+		break;
 	}
 }
 
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <math.h>
+#include <time.h>
 #include <cmocka.h>
 #include <stdbool.h>
 
@@ -39,6 +40,14 @@
 #define MIN_SNR_512	125.0
 #define MIN_SNR_1024	119.0
 
+/* Real input FFT vs. double precision DFT of the same input */
+#define MIN_SNR_REAL_256	143.0
+#define MIN_SNR_REAL_1024	130.0
+#define MIN_SNR_REAL_256_16	57.0
+#define MIN_SNR_REAL_1024_16	42.0
+#define FFT_BENCHMARK_SIZE	512
+#define FFT_BENCHMARK_RUNS	2000
+
 /**
  * \brief Doing Fast Fourier Transform (FFT) for mono real input buffers.
  * \param[in] src - pointer to input buffer.
@@ -786,6 +795,246 @@ static void test_math_fft_1024_ifft_16(void **state)
 	assert_int_equal(db < FFT_DB_TH_16, 0);
 }
 
+/**
+ * \brief Signal to noise ratio of FFT output bins 0 to size / 2 vs. a double
+ *	  precision DFT of the real input, scaled by 1/size as the FFT library.
+ * \param[in] in - real input samples, float to keep 16 and 32 bit inputs.
+ * \param[in] out_re - real part of FFT output in same scale as input.
+ * \param[in] out_im - imaginary part of FFT output in same scale as input.
+ * \param[in] size - FFT size.
+ */
+static double fft_real_ref_snr(const double *in, const double *out_re, const double *out_im,
+			       int size)
+{
+	double signal = 0;
+	double noise = 0;
+	double re;
+	double im;
+	double w;
+	int k;
+	int n;
+
+	for (k = 0; k <= size / 2; k++) {
+		re = 0;
+		im = 0;
+		for (n = 0; n < size; n++) {
+			w = TWO_PI * ((k * n) % size) / size;
+			re += in[n] * cos(w);
+			im -= in[n] * sin(w);
+		}
+
+		re /= size;
+		im /= size;
+		signal += re * re + im * im;
+		noise += (out_re[k] - re) * (out_re[k] - re) + (out_im[k] - im) * (out_im[k] - im);
+	}
+
+	return 10 * log10(signal / noise);
+}
+
+static double fft_real_plan_32(const int32_t *vector, int size)
+{
+	struct icomplex32 *outb;
+	struct fft_plan *plan;
+	int32_t *inb;
+	double *ref;
+	double snr;
+	int i;
+
+	inb = test_calloc(size, sizeof(int32_t));
+	outb = test_calloc(size / 2 + 1, sizeof(struct icomplex32));
+	ref = test_calloc(size * 3, sizeof(double));
+	assert_non_null(inb);
+	assert_non_null(outb);
+	assert_non_null(ref);
+
+	plan = fft_plan_new_real(inb, outb, size, 32);
+	assert_non_null(plan);
+
+	for (i = 0; i < size; i++) {
+		inb[i] = vector[i];
+		ref[i] = vector[i];
+	}
+
+	fft_execute_real_32(plan);
+
+	for (i = 0; i <= size / 2; i++) {
+		ref[size + i] = outb[i].real;
+		ref[2 * size + i] = outb[i].imag;
+	}
+
+	snr = fft_real_ref_snr(ref, &ref[size], &ref[2 * size], size);
+
+	fft_plan_free(plan);
+	test_free(ref);
+	test_free(outb);
+	test_free(inb);
+	return snr;
+}
+
+static double fft_real_plan_16(const int16_t *vector, int size)
+{
+	struct icomplex16 *outb;
+	struct fft_plan *plan;
+	int16_t *inb;
+	double *ref;
+	double snr;
+	int i;
+
+	inb = test_calloc(size, sizeof(int16_t));
+	outb = test_calloc(size / 2 + 1, sizeof(struct icomplex16));
+	ref = test_calloc(size * 3, sizeof(double));
+	assert_non_null(inb);
+	assert_non_null(outb);
+	assert_non_null(ref);
+
+	plan = fft_plan_new_real(inb, outb, size, 16);
+	assert_non_null(plan);
+
+	for (i = 0; i < size; i++) {
+		inb[i] = vector[i];
+		ref[i] = vector[i];
+	}
+
+	fft_execute_real_16(plan);
+
+	for (i = 0; i <= size / 2; i++) {
+		ref[size + i] = outb[i].real;
+		ref[2 * size + i] = outb[i].imag;
+	}
+
+	snr = fft_real_ref_snr(ref, &ref[size], &ref[2 * size], size);
+
+	fft_plan_free(plan);
+	test_free(ref);
+	test_free(outb);
+	test_free(inb);
+	return snr;
+}
+
+static void test_math_fft_real_256(void **state)
+{
+	int32_t in[256];
+	double snr;
+
+	(void)state;
+
+	get_sine_32(in, SINE_FREQ, SINE_FS, 256);
+	snr = fft_real_plan_32(in, 256);
+	printf("%s: SNR %5.2f dB\n", __func__, snr);
+	assert_int_equal(snr < MIN_SNR_REAL_256, 0);
+}
+
+static void test_math_fft_real_1024(void **state)
+{
+	double snr;
+
+	(void)state;
+
+	snr = fft_real_plan_32(input_samples, 1024);
+	printf("%s: SNR %5.2f dB\n", __func__, snr);
+	assert_int_equal(snr < MIN_SNR_REAL_1024, 0);
+}
+
+static void test_math_fft_real_256_16(void **state)
+{
+	int16_t in[256];
+	double snr;
+
+	(void)state;
+
+	get_sine_16(in, SINE_FREQ, SINE_FS, 256);
+	snr = fft_real_plan_16(in, 256);
+	printf("%s: SNR %5.2f dB\n", __func__, snr);
+	assert_int_equal(snr < MIN_SNR_REAL_256_16, 0);
+}
+
+static void test_math_fft_real_1024_16(void **state)
+{
+	int16_t in[1024];
+	double snr;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < 1024; i++)
+		in[i] = input_samples[i] >> 16;
+
+	snr = fft_real_plan_16(in, 1024);
+	printf("%s: SNR %5.2f dB\n", __func__, snr);
+	assert_int_equal(snr < MIN_SNR_REAL_1024_16, 0);
+}
+
+/* A real input plan needs at least four samples and fits the twiddle table */
+static void test_math_fft_real_plan_size(void **state)
+{
+	int16_t inb[2 * FFT_SIZE_MAX];
+	struct icomplex16 outb[FFT_SIZE_MAX + 1];
+
+	(void)state;
+
+	assert_null(fft_plan_new_real(inb, outb, 2, 16));
+	assert_null(fft_plan_new_real(inb, outb, 2 * FFT_SIZE_MAX, 16));
+}
+
+/* Compare complex and real input FFT execution times for MFCC like 16 bit use */
+static void test_math_fft_real_benchmark(void **state)
+{
+	struct icomplex16 *cin;
+	struct icomplex16 *cout;
+	struct icomplex16 *rout;
+	struct fft_plan *cplan;
+	struct fft_plan *rplan;
+	int16_t *rin;
+	clock_t t0;
+	double tc;
+	double tr;
+	int i;
+
+	(void)state;
+
+	cin = test_calloc(FFT_BENCHMARK_SIZE, sizeof(struct icomplex16));
+	cout = test_calloc(FFT_BENCHMARK_SIZE, sizeof(struct icomplex16));
+	rin = test_calloc(FFT_BENCHMARK_SIZE, sizeof(int16_t));
+	rout = test_calloc(FFT_BENCHMARK_SIZE / 2 + 1, sizeof(struct icomplex16));
+	assert_non_null(cin);
+	assert_non_null(cout);
+	assert_non_null(rin);
+	assert_non_null(rout);
+
+	cplan = fft_plan_new(cin, cout, FFT_BENCHMARK_SIZE, 16);
+	rplan = fft_plan_new_real(rin, rout, FFT_BENCHMARK_SIZE, 16);
+	assert_non_null(cplan);
+	assert_non_null(rplan);
+
+	get_sine_16(rin, SINE_FREQ, SINE_FS, FFT_BENCHMARK_SIZE);
+	for (i = 0; i < FFT_BENCHMARK_SIZE; i++)
+		cin[i].real = rin[i];
+
+	t0 = clock();
+	for (i = 0; i < FFT_BENCHMARK_RUNS; i++)
+		fft_execute_16(cplan, false);
+
+	tc = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+	t0 = clock();
+	for (i = 0; i < FFT_BENCHMARK_RUNS; i++)
+		fft_execute_real_16(rplan);
+
+	tr = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+	printf("%s: %d point FFT, complex %.2f us, real %.2f us per transform\n",
+	       __func__, FFT_BENCHMARK_SIZE, 1e6 * tc / FFT_BENCHMARK_RUNS,
+	       1e6 * tr / FFT_BENCHMARK_RUNS);
+
+	fft_plan_free(rplan);
+	fft_plan_free(cplan);
+	test_free(rout);
+	test_free(rin);
+	test_free(cout);
+	test_free(cin);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -798,6 +1047,12 @@ int main(void)
 		cmocka_unit_test(test_math_fft_1024),
 		cmocka_unit_test(test_math_fft_1024_ifft),
 		cmocka_unit_test(test_math_fft_512_2ch),
+		cmocka_unit_test(test_math_fft_real_256),
+		cmocka_unit_test(test_math_fft_real_1024),
+		cmocka_unit_test(test_math_fft_real_256_16),
+		cmocka_unit_test(test_math_fft_real_1024_16),
+		cmocka_unit_test(test_math_fft_real_plan_size),
+		cmocka_unit_test(test_math_fft_real_benchmark),
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
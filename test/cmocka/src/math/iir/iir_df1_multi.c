@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <sof/math/iir_df1.h>
+#include <user/eq.h>
+
+#define TEST_FRAMES		2048
+#define TEST_MAX_BIQUADS	4
+
+/* Sections from the two channels EQ test blob, {a2, a1, b2, b1, b0, shift, gain} */
+static const int32_t test_sections[TEST_MAX_BIQUADS][SOF_EQ_IIR_NBIQUAD] = {
+	{0xc12c82bd, 0x7ed0b52e, 0x1fc7cc0c, 0xc07067e9, 0x1fc7cc0c, 0, 0x4000},
+	{0xcad0cdef, 0x742e8c5d, 0x0cdc9086, 0xe2f11723, 0x10b2f932, 0, 0x4000},
+	{0xcf45334a, 0x68260de9, 0x0a54e176, 0xe5d6cb75, 0x11fc1f3d, 0, 0x4000},
+	{0xf2940609, 0xe25f3930, 0x0d69ba64, 0x1ad374c8, 0x0d69ba64, -5, 0x45bf},
+};
+
+struct test_iir {
+	struct iir_state_df1 iir[IIR_DF1_MULTI_MAX_CH];
+	struct sof_eq_iir_header *eq[IIR_DF1_MULTI_MAX_CH];
+	struct iir_multi_state_df1 multi;
+	int32_t *delay;
+	int32_t *multi_data;
+};
+
+static struct sof_eq_iir_header *test_eq_new(int biquads, int in_series, int ch, bool random)
+{
+	struct sof_eq_iir_header *eq;
+	int32_t *coef;
+	int i;
+	int j;
+
+	eq = calloc(1, sizeof(*eq) + biquads * SOF_EQ_IIR_NBIQUAD * sizeof(int32_t));
+	assert_non_null(eq);
+	eq->num_sections = biquads;
+	eq->num_sections_in_series = in_series;
+	coef = (int32_t *)(eq + 1);
+	for (i = 0; i < biquads; i++) {
+		for (j = 0; j < SOF_EQ_IIR_NBIQUAD; j++)
+			coef[j] = test_sections[(i + ch) % TEST_MAX_BIQUADS][j];
+
+		/* random coefficients to exercise the saturations */
+		if (random)
+			for (j = 0; j < SOF_EQ_IIR_NBIQUAD - 2; j++)
+				coef[j] = (int32_t)((uint32_t)rand() << 16 ^ rand());
+
+		/* different gain for each channel */
+		coef[SOF_EQ_IIR_NBIQUAD - 1] += ch * 0x100;
+		coef += SOF_EQ_IIR_NBIQUAD;
+	}
+
+	return eq;
+}
+
+static void test_iir_init(struct test_iir *t, int nch, int biquads, int in_series, bool random)
+{
+	int32_t *delay;
+	int size = 0;
+	int ch;
+
+	for (ch = 0; ch < nch; ch++) {
+		t->eq[ch] = test_eq_new(biquads, in_series, ch, random);
+		iir_init_coef_df1(&t->iir[ch], t->eq[ch]);
+		size += iir_delay_size_df1(t->eq[ch]);
+	}
+
+	t->delay = calloc(1, size);
+	assert_non_null(t->delay);
+	delay = t->delay;
+	for (ch = 0; ch < nch; ch++)
+		iir_init_delay_df1(&t->iir[ch], &delay);
+
+	size = iir_multi_size_df1(t->iir, nch);
+	assert_true(size > 0);
+	t->multi_data = calloc(1, size);
+	assert_non_null(t->multi_data);
+	iir_init_multi_df1(&t->multi, t->iir, nch, t->multi_data);
+}
+
+static void test_iir_free(struct test_iir *t, int nch)
+{
+	int ch;
+
+	for (ch = 0; ch < nch; ch++)
+		free(t->eq[ch]);
+
+	free(t->delay);
+	free(t->multi_data);
+}
+
+/* run the per channel and the lockstep filters with the same input */
+static void test_iir_df1_multi_bit_exact(int nch, int biquads, int in_series, bool random)
+{
+	struct test_iir t;
+	int32_t frame[IIR_DF1_MULTI_MAX_CH] __aligned(8);
+	int32_t ref[IIR_DF1_MULTI_MAX_CH];
+	int32_t x;
+	int ch;
+	int i;
+
+	srand(nch * 100 + biquads * 10 + in_series);
+	test_iir_init(&t, nch, biquads, in_series, random);
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		/* full scale noise with a full scale step in the middle */
+		for (ch = 0; ch < nch; ch++) {
+			x = (int32_t)((uint32_t)rand() << 16 ^ rand());
+			if (i > TEST_FRAMES / 2 && i < TEST_FRAMES / 2 + 64)
+				x = ch & 1 ? INT32_MIN : INT32_MAX;
+
+			frame[ch] = x;
+			ref[ch] = iir_df1(&t.iir[ch], x);
+		}
+
+		iir_df1_multi(&t.multi, frame);
+		for (ch = 0; ch < nch; ch++)
+			assert_int_equal(frame[ch], ref[ch]);
+	}
+
+	test_iir_free(&t, nch);
+}
+
+static void test_iir_df1_multi_series(void **state)
+{
+	int nch;
+
+	(void)state;
+
+	for (nch = 2; nch <= IIR_DF1_MULTI_MAX_CH; nch += 2)
+		test_iir_df1_multi_bit_exact(nch, 4, 4, false);
+}
+
+static void test_iir_df1_multi_parallel(void **state)
+{
+	int nch;
+
+	(void)state;
+
+	for (nch = 2; nch <= IIR_DF1_MULTI_MAX_CH; nch += 2)
+		test_iir_df1_multi_bit_exact(nch, 4, 2, false);
+}
+
+static void test_iir_df1_multi_saturate(void **state)
+{
+	int nch;
+
+	(void)state;
+
+	for (nch = 2; nch <= IIR_DF1_MULTI_MAX_CH; nch += 2)
+		test_iir_df1_multi_bit_exact(nch, 3, 3, true);
+}
+
+static void test_iir_df1_multi_size(void **state)
+{
+	struct test_iir t;
+	struct sof_eq_iir_header *eq;
+
+	(void)state;
+
+	test_iir_init(&t, 4, 2, 2, false);
+
+	/* odd and out of range channels counts are not run in lockstep */
+	assert_int_equal(iir_multi_size_df1(t.iir, 3), -EINVAL);
+	assert_int_equal(iir_multi_size_df1(t.iir, 0), -EINVAL);
+	assert_int_equal(iir_multi_size_df1(t.iir, IIR_DF1_MULTI_MAX_CH + 2), -EINVAL);
+	assert_int_equal(iir_multi_size_df1(t.iir, 4),
+			 (SOF_EQ_IIR_NBIQUAD + IIR_DF1_NUM_STATE) * 2 * 4 * sizeof(int32_t));
+
+	/* different structure in one channel */
+	eq = test_eq_new(3, 3, 0, false);
+	iir_init_coef_df1(&t.iir[3], eq);
+	assert_int_equal(iir_multi_size_df1(t.iir, 4), -EINVAL);
+	free(eq);
+
+	/* pass-through channel */
+	t.iir[3].biquads = 0;
+	assert_int_equal(iir_multi_size_df1(t.iir, 4), -EINVAL);
+
+	test_iir_free(&t, 4);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_iir_df1_multi_series),
+		cmocka_unit_test(test_iir_df1_multi_parallel),
+		cmocka_unit_test(test_iir_df1_multi_saturate),
+		cmocka_unit_test(test_iir_df1_multi_size),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
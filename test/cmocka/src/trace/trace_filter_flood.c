@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+#include <rtos/sof.h>
+#include <rtos/alloc.h>
+#include <sof/ipc/topology.h>
+#include <sof/lib/mailbox.h>
+#include <sof/trace/dma-trace.h>
+#include <sof/trace/trace.h>
+#include <user/trace.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <cmocka.h>
+
+#define ENTRY(n)		(0x1000 + (n) * 4)
+#define QUICK			10	/* well below the recent time threshold */
+#define QUIET			(CONFIG_TRACE_RECENT_TIME_THRESHOLD + 1)
+#define MAX_LOGS		64
+
+/* log entry addresses sent to the DMA trace */
+static uint32_t logs[MAX_LOGS];
+static int num_logs;
+static uint64_t test_ts;
+static struct timer test_timer;
+static struct tr_ctx test_tr = { .level = LOG_LEVEL_VERBOSE };
+
+struct tr_ctx dt_tr = { .level = LOG_LEVEL_VERBOSE };
+
+uint64_t platform_timer_get(struct timer *timer)
+{
+	return test_ts;
+}
+
+int dma_trace_init_early(struct sof *sof)
+{
+	return 0;
+}
+
+void dma_trace_flush(void *destination)
+{
+}
+
+void dma_trace_on(void)
+{
+}
+
+void dma_trace_off(void)
+{
+}
+
+int32_t ipc_comp_pipe_id(const struct ipc_comp_dev *icd)
+{
+	return 0;
+}
+
+void dtrace_event(const char *e, uint32_t size)
+{
+	const struct log_entry_header *header = (const struct log_entry_header *)e;
+
+	if (num_logs < MAX_LOGS)
+		logs[num_logs++] = header->log_entry_address;
+}
+
+void dtrace_event_atomic(const char *e, uint32_t size)
+{
+	dtrace_event(e, size);
+}
+
+static void log_at(uint32_t lvl, uint32_t entry, ...)
+{
+	va_list vl;
+
+	va_start(vl, entry);
+	trace_log_filtered(false, (const void *)(uintptr_t)entry, &test_tr, lvl,
+			   0, 0, 0, vl);
+	va_end(vl);
+}
+
+static void log_entry(uint32_t entry)
+{
+	log_at(LOG_LEVEL_INFO, entry);
+}
+
+/* count logs of an entry sent to the DMA trace */
+static int count_logs(uint32_t entry)
+{
+	int count = 0;
+	int i;
+
+	for (i = 0; i < num_logs; i++)
+		if (logs[i] == entry)
+			count++;
+
+	return count;
+}
+
+static int setup(void **state)
+{
+	uintptr_t trace_base = (uintptr_t)MAILBOX_TRACE_BASE;
+	uintptr_t base = ALIGN_DOWN(trace_base, 0x1000);
+	size_t size = ALIGN_UP(trace_base + MAILBOX_TRACE_SIZE, 0x1000) - base;
+	static bool mapped;
+
+	/* trace_init() clears the mailbox trace window */
+	if (!mapped) {
+		if (mmap((void *)base, size, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+			return -1;
+		mapped = true;
+	}
+
+	sof_get()->platform_timer = &test_timer;
+	trace_init(sof_get());
+
+	memset(logs, 0, sizeof(logs));
+	num_logs = 0;
+	test_ts = 1000;
+
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	free(sof_get()->trace);
+	sof_get()->trace = NULL;
+
+	return 0;
+}
+
+static void test_trace_filter_flood_burst(void **state)
+{
+	int i;
+
+	/* the start of a burst passes, the rest is suppressed */
+	for (i = 0; i < CONFIG_TRACE_BURST_COUNT + 3; i++) {
+		log_entry(ENTRY(0));
+		test_ts += QUICK;
+	}
+	assert_int_equal(count_logs(ENTRY(0)), CONFIG_TRACE_BURST_COUNT);
+
+	/* any log after a quiet period reports and forgets the suppressed entry */
+	test_ts += QUIET;
+	log_entry(ENTRY(1));
+	assert_int_equal(count_logs(ENTRY(1)), 1);
+
+	/* so the next burst of it passes again */
+	num_logs = 0;
+	for (i = 0; i < CONFIG_TRACE_BURST_COUNT + 1; i++) {
+		log_entry(ENTRY(0));
+		test_ts += QUICK;
+	}
+	assert_int_equal(count_logs(ENTRY(0)), CONFIG_TRACE_BURST_COUNT);
+}
+
+static void test_trace_filter_flood_quiet(void **state)
+{
+	int i;
+
+	/* repeated messages spaced more than the threshold are never suppressed */
+	for (i = 0; i < 2 * CONFIG_TRACE_BURST_COUNT; i++) {
+		log_entry(ENTRY(0));
+		test_ts += QUIET;
+	}
+	assert_int_equal(count_logs(ENTRY(0)), 2 * CONFIG_TRACE_BURST_COUNT);
+}
+
+static void test_trace_filter_flood_max_time(void **state)
+{
+	uint64_t start = test_ts;
+
+	/* a continuous burst is reported after the maximum suppression time */
+	while (test_ts - start < CONFIG_TRACE_RECENT_MAX_TIME) {
+		log_entry(ENTRY(0));
+		test_ts += CONFIG_TRACE_RECENT_TIME_THRESHOLD - 1;
+	}
+	assert_int_equal(count_logs(ENTRY(0)), CONFIG_TRACE_BURST_COUNT);
+
+	/* the reported entry is forgotten and starts a new burst */
+	log_entry(ENTRY(0));
+	assert_int_equal(count_logs(ENTRY(0)), CONFIG_TRACE_BURST_COUNT + 1);
+}
+
+static void test_trace_filter_flood_evict(void **state)
+{
+	int i;
+	int j;
+
+	/* fill the filter with suppressed bursts */
+	for (i = 0; i < CONFIG_TRACE_RECENT_ENTRIES_COUNT; i++)
+		for (j = 0; j < CONFIG_TRACE_BURST_COUNT + 1; j++) {
+			log_entry(ENTRY(i));
+			test_ts += QUICK;
+		}
+
+	/* refresh the first entry, the second one is the least recently seen now */
+	log_entry(ENTRY(0));
+	test_ts += QUICK;
+
+	/* a new entry evicts the least recently seen one */
+	log_entry(ENTRY(CONFIG_TRACE_RECENT_ENTRIES_COUNT));
+	assert_int_equal(count_logs(ENTRY(CONFIG_TRACE_RECENT_ENTRIES_COUNT)), 1);
+
+	/* the evicted entry starts a new burst, the refreshed one is still suppressed */
+	num_logs = 0;
+	log_entry(ENTRY(1));
+	log_entry(ENTRY(0));
+	assert_int_equal(count_logs(ENTRY(1)), 1);
+	assert_int_equal(count_logs(ENTRY(0)), 0);
+}
+
+static void test_trace_filter_flood_debug(void **state)
+{
+	int i;
+
+	/* debug messages are not suppressed */
+	for (i = 0; i < 2 * CONFIG_TRACE_BURST_COUNT; i++) {
+		log_at(LOG_LEVEL_DEBUG, ENTRY(0));
+		test_ts += QUICK;
+	}
+	assert_int_equal(count_logs(ENTRY(0)), 2 * CONFIG_TRACE_BURST_COUNT);
+}
+
+static void test_trace_filter_flood_many_entries(void **state)
+{
+	int round;
+	int i;
+
+	/* more entries than tracked, cycling keeps evicting and refilling the hash */
+	for (round = 0; round < 3; round++)
+		for (i = 0; i < 3 * CONFIG_TRACE_RECENT_ENTRIES_COUNT; i++) {
+			num_logs = 0;
+			log_entry(ENTRY(i));
+			assert_int_equal(count_logs(ENTRY(i)), 1);
+			test_ts += QUICK;
+		}
+
+	/* the last tracked entries are still found */
+	num_logs = 0;
+	for (i = 0; i < CONFIG_TRACE_BURST_COUNT; i++)
+		log_entry(ENTRY(3 * CONFIG_TRACE_RECENT_ENTRIES_COUNT - 1));
+	assert_int_equal(count_logs(ENTRY(3 * CONFIG_TRACE_RECENT_ENTRIES_COUNT - 1)),
+			 CONFIG_TRACE_BURST_COUNT - 1);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_burst,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_quiet,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_max_time,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_evict,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_debug,
+						setup, teardown),
+		cmocka_unit_test_setup_teardown(test_trace_filter_flood_many_entries,
+						setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
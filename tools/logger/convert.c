@@ -15,6 +15,8 @@
 #include <unistd.h>
 #include <math.h>
 #include <sof/lib/uuid.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <user/abi_dbg.h>
 #include <user/trace.h>
@@ -31,6 +33,9 @@
 #define TRACE_IDS_MASK			((1 << TRACE_ID_LENGTH) - 1)
 #define INVALID_TRACE_ID		(-1 & TRACE_IDS_MASK)
 
+/* initial number of slots in dictionary entry cache, power of two */
+#define LDC_CACHE_INIT_SIZE		256
+
 /** Dictionary entry. This MUST match the start of the linker output
  * defined by _DECLARE_LOG_ENTRY().
  */
@@ -43,7 +48,9 @@ struct ldc_entry_header {
 	uint32_t text_len;
 };
 
-/** Dictionary entry + unformatted parameters */
+/** Dictionary entry + unformatted parameters. The file name and text
+ * point to the mapped dictionary file.
+ */
 struct ldc_entry {
 	struct ldc_entry_header header;
 	char *file_name;
@@ -56,10 +63,23 @@ struct proc_ldc_entry {
 	int subst_mask;
 	struct ldc_entry_header header;
 	char *file_name;
-	char *text;
+	char text[TRACE_MAX_TEXT_LEN];	/* copy of entry text, modified in formatting */
 	uintptr_t params[TRACE_MAX_PARAMS_COUNT];
 };
 
+/** Decoded dictionary entry, cached by log entry address */
+struct ldc_cache_slot {
+	uint32_t address;	/* 0 for empty slot */
+	struct ldc_entry entry;
+};
+
+/** Open addressing hash table of decoded dictionary entries */
+static struct {
+	struct ldc_cache_slot *slots;
+	uint32_t size;		/* number of slots, power of two */
+	uint32_t count;		/* number of used slots */
+} ldc_cache;
+
 static const char *BAD_PTR_STR = "<bad uid ptr 0x%.8x>";
 
 #define UUID_LOWER "%s%s%s<%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x>%s%s%s"
@@ -67,7 +87,7 @@ static const char *BAD_PTR_STR = "<bad uid ptr 0x%.8x>";
 
 static const char *missing = "<missing>";
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address);
+static const struct ldc_entry *get_ldc_entry(uint32_t log_entry_address);
 
 char *format_uid_raw(const struct sof_uuid_entry *uid_entry, int use_colors, int name_first,
 		     bool be, bool upper)
@@ -182,18 +202,11 @@ static const char *asprintf_uuid(const char *fmt, uint32_t uuid_key, bool use_co
 	return format_uid(uuid_key, use_colors, be, upper);
 }
 
-static const char *asprintf_entry_text(uint32_t entry_address)
+static const char *get_entry_text(uint32_t entry_address)
 {
-	struct ldc_entry entry;
-	int ret;
-
-	ret = read_entry_from_ldc_file(&entry, entry_address);
-	if (ret)
-		return NULL;
+	const struct ldc_entry *entry = get_ldc_entry(entry_address);
 
-	free(entry.file_name);
-
-	return entry.text;
+	return entry ? entry->text : NULL;
 }
 
 /** printf-like formatting from the binary ldc_entry input to the
@@ -201,7 +214,7 @@ static const char *asprintf_entry_text(uint32_t entry_address)
  *  ldc_entry_header from input to output.
  *
  * @param[out] pe copy of the header + formatted output
- * @param[in] e copy of the dictionary entry where unformatted,
+ * @param[in] e dictionary entry where unformatted,
     uint32_t params have been inserted.
    @param[in] use_colors whether to use ANSI terminal codes
 */
@@ -209,15 +222,20 @@ static void process_params(struct proc_ldc_entry *pe,
 			   const struct ldc_entry *e,
 			   int use_colors)
 {
-	char *p = e->text;
-	const char *t_end = p + strlen(e->text);
+	char *p = pe->text;
+	const char *t_end;
 	int uuid_fmt_len;
 	int i = 0;
 
 	pe->subst_mask = 0;
 	pe->header =  e->header;
 	pe->file_name = e->file_name;
-	pe->text = e->text;
+
+	/* the entry text is shared by all log lines using it, format a copy.
+	 * It is terminated within TRACE_MAX_TEXT_LEN, see decode_ldc_entry().
+	 */
+	strcpy(pe->text, e->text);
+	t_end = p + strlen(pe->text);
 
 	/*
 	 * Scan the text for possible replacements. We follow the Linux kernel
@@ -272,12 +290,10 @@ static void process_params(struct proc_ldc_entry *pe,
 			t_end -= uuid_fmt_len - 2;
 		} else if (p + 2 < t_end && p[1] == 'p' && p[2] == 'Q') {
 			/* %pQ format specifier */
-			/* substitute log entry address with formatted entry text */
-			pe->params[i] = (uintptr_t)asprintf_entry_text(raw_param);
+			/* substitute log entry address with entry text from dictionary */
+			pe->params[i] = (uintptr_t)get_entry_text(raw_param);
 
-			if (pe->params[i])
-				pe->subst_mask |= 1 << i;
-			else
+			if (!pe->params[i])
 				pe->params[i] = (uintptr_t)missing;
 
 			++i;
@@ -609,84 +625,150 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 	fflush(out_fd);
 }
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address)
+/** Decodes the dictionary entry at log_entry_address in place from the
+ * mapped ldc file, the file name and text are not copied.
+ */
+static int decode_ldc_entry(struct ldc_entry *entry, uint32_t log_entry_address)
 {
-	uint32_t base_address = global_config->logs_header->base_address;
-	uint32_t data_offset = global_config->logs_header->data_offset;
-
-	int ret;
-
-	/* evaluate entry offset in input file */
-	uint32_t entry_offset = (log_entry_address - base_address) + data_offset;
+	const struct snd_sof_logs_header *logs_hdr = global_config->logs_header;
+	const uint8_t *ldc_data = global_config->ldc_data;
+	uint32_t entry_offset;
+	size_t entry_end;
 
 	entry->file_name = NULL;
 	entry->text = NULL;
 	entry->params = NULL;
 
-	/* set file position to beginning of processed entry */
-	fseek(global_config->ldc_fd, entry_offset, SEEK_SET);
+	/* evaluate entry offset in input file */
+	if (log_entry_address < logs_hdr->base_address ||
+	    log_entry_address - logs_hdr->base_address >= logs_hdr->data_length) {
+		log_err("Entry address 0x%x is not in dictionary.\n", log_entry_address);
+		return -EINVAL;
+	}
+	entry_offset = (log_entry_address - logs_hdr->base_address) + logs_hdr->data_offset;
 
 	/* fetching elf header params */
-	ret = fread(&entry->header, sizeof(entry->header), 1, global_config->ldc_fd);
-	if (ret != 1) {
+	entry_end = (size_t)entry_offset + sizeof(entry->header);
+	if (entry_end > global_config->ldc_size) {
 		log_err("Failed to read entry header for offset 0x%x in dictionary.\n",
 			entry_offset);
-		ret = -1;
-		goto out;
+		return -EINVAL;
 	}
+	entry->header = *(const struct ldc_entry_header *)(ldc_data + entry_offset);
+
 	if (entry->header.file_name_len > TRACE_MAX_FILENAME_LEN) {
 		log_err("Invalid filename length %d or ldc file does not match firmware\n",
 			entry->header.file_name_len);
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
-	entry->file_name = (char *)malloc(entry->header.file_name_len);
 
-	if (!entry->file_name) {
-		log_err("can't allocate %d byte for entry.file_name\n",
-			entry->header.file_name_len);
-		ret = -ENOMEM;
-		goto out;
+	/* fetching text */
+	if (entry->header.text_len > TRACE_MAX_TEXT_LEN) {
+		log_err("Invalid text length.\n");
+		return -EINVAL;
 	}
 
-	ret = fread(entry->file_name, sizeof(char), entry->header.file_name_len,
-		    global_config->ldc_fd);
-	if (ret != entry->header.file_name_len) {
-		log_err("Failed to read source filename for offset 0x%x in dictionary.\n",
+	entry_end += entry->header.file_name_len + entry->header.text_len;
+	if (entry_end > global_config->ldc_size) {
+		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
 			entry_offset);
-		ret = -1;
-		goto out;
+		return -EINVAL;
 	}
 
-	/* fetching text */
-	if (entry->header.text_len > TRACE_MAX_TEXT_LEN) {
-		log_err("Invalid text length.\n");
-		ret = -EINVAL;
-		goto out;
+	entry->file_name = (char *)ldc_data + entry_offset + sizeof(entry->header);
+	entry->text = entry->file_name + entry->header.file_name_len;
+
+	/* both strings are used in place, so they must be terminated */
+	if (!memchr(entry->file_name, '\0', entry->header.file_name_len) ||
+	    !memchr(entry->text, '\0', entry->header.text_len)) {
+		log_err("Unterminated string at offset 0x%x in dictionary.\n", entry_offset);
+		return -EINVAL;
 	}
-	entry->text = (char *)malloc(entry->header.text_len);
-	if (!entry->text) {
-		log_err("can't allocate %d byte for entry.text\n", entry->header.text_len);
-		ret = -ENOMEM;
-		goto out;
+
+	return 0;
+}
+
+static uint32_t ldc_cache_hash(uint32_t log_entry_address)
+{
+	/* entries are word aligned, Fibonacci hashing of the word index */
+	return (log_entry_address >> 2) * 2654435761u;
+}
+
+static struct ldc_cache_slot *ldc_cache_find(struct ldc_cache_slot *slots, uint32_t size,
+					     uint32_t log_entry_address)
+{
+	uint32_t i = ldc_cache_hash(log_entry_address) & (size - 1);
+
+	/* linear probing, the table is never full */
+	while (slots[i].address && slots[i].address != log_entry_address)
+		i = (i + 1) & (size - 1);
+
+	return &slots[i];
+}
+
+static int ldc_cache_grow(void)
+{
+	uint32_t size = ldc_cache.size ? ldc_cache.size * 2 : LDC_CACHE_INIT_SIZE;
+	struct ldc_cache_slot *slots;
+	struct ldc_cache_slot *slot;
+	uint32_t i;
+
+	slots = calloc(size, sizeof(*slots));
+	if (!slots) {
+		log_err("can't allocate %u dictionary cache slots\n", size);
+		return -ENOMEM;
 	}
-	ret = fread(entry->text, sizeof(char), entry->header.text_len, global_config->ldc_fd);
-	if (ret != entry->header.text_len) {
-		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+
+	for (i = 0; i < ldc_cache.size; i++) {
+		if (!ldc_cache.slots[i].address)
+			continue;
+
+		slot = ldc_cache_find(slots, size, ldc_cache.slots[i].address);
+		*slot = ldc_cache.slots[i];
 	}
 
+	free(ldc_cache.slots);
+	ldc_cache.slots = slots;
+	ldc_cache.size = size;
+
 	return 0;
+}
 
-out:
-	free(entry->text);
-	entry->text = NULL;
-	free(entry->file_name);
-	entry->file_name = NULL;
+/** Returns the decoded dictionary entry for log_entry_address, each
+ * entry is decoded only the first time it is seen.
+ */
+static const struct ldc_entry *get_ldc_entry(uint32_t log_entry_address)
+{
+	struct ldc_cache_slot *slot;
+	int ret;
 
-	return ret;
+	/* keep load factor below 3/4 */
+	if (4 * (ldc_cache.count + 1) > 3 * ldc_cache.size) {
+		ret = ldc_cache_grow();
+		if (ret < 0)
+			return NULL;
+	}
+
+	slot = ldc_cache_find(ldc_cache.slots, ldc_cache.size, log_entry_address);
+	if (slot->address)
+		return &slot->entry;
+
+	ret = decode_ldc_entry(&slot->entry, log_entry_address);
+	if (ret < 0)
+		return NULL;
+
+	slot->address = log_entry_address;
+	ldc_cache.count++;
+
+	return &slot->entry;
+}
+
+static void ldc_cache_free(void)
+{
+	free(ldc_cache.slots);
+	ldc_cache.slots = NULL;
+	ldc_cache.size = 0;
+	ldc_cache.count = 0;
 }
 
 /** Gets the dictionary entry matching the log entry argument, reads
@@ -700,29 +782,24 @@ out:
  */
 static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_timestamp)
 {
+	uint32_t params[TRACE_MAX_PARAMS_COUNT];
+	const struct ldc_entry *dict_entry;
 	struct ldc_entry entry;
 	int ret;
 
-	ret = read_entry_from_ldc_file(&entry, dma_log->log_entry_address);
-	if (ret < 0) {
-		log_err("read_entry_from_ldc_file(0x%x) returned %d\n",
-			dma_log->log_entry_address, ret);
-		goto out;
+	dict_entry = get_ldc_entry(dma_log->log_entry_address);
+	if (!dict_entry) {
+		log_err("get_ldc_entry(0x%x) failed\n", dma_log->log_entry_address);
+		return -EINVAL;
 	}
 
 	/* fetching entry params from dma dump */
-	if (entry.header.params_num > TRACE_MAX_PARAMS_COUNT) {
+	if (dict_entry->header.params_num > TRACE_MAX_PARAMS_COUNT) {
 		log_err("Invalid number of parameters.\n");
-		ret = -EINVAL;
-		goto out;
-	}
-	entry.params = (uint32_t *)malloc(sizeof(uint32_t) * entry.header.params_num);
-	if (!entry.params) {
-		log_err("can't allocate %d byte for entry.params\n",
-			(int)(sizeof(uint32_t) * entry.header.params_num));
-		ret = -ENOMEM;
-		goto out;
+		return -EINVAL;
 	}
+	entry = *dict_entry;
+	entry.params = params;
 
 	if (global_config->serial_fd < 0) {
 		ret = fread(entry.params, sizeof(uint32_t), entry.header.params_num,
@@ -739,7 +816,7 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 				fprintf(global_config->out_fd,
 					"warn: log's End Of File. Device suspend?\n");
 
-			goto out;
+			return ret;
 		}
 	} else { /* serial */
 		size_t size = sizeof(uint32_t) * entry.header.params_num;
@@ -755,7 +832,7 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 				ret = -errno;
 				log_err("Failed to fread %d params from serial: %s\n",
 					entry.header.params_num, strerror(errno));
-				goto out;
+				return ret;
 			}
 			if (ret != size)
 				log_err("Partial read of %u bytes of %zu, reading more\n",
@@ -767,17 +844,7 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 	print_entry_params(dma_log, &entry, *last_timestamp);
 	*last_timestamp = dma_log->timestamp;
 
-	/* set f_ldc file position to the beginning */
-	rewind(global_config->ldc_fd);
-
-	ret = 0;
-out:
-	/* free alocated memory */
-	free(entry.params);
-	free(entry.text);
-	free(entry.file_name);
-
-	return ret;
+	return 0;
 }
 
 static int serial_read(uint64_t *last_timestamp)
@@ -842,6 +909,9 @@ static int logger_read(void)
 
 	bool ldc_address_OK = false;
 	unsigned int skipped_dwords = 0;
+	uint64_t decoded_entries = 0;
+	struct timespec t_start, t_end;
+	double elapsed;
 
 	if (!global_config->raw_output)
 		print_table_header();
@@ -854,6 +924,8 @@ static int logger_read(void)
 				return ret;
 		}
 
+	clock_gettime(CLOCK_MONOTONIC, &t_start);
+
 	/* One iteration per log statement */
 	while (!ferror(global_config->in_fd)) {
 		/* getting entry parameters from dma dump */
@@ -945,8 +1017,18 @@ static int logger_read(void)
 			log_err("fetch_entry() failed with: %d, aborting\n", ret);
 			break;
 		}
+		decoded_entries++;
 	} /* next log entry */
 
+	if (global_config->benchmark) {
+		clock_gettime(CLOCK_MONOTONIC, &t_end);
+		elapsed = (t_end.tv_sec - t_start.tv_sec) +
+			  (t_end.tv_nsec - t_start.tv_nsec) / 1e9;
+		fprintf(stderr, "benchmark: %llu entries decoded in %.3f s, %.0f entries/s\n",
+			(unsigned long long)decoded_entries, elapsed,
+			elapsed > 0 ? decoded_entries / elapsed : 0.0);
+	}
+
 	/* End of (etrace) file */
 	fprintf(global_config->out_fd,
 		"Skipped %zu bytes after the last statement",
@@ -1048,6 +1130,33 @@ static int dump_ldc_info(void)
 	return 0;
 }
 
+/** Maps the whole dictionary file, log entries are decoded in place.
+ * The mapping is private and writable because file names are shortened
+ * in place, the file itself is never modified.
+ */
+static int map_ldc_file(struct convert_config *config)
+{
+	int fd = fileno(config->ldc_fd);
+	struct stat st;
+	void *data;
+
+	if (fstat(fd, &st) < 0) {
+		log_err("fstat(%s) failed: %s\n", config->ldc_file, strerror(errno));
+		return -errno;
+	}
+
+	data = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		log_err("mmap(%s) failed: %s\n", config->ldc_file, strerror(errno));
+		return -errno;
+	}
+
+	config->ldc_data = data;
+	config->ldc_size = st.st_size;
+
+	return 0;
+}
+
 int convert(void)
 {
 	struct snd_sof_logs_header * const logs_hdr = malloc(sizeof(*logs_hdr));
@@ -1139,7 +1248,14 @@ int convert(void)
 		}
 	}
 
+	ret = map_ldc_file(config);
+	if (ret)
+		goto out;
+
 	ret = logger_read();
+
+	ldc_cache_free();
+	munmap(config->ldc_data, config->ldc_size);
 out:
 	free(config->uids_dict);
 	return ret;
@@ -30,6 +30,8 @@ struct convert_config {
 	int trace;
 	const char *ldc_file;
 	FILE* ldc_fd;
+	void *ldc_data;		/* mapped ldc file */
+	size_t ldc_size;
 	char *filter_config;
 	int input_std;
 	int version_fw;
@@ -42,6 +44,7 @@ struct convert_config {
 	int hide_location;
 	int relative_timestamps;
 	int time_precision;
+	int benchmark;
 	struct snd_sof_uids_header *uids_dict;
 	struct snd_sof_logs_header *logs_header;
 };
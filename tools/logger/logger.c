@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <limits.h>
 #include <errno.h>
+#include <getopt.h>
 #include <string.h>
 #include <ctype.h>
 #include <fcntl.h>
@@ -47,6 +48,11 @@ static const char *debugfs[] = {
 /** See PLATFORM_DEFAULT_CLOCK in the firmware code. */
 static const float DEFAULT_CLOCK_MHZ = 19.2;
 
+/* long only options, values out of the short option range */
+enum {
+	OPT_BENCHMARK = 0x100,
+};
+
 static void usage(void)
 {
 	fprintf(stdout, "Usage %s <option(s)> <file(s)>\n", APP_NAME);
@@ -86,6 +92,8 @@ static void usage(void)
 	fprintf(stdout, "%s:\t -F filter\t\tUpdate trace filter, format: "
 		"<level>=<comp1>[, <comp2>]\n",
 		APP_NAME);
+	fprintf(stdout, "%s:\t --benchmark\t\tReport entries/s decoded from captured infile\n",
+		APP_NAME);
 	exit(0);
 }
 
@@ -288,6 +296,10 @@ struct convert_config * const global_config = &_global_config;
 int main(int argc, char *argv[])
 {
 	static const char optstring[] = "ho:i:l:ps:c:u:tv:rd:Le:f:gF:n";
+	static const struct option long_options[] = {
+		{"benchmark", no_argument, NULL, OPT_BENCHMARK},
+		{NULL, 0, NULL, 0},
+	};
 	struct convert_config config;
 	unsigned int baud = 0;
 	const char *snapshot_file = 0;
@@ -314,8 +326,9 @@ int main(int argc, char *argv[])
 	config.time_precision = 6;
 	config.relative_timestamps = INT_MAX; /* unspecified */
 	config.filter_config = NULL;
+	config.benchmark = 0;
 
-	while ((opt = getopt(argc, argv, optstring)) != -1) {
+	while ((opt = getopt_long(argc, argv, optstring, long_options, NULL)) != -1) {
 		switch (opt) {
 		case 'o':
 			config.out_file = optarg;
@@ -392,6 +405,9 @@ int main(int argc, char *argv[])
 			if (ret < 0)
 				return ret;
 			break;
+		case OPT_BENCHMARK:
+			config.benchmark = 1;
+			break;
 		case 'h':
 		default: /* '?' */
 			usage();
@@ -411,6 +427,11 @@ int main(int argc, char *argv[])
 		usage();
 	}
 
+	if (config.benchmark && (config.trace || baud || !config.in_file)) {
+		fprintf(stderr, "error: --benchmark needs a captured infile\n");
+		usage();
+	}
+
 	config.ldc_fd = fopen(config.ldc_file, "rb");
 	if (!config.ldc_fd) {
 		ret = errno;
@@ -35,6 +35,7 @@ int tb_setup(struct sof *sof, struct testbench_prm *tp)
 	struct ll_schedule_domain domain = {0};
 
 	domain.next_tick = tp->tick_period_us;
+	domain.full_sync = tp->free_running;
 
 	/* init components */
 	sys_comp_init(sof);
@@ -10,6 +10,10 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <rtos/string.h>
 #include <rtos/sof.h>
 #include <sof/list.h>
 #include <sof/audio/stream.h>
@@ -31,107 +35,327 @@ DECLARE_TR_CTX(file_tr, SOF_UUID(file_uuid), LOG_LEVEL_INFO);
 static const struct comp_driver comp_file_dai;
 static const struct comp_driver comp_file_host;
 
+static inline uint32_t file_get_le16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+static inline uint32_t file_get_le32(const uint8_t *p)
+{
+	return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline void file_put_le16(uint8_t *p, uint32_t val)
+{
+	p[0] = val;
+	p[1] = val >> 8;
+}
+
+static inline void file_put_le32(uint8_t *p, uint32_t val)
+{
+	file_put_le16(p, val);
+	file_put_le16(p + 2, val >> 16);
+}
+
 /*
- * Helpers for s24_4le data. To avoid an overflown 24 bit to be taken as valid 32 bit
- * sample mask in file read the 8 most signing bits to zeros. In file write similarly
- * shift the 24 bit word to MSB and possibly overflow it, then shift it back to LSB
- * side to create sign extension.
+ * Walk the RIFF chunks of a WAV file up to the data chunk, the file is left
+ * positioned at the first sample.
  */
+static int file_wav_read_header(FILE *fh, struct file_wav_info *wav)
+{
+	uint8_t fmt[FILE_WAV_FMT_MAX_BYTES];
+	uint8_t hdr[12];
+	uint32_t valid_bits;
+	uint32_t size;
+	long skip;
+	long pos;
+	int container;
+	int tag;
+	bool fmt_found = false;
+
+	if (fread(hdr, 1, 12, fh) != 12 || memcmp(hdr, "RIFF", 4) || memcmp(hdr + 8, "WAVE", 4))
+		return -EINVAL;
+
+	for (;;) {
+		if (fread(hdr, 1, 8, fh) != 8)
+			return -EINVAL;
+
+		size = file_get_le32(hdr + 4);
+		if (!memcmp(hdr, "data", 4))
+			break;
+
+		/* chunks are word aligned */
+		skip = size + (size & 1);
+		if (!memcmp(hdr, "fmt ", 4)) {
+			if (size < 16 || size > sizeof(fmt) || fread(fmt, 1, size, fh) != size)
+				return -EINVAL;
+
+			fmt_found = true;
+			skip = size & 1;
+		}
+
+		if (fseek(fh, skip, SEEK_CUR))
+			return -EINVAL;
+	}
+
+	pos = ftell(fh);
+	if (!fmt_found || pos < 0)
+		return -EINVAL;
+
+	tag = file_get_le16(fmt);
+	wav->channels = file_get_le16(fmt + 2);
+	wav->rate = file_get_le32(fmt + 4);
+	valid_bits = file_get_le16(fmt + 14);
+	if (!wav->channels || wav->channels > SOF_IPC_MAX_CHANNELS)
+		return -EINVAL;
 
-static void mask_sink_s24(const struct audio_stream *sink, int samples)
+	container = file_get_le16(fmt + 12) / wav->channels;
+	if (tag == FILE_WAV_FORMAT_EXTENSIBLE && file_get_le16(fmt + 16) >= 22) {
+		valid_bits = file_get_le16(fmt + 18);
+		tag = file_get_le16(fmt + 24);
+	}
+
+	if (tag != FILE_WAV_FORMAT_PCM)
+		return -ENOTSUP;
+
+	if (container == 2 && valid_bits == 16)
+		wav->frame_fmt = SOF_IPC_FRAME_S16_LE;
+	else if ((container == 3 || container == 4) && valid_bits == 24)
+		wav->frame_fmt = SOF_IPC_FRAME_S24_4LE;
+	else if (container == 4 && valid_bits == 32)
+		wav->frame_fmt = SOF_IPC_FRAME_S32_LE;
+	else
+		return -ENOTSUP;
+
+	wav->sample_bytes = container;
+	wav->valid_bits = valid_bits;
+	wav->data_offset = pos;
+
+	/* zero or all ones size of unfinished or streamed files, data up to EOF */
+	wav->data_size = size && size != UINT32_MAX ? size : SIZE_MAX;
+
+	return 0;
+}
+
+int file_wav_get_info(const char *fn, struct file_wav_info *wav)
 {
-	int32_t *snk = (int32_t *)sink->w_ptr;
-	size_t bytes = samples * sizeof(int32_t);
-	size_t bytes_snk;
-	int samples_avail;
-	int i;
+	FILE *fh;
+	int ret;
 
-	while (bytes) {
-		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_snk));
-		for (i = 0; i < samples_avail; i++)
-			*snk++ &= 0x00ffffff;
+	fh = fopen(fn, "r");
+	if (!fh)
+		return -errno;
 
-		bytes -= samples * sizeof(int32_t);
-		snk = audio_stream_wrap(sink, snk);
+	ret = file_wav_read_header(fh, wav);
+	fclose(fh);
+
+	return ret;
+}
+
+/*
+ * WAV header of written file, updated with the data size when file is closed.
+ * Samples with less valid bits than the container need the extensible format.
+ */
+static int file_wav_write_header(struct file_state *fs, uint32_t data_bytes)
+{
+	static const uint8_t subformat_pcm[16] = {
+		0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+		0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71,
+	};
+	uint8_t hdr[FILE_WAV_EXT_HEADER_BYTES];
+	uint32_t block_align = fs->wav.channels * fs->wav.sample_bytes;
+	bool extensible = fs->wav.valid_bits != fs->wav.sample_bytes * 8;
+	size_t hdr_bytes = extensible ? FILE_WAV_EXT_HEADER_BYTES : FILE_WAV_HEADER_BYTES;
+	uint8_t *data_hdr = hdr + hdr_bytes - 8;
+
+	memcpy_s(hdr, sizeof(hdr), "RIFF", 4);
+	file_put_le32(hdr + 4, hdr_bytes - 8 + data_bytes);
+	memcpy_s(hdr + 8, sizeof(hdr) - 8, "WAVEfmt ", 8);
+	file_put_le32(hdr + 16, hdr_bytes - 28);
+	file_put_le16(hdr + 20, extensible ? FILE_WAV_FORMAT_EXTENSIBLE : FILE_WAV_FORMAT_PCM);
+	file_put_le16(hdr + 22, fs->wav.channels);
+	file_put_le32(hdr + 24, fs->wav.rate);
+	file_put_le32(hdr + 28, fs->wav.rate * block_align);
+	file_put_le16(hdr + 32, block_align);
+	file_put_le16(hdr + 34, fs->wav.sample_bytes * 8);
+	if (extensible) {
+		file_put_le16(hdr + 36, 22);
+		file_put_le16(hdr + 38, fs->wav.valid_bits);
+		file_put_le32(hdr + 40, 0); /* no speaker positions */
+		memcpy_s(hdr + 44, sizeof(hdr) - 44, subformat_pcm, sizeof(subformat_pcm));
 	}
+
+	memcpy_s(data_hdr, 4, "data", 4);
+	file_put_le32(data_hdr + 4, data_bytes);
+
+	fs->wav.data_offset = hdr_bytes;
+	if (fseek(fs->wfh, 0, SEEK_SET) ||
+	    fwrite(hdr, hdr_bytes, 1, fs->wfh) != 1 ||
+	    fseek(fs->wfh, 0, SEEK_END))
+		return -EIO;
+
+	return 0;
 }
 
-static void sign_extend_source_s24(const struct audio_stream *source, int samples)
+/*
+ * Map a regular input file so that samples are copied straight from the page
+ * cache into the stream. Other files, e.g. pipes, are read with fread().
+ */
+static void file_map_input(struct file_state *fs)
 {
-	int32_t tmp;
-	int32_t *src = (int32_t *)source->r_ptr;
-	size_t bytes = samples * sizeof(int32_t);
-	size_t bytes_src;
-	int samples_avail;
+	struct stat st;
+	void *map;
+
+	if (fstat(fileno(fs->rfh), &st) < 0 || !S_ISREG(st.st_mode) || !st.st_size)
+		return;
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fs->rfh), 0);
+	if (map == MAP_FAILED)
+		return;
+
+	madvise(map, st.st_size, MADV_SEQUENTIAL);
+	fs->map = map;
+	fs->map_size = st.st_size;
+	fs->data_end = MIN(fs->data_end, fs->map_size);
+}
+
+/*
+ * Get the next block of input file bytes, directly from the mapped file or
+ * via the conversion block buffer. Returns the count of bytes of the whole
+ * samples available, a partial sample at the end of file is reported and
+ * ends the input.
+ */
+static size_t file_read_block(struct file_state *fs, const uint8_t **data, size_t bytes)
+{
+	size_t n = MIN(bytes, fs->data_end - fs->data_pos);
+	size_t partial;
+
+	if (fs->map) {
+		*data = fs->map + fs->data_pos;
+	} else {
+		*data = fs->block;
+		n = fread(fs->block, 1, MIN(n, FILE_BLOCK_BYTES), fs->rfh);
+	}
+
+	partial = n % fs->sample_bytes;
+	if (partial) {
+		fprintf(stderr, "warning: ignored %zu bytes of a partial sample at end of %s\n",
+			partial, fs->fn);
+		n -= partial;
+		fs->data_end = fs->data_pos + n;
+	}
+
+	fs->data_pos += n;
+	return n;
+}
+
+/*
+ * Convert samples from file to stream format. To avoid an overflown 24 bit
+ * sample to be taken as valid 32 bit sample the 8 most significant bits of
+ * s24_4le samples are masked to zeros. In WAV files the 24 bits are MSB
+ * justified in a 32 bit container and are shifted down with sign extension.
+ */
+static void file_to_stream(struct file_state *fs, void *dst, const uint8_t *src, int samples,
+			   int fmt)
+{
+	int32_t *dst32 = dst;
 	int i;
 
-	while (bytes) {
-		bytes_src = audio_stream_bytes_without_wrap(source, src);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
-		for (i = 0; i < samples_avail; i++) {
-			tmp = *src << 8;
-			*src++ = tmp >> 8;
-		}
+	if (fs->sample_bytes == 3) {
+		for (i = 0; i < samples; i++, src += 3)
+			dst32[i] = src[0] | src[1] << 8 | src[2] << 16;
+	} else if (fmt == SOF_IPC_FRAME_S24_4LE && fs->f_format == FILE_WAV) {
+		for (i = 0; i < samples; i++, src += 4)
+			dst32[i] = (int32_t)file_get_le32(src) >> 8;
+	} else if (fmt == SOF_IPC_FRAME_S24_4LE) {
+		for (i = 0; i < samples; i++, src += 4)
+			dst32[i] = file_get_le32(src) & 0x00ffffff;
+	} else {
+		memcpy_s(dst, samples * fs->sample_bytes, src, samples * fs->sample_bytes);
+	}
+}
 
-		bytes -= samples * sizeof(int32_t);
-		src = audio_stream_wrap(source, src);
+/*
+ * Convert s24_4le samples from stream to file format. For binary files the
+ * samples are shifted to MSB and back to LSB side to create sign extension.
+ * WAV files keep the samples MSB justified in the 32 bit container.
+ */
+static void stream_to_file(struct file_state *fs, uint8_t *dst, const int32_t *src, int samples)
+{
+	int i;
+
+	if (fs->f_format == FILE_WAV) {
+		for (i = 0; i < samples; i++, dst += 4)
+			file_put_le32(dst, (uint32_t)src[i] << 8);
+	} else {
+		for (i = 0; i < samples; i++, dst += 4)
+			file_put_le32(dst, (int32_t)((uint32_t)src[i] << 8) >> 8);
 	}
 }
 
 /*
- * Read 32-bit samples from binary file
+ * Read samples from binary or WAV file, in blocks of the contiguous sink
+ * buffer space.
  */
-static int read_binary_s32(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
+static int read_binary(struct file_comp_data *cd, const struct audio_stream *sink, int samples,
+		       int fmt)
 {
-	int32_t *snk = (int32_t *)sink->w_ptr;
-	size_t samples_avail;
+	struct file_state *fs = &cd->fs;
+	uint8_t *snk = sink->w_ptr;
+	const uint8_t *data;
 	size_t bytes_snk;
-	size_t bytes = samples * sizeof(int32_t);
-	int ret;
 	int samples_copied = 0;
+	int n;
 
-	while (bytes) {
+	while (samples_copied < samples) {
 		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_snk));
-		ret = fread(snk, sizeof(int32_t), samples_avail, cd->fs.rfh);
-		if (!ret) {
-			cd->fs.reached_eof = 1;
+		n = MIN(samples - samples_copied, bytes_snk / cd->sample_container_bytes);
+		n = file_read_block(fs, &data, n * fs->sample_bytes) / fs->sample_bytes;
+		if (!n) {
+			fs->reached_eof = true;
 			return samples_copied;
 		}
 
-		samples_copied += ret;
-		bytes -= ret * sizeof(int32_t);
-		snk = audio_stream_wrap(sink, snk + ret);
+		file_to_stream(fs, snk, data, n, fmt);
+		samples_copied += n;
+		snk = audio_stream_wrap(sink, snk + n * cd->sample_container_bytes);
 	}
 
 	return samples_copied;
 }
 
 /*
- * Write 32-bit samples to binary file
+ * Write samples to binary or WAV file, straight from the source buffer or
+ * via the block buffer when the format needs conversion.
  */
-static int write_binary_s32(struct file_comp_data *cd, const struct audio_stream *source,
-			    int samples)
+static int write_binary(struct file_comp_data *cd, const struct audio_stream *source,
+			int samples, int fmt)
 {
-	int32_t *src = (int32_t *)source->r_ptr;
-	size_t samples_avail;
+	struct file_state *fs = &cd->fs;
+	uint8_t *src = source->r_ptr;
 	size_t bytes_src;
-	size_t bytes = samples * sizeof(int32_t);
-	int ret;
+	size_t ret;
 	int samples_copied = 0;
+	int n;
 
-	while (bytes) {
+	while (samples_copied < samples) {
 		bytes_src = audio_stream_bytes_without_wrap(source, src);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
-		ret = fwrite(src, sizeof(int32_t), samples_avail, cd->fs.wfh);
-		if (ret == 0) {
-			cd->fs.write_failed = true;
+		n = MIN(samples - samples_copied, bytes_src / cd->sample_container_bytes);
+		if (fmt == SOF_IPC_FRAME_S24_4LE) {
+			n = MIN(n, FILE_BLOCK_BYTES / fs->sample_bytes);
+			stream_to_file(fs, fs->block, (int32_t *)src, n);
+			ret = fwrite(fs->block, fs->sample_bytes, n, fs->wfh);
+		} else {
+			ret = fwrite(src, fs->sample_bytes, n, fs->wfh);
+		}
+
+		if (!ret) {
+			fs->write_failed = true;
 			return samples_copied;
 		}
+
 		samples_copied += ret;
-		bytes -= ret * sizeof(int32_t);
-		src = audio_stream_wrap(source, src + ret);
+		src = audio_stream_wrap(source, src + ret * cd->sample_container_bytes);
 	}
 
 	return samples_copied;
@@ -140,11 +364,13 @@ static int write_binary_s32(struct file_comp_data *cd, const struct audio_stream
 /*
  * Read 32-bit samples from text file
  */
-static int read_text_s32(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
+static int read_text_s32(struct file_comp_data *cd, const struct audio_stream *sink, int samples,
+			 int fmt)
 {
 	int32_t *snk = (int32_t *)sink->w_ptr;
 	size_t bytes = samples * sizeof(int32_t);
 	size_t bytes_snk;
+	int32_t mask = fmt == SOF_IPC_FRAME_S24_4LE ? 0x00ffffff : -1;
 	int ret;
 	int i;
 	int samples_copied = 0;
@@ -153,11 +379,12 @@ static int read_text_s32(struct file_comp_data *cd, const struct audio_stream *s
 		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
 		samples = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_snk));
 		for (i = 0; i < samples; i++) {
-			ret = fscanf(cd->fs.rfh, "%d", snk++);
+			ret = fscanf(cd->fs.rfh, "%d", snk);
 			if (ret == EOF) {
 				cd->fs.reached_eof = 1;
 				return samples_copied;
 			}
+			*snk++ &= mask;
 			samples_copied++;
 			bytes -= sizeof(int32_t);
 		}
@@ -170,11 +397,13 @@ static int read_text_s32(struct file_comp_data *cd, const struct audio_stream *s
 /*
  * Write 32-bit samples to text file
  */
-static int write_text_s32(struct file_comp_data *cd, const struct audio_stream *source, int samples)
+static int write_text_s32(struct file_comp_data *cd, const struct audio_stream *source,
+			  int samples, int fmt)
 {
 	int32_t *src = (int32_t *)source->r_ptr;
 	size_t bytes = samples * sizeof(int32_t);
 	size_t bytes_src;
+	int shift = fmt == SOF_IPC_FRAME_S24_4LE ? 8 : 0;
 	int ret;
 	int i;
 	int samples_copied = 0;
@@ -183,7 +412,8 @@ static int write_text_s32(struct file_comp_data *cd, const struct audio_stream *
 		bytes_src = audio_stream_bytes_without_wrap(source, src);
 		samples = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
 		for (i = 0; i < samples; i++) {
-			ret = fprintf(cd->fs.wfh, "%d\n", *src++);
+			ret = fprintf(cd->fs.wfh, "%d\n",
+				      (int32_t)((uint32_t)*src++ << shift) >> shift);
 			if (ret < 1) {
 				cd->fs.write_failed = true;
 				return samples_copied;
@@ -200,25 +430,17 @@ static int write_text_s32(struct file_comp_data *cd, const struct audio_stream *
 static int read_samples_s32(struct file_comp_data *cd, const struct audio_stream *sink,
 			    int samples, int fmt)
 {
-	int n_samples = 0;
-
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s32(cd, sink, samples);
-		break;
+	case FILE_WAV:
+		/* binary input file */
+		return read_binary(cd, sink, samples, fmt);
 	case FILE_TEXT:
 		/* text input file */
-		n_samples = read_text_s32(cd, sink, samples);
-		break;
+		return read_text_s32(cd, sink, samples, fmt);
 	default:
 		return -EINVAL;
 	}
-
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		mask_sink_s24(sink, samples);
-
-	return n_samples;
 }
 
 /*
@@ -227,84 +449,17 @@ static int read_samples_s32(struct file_comp_data *cd, const struct audio_stream
 static int write_samples_s32(struct file_comp_data *cd, struct audio_stream *source, int samples,
 			     int fmt)
 {
-	int samples_written;
-
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		sign_extend_source_s24(source, samples);
-
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		samples_written = write_binary_s32(cd, source, samples);
-		break;
+	case FILE_WAV:
+		/* binary output file */
+		return write_binary(cd, source, samples, fmt);
 	case FILE_TEXT:
-		/* text input file */
-		samples_written = write_text_s32(cd, source, samples);
-		break;
+		/* text output file */
+		return write_text_s32(cd, source, samples, fmt);
 	default:
 		return -EINVAL;
 	}
-
-	return samples_written;
-}
-
-/*
- * Read 16-bit samples from binary file
- */
-static int read_binary_s16(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
-{
-	int16_t *snk = (int16_t *)sink->w_ptr;
-	size_t samples_avail;
-	size_t bytes_snk;
-	size_t bytes = samples * sizeof(int16_t);
-	int ret;
-	int samples_copied = 0;
-
-	while (bytes) {
-		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
-		samples_avail = FILE_BYTES_TO_S16_SAMPLES(MIN(bytes, bytes_snk));
-		ret = fread(snk, sizeof(int16_t), samples_avail, cd->fs.rfh);
-		if (!ret) {
-			cd->fs.reached_eof = 1;
-			return samples_copied;
-		}
-
-		samples_copied += ret;
-		bytes -= ret * sizeof(int16_t);
-		snk = audio_stream_wrap(sink, snk + ret);
-	}
-
-	return samples_copied;
-}
-
-/*
- * Write 16-bit samples to binary file
- */
-static int write_binary_s16(struct file_comp_data *cd, const struct audio_stream *source,
-			    int samples)
-{
-	int16_t *src = (int16_t *)source->r_ptr;
-	size_t samples_avail;
-	size_t bytes_src;
-	size_t bytes = samples * sizeof(int16_t);
-	int ret;
-	int samples_copied = 0;
-
-	while (bytes) {
-		bytes_src = audio_stream_bytes_without_wrap(source, src);
-		samples_avail = FILE_BYTES_TO_S16_SAMPLES(MIN(bytes, bytes_src));
-		ret = fwrite(src, sizeof(int16_t), samples_avail, cd->fs.wfh);
-		if (!ret) {
-			cd->fs.write_failed = true;
-			return samples_copied;
-		}
-
-		samples_copied += ret;
-		bytes -= ret * sizeof(int16_t);
-		src = audio_stream_wrap(source, src + ret);
-	}
-
-	return samples_copied;
 }
 
 /*
@@ -369,22 +524,17 @@ static int write_text_s16(struct file_comp_data *cd, const struct audio_stream *
 
 static int read_samples_s16(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
 {
-	int n_samples = 0;
-
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s16(cd, sink, samples);
-		break;
+	case FILE_WAV:
+		/* binary input file */
+		return read_binary(cd, sink, samples, SOF_IPC_FRAME_S16_LE);
 	case FILE_TEXT:
 		/* text input file */
-		n_samples = read_text_s16(cd, sink, samples);
-		break;
+		return read_text_s16(cd, sink, samples);
 	default:
 		return -EINVAL;
 	}
-
-	return n_samples;
 }
 
 /*
@@ -392,22 +542,17 @@ static int read_samples_s16(struct file_comp_data *cd, const struct audio_stream
  */
 static int write_samples_s16(struct file_comp_data *cd, struct audio_stream *source, int samples)
 {
-	int samples_written;
-
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		samples_written = write_binary_s16(cd, source, samples);
-		break;
+	case FILE_WAV:
+		/* binary output file */
+		return write_binary(cd, source, samples, SOF_IPC_FRAME_S16_LE);
 	case FILE_TEXT:
-		/* text input file */
-		samples_written = write_text_s16(cd, source, samples);
-		break;
+		/* text output file */
+		return write_text_s16(cd, source, samples);
 	default:
 		return -EINVAL;
 	}
-
-	return samples_written;
 }
 
 /* Default file copy function, just return error if called */
@@ -519,9 +664,9 @@ static int file_s24(struct comp_dev *dev, struct audio_stream *sink,
 	return n_samples;
 }
 
-static enum file_format get_file_format(char *filename)
+enum file_format get_file_format(const char *filename)
 {
-	char *ext = strrchr(filename, '.');
+	const char *ext = strrchr(filename, '.');
 
 	if (!ext)
 		return FILE_RAW;
@@ -529,6 +674,9 @@ static enum file_format get_file_format(char *filename)
 	if (!strcmp(ext, ".txt"))
 		return FILE_TEXT;
 
+	if (!strcmp(ext, ".wav"))
+		return FILE_WAV;
+
 	return FILE_RAW;
 }
 
@@ -542,6 +690,7 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	struct dai_data *dd;
 	struct dai *fdai;
 	struct file_comp_data *cd;
+	int ret;
 
 	debug_print("file_new()\n");
 
@@ -589,7 +738,13 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	cd->frame_fmt = ipc_file->frame_fmt;
 	dev->direction = ipc_file->direction;
 
-	/* open file handle(s) depending on mode */
+	/* block buffer for format conversions and larger stdio buffer */
+	cd->fs.block = malloc(FILE_BLOCK_BYTES);
+	cd->fs.stdio_buf = malloc(FILE_BLOCK_BYTES);
+	if (!cd->fs.block || !cd->fs.stdio_buf)
+		goto error;
+
+	/* open file handle(s) depending on mode, buffer set before any I/O */
 	switch (cd->fs.mode) {
 	case FILE_READ:
 		cd->fs.rfh = fopen(cd->fs.fn, "r");
@@ -598,6 +753,25 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 				cd->fs.fn, strerror(errno));
 			goto error;
 		}
+
+		setvbuf(cd->fs.rfh, cd->fs.stdio_buf, _IOFBF, FILE_BLOCK_BYTES);
+
+		cd->fs.data_end = SIZE_MAX;
+		if (cd->fs.f_format == FILE_WAV) {
+			ret = file_wav_read_header(cd->fs.rfh, &cd->fs.wav);
+			if (ret < 0) {
+				fprintf(stderr, "error: file %s is not a supported WAV file\n",
+					cd->fs.fn);
+				goto error_close;
+			}
+
+			cd->fs.data_pos = cd->fs.wav.data_offset;
+			if (cd->fs.wav.data_size < SIZE_MAX - cd->fs.data_pos)
+				cd->fs.data_end = cd->fs.data_pos + cd->fs.wav.data_size;
+		}
+
+		if (cd->fs.f_format != FILE_TEXT)
+			file_map_input(&cd->fs);
 		break;
 	case FILE_WRITE:
 		cd->fs.wfh = fopen(cd->fs.fn, "w+");
@@ -606,6 +780,8 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 				cd->fs.fn, strerror(errno));
 			goto error;
 		}
+
+		setvbuf(cd->fs.wfh, cd->fs.stdio_buf, _IOFBF, FILE_BLOCK_BYTES);
 		break;
 	default:
 		/* TODO: duplex mode */
@@ -620,7 +796,19 @@ static struct comp_dev *file_new(const struct comp_driver *drv,
 	dev->state = COMP_STATE_READY;
 	return dev;
 
+error_close:
+	if (cd->fs.map)
+		munmap(cd->fs.map, cd->fs.map_size);
+
+	if (cd->fs.mode == FILE_READ)
+		fclose(cd->fs.rfh);
+	else
+		fclose(cd->fs.wfh);
+
 error:
+	free(cd->fs.stdio_buf);
+	free(cd->fs.block);
+	free(cd->fs.fn);
 	free(cd);
 
 error_skip_cd:
@@ -641,14 +829,27 @@ static void file_free(struct comp_dev *dev)
 {
 	struct dai_data *dd = comp_get_drvdata(dev);
 	struct file_comp_data *cd = comp_get_drvdata(dd->dai);
+	long data_bytes;
 
 	comp_dbg(dev, "file_free()");
 
+	if (cd->fs.map)
+		munmap(cd->fs.map, cd->fs.map_size);
+
+	/* complete WAV header with the written data size */
+	if (cd->fs.mode == FILE_WRITE && cd->fs.wav_header_written) {
+		data_bytes = ftell(cd->fs.wfh) - cd->fs.wav.data_offset;
+		if (data_bytes < 0 || file_wav_write_header(&cd->fs, data_bytes) < 0)
+			fprintf(stderr, "error: failed to update WAV header of %s\n", cd->fs.fn);
+	}
+
 	if (cd->fs.mode == FILE_READ)
 		fclose(cd->fs.rfh);
 	else
 		fclose(cd->fs.wfh);
 
+	free(cd->fs.stdio_buf);
+	free(cd->fs.block);
 	free(cd->fs.fn);
 	free(cd);
 	free((void *)dd->dai->drv);
@@ -757,8 +958,41 @@ static int file_params(struct comp_dev *dev,
 	}
 
 	cd->sample_container_bytes = get_sample_bytes(stream->frame_fmt);
+	cd->fs.sample_bytes = cd->sample_container_bytes;
 	buffer_reset_pos(buffer, NULL);
 
+	if (cd->fs.f_format != FILE_WAV)
+		return 0;
+
+	if (cd->fs.mode == FILE_READ) {
+		/* samples are read as is, stream must be in the format of the file */
+		if (stream->frame_fmt != cd->fs.wav.frame_fmt ||
+		    stream->channels != cd->fs.wav.channels) {
+			fprintf(stderr, "error: format of %s does not match stream\n", cd->fs.fn);
+			return -EINVAL;
+		}
+
+		cd->fs.sample_bytes = cd->fs.wav.sample_bytes;
+		return 0;
+	}
+
+	/* 24 bit samples are written MSB justified in 32 bit containers */
+	cd->fs.wav.rate = stream->rate;
+	cd->fs.wav.channels = stream->channels;
+	cd->fs.wav.frame_fmt = stream->frame_fmt;
+	cd->fs.wav.sample_bytes = cd->fs.sample_bytes;
+	cd->fs.wav.valid_bits = stream->frame_fmt == SOF_IPC_FRAME_S24_4LE ?
+				24 : cd->fs.sample_bytes * 8;
+	if (!cd->fs.wav_header_written) {
+		ret = file_wav_write_header(&cd->fs, 0);
+		if (ret < 0) {
+			fprintf(stderr, "error: failed to write WAV header to %s\n", cd->fs.fn);
+			return ret;
+		}
+
+		cd->fs.wav_header_written = true;
+	}
+
 	return 0;
 }
 
@@ -52,6 +52,10 @@ struct testbench_prm {
 	int copy_iterations;
 	bool copy_check;
 	bool quiet;
+	bool free_running; /* tick LL scheduler from tester thread, no pacing */
+	bool profile; /* profile copy() of each component */
+	char *profile_file; /* optional CSV or JSON profile output */
+	char *mixer_bench; /* source counts for mixer kernel benchmark */
 	int dynamic_pipeline_iterations;
 	int num_vcores;
 	int tick_period_us;
@@ -25,6 +25,27 @@ enum file_mode {
 enum file_format {
 	FILE_TEXT = 0,
 	FILE_RAW,
+	FILE_WAV,
+};
+
+/* Block size for file data format conversions, multiple of 2, 3 and 4 */
+#define FILE_BLOCK_BYTES	(12 * 4096)
+
+/* RIFF WAV file format */
+#define FILE_WAV_FORMAT_PCM		1
+#define FILE_WAV_FORMAT_EXTENSIBLE	0xfffe
+#define FILE_WAV_FMT_MAX_BYTES		64	/* max fmt chunk size */
+#define FILE_WAV_HEADER_BYTES		44	/* header of written PCM files */
+#define FILE_WAV_EXT_HEADER_BYTES	68	/* header of written extensible files */
+
+struct file_wav_info {
+	uint32_t rate;
+	uint32_t channels;
+	enum sof_ipc_frame frame_fmt;
+	int sample_bytes;	/* bytes of a sample in file, 2, 3 or 4 */
+	int valid_bits;		/* valid bits of a sample, MSB justified */
+	size_t data_offset;	/* file offset of first sample */
+	size_t data_size;	/* bytes of samples, SIZE_MAX if up to EOF */
 };
 
 /* file component state */
@@ -37,6 +58,15 @@ struct file_state {
 	enum file_mode mode;
 	enum file_format f_format;
 	int copy_count;
+	int sample_bytes;	/* bytes of a sample in file */
+	uint8_t *block;		/* block buffer for format conversions */
+	char *stdio_buf;	/* stdio buffer of the file handle */
+	uint8_t *map;		/* mapped input file, NULL if read with stdio */
+	size_t map_size;
+	size_t data_pos;	/* input file offset of next sample */
+	size_t data_end;	/* input file offset of end of samples */
+	struct file_wav_info wav;
+	bool wav_header_written;
 };
 
 /* file comp data */
@@ -54,4 +84,8 @@ struct file_comp_data {
 	int max_copies;
 };
 
+enum file_format get_file_format(const char *filename);
+
+int file_wav_get_info(const char *fn, struct file_wav_info *wav);
+
 #endif
@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _MIXER_BENCH_H
+#define _MIXER_BENCH_H
+
+#include <stdint.h>
+
+/* max number of source counts benchmarked in one run */
+#define TB_MIXER_BENCH_MAX_CASES	8
+
+struct tb_mixer_bench {
+	const char *library;	/* mixer component library */
+	int num_sources[TB_MIXER_BENCH_MAX_CASES];
+	int num_cases;
+	int frame_fmt;		/* benchmarked format, -1 for all mixer formats */
+	int channels;
+	int rate;
+	int duration_ms;	/* audio time mixed per case */
+};
+
+int tb_mixer_bench_parse(struct tb_mixer_bench *mb, char *sources);
+
+int tb_mixer_bench_run(const struct tb_mixer_bench *mb);
+
+#endif
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2023 Intel Corporation. All rights reserved.
+ */
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include <stdbool.h>
+
+/* max number of components profiled */
+#define TB_PROFILE_MAX_COMPS	128
+
+/* initial per component capacity of recorded copy() times */
+#define TB_PROFILE_INIT_SAMPLES	1024
+
+void tb_profile_enable(bool enable);
+
+void tb_profile_print(void);
+
+int tb_profile_write(const char *file_name);
+
+void tb_profile_free(void);
+
+#endif
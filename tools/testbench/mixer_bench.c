@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/*
+ * Mixer kernel benchmark for testbench. Mixes N streams of random audio
+ * with the processing functions of the mixer component library, one 1 ms
+ * period at a time, and reports the time used per period. The source and
+ * sink ring buffers have different sizes so that the kernels see spans
+ * that wrap at different positions, and the first periods are checked
+ * against a plain C reference of the saturated sum.
+ */
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/format.h>
+#include <sof/audio/mixer.h>
+#include "testbench/mixer_bench.h"
+
+/* periods checked against the reference before timing */
+#define TB_MIXER_BENCH_VERIFY_PERIODS	16
+
+struct tb_mixer_bench_fmt {
+	enum sof_ipc_frame frame_fmt;
+	const char *name;
+};
+
+static const struct tb_mixer_bench_fmt bench_formats[] = {
+	{ SOF_IPC_FRAME_S16_LE, "S16_LE" },
+	{ SOF_IPC_FRAME_S24_4LE, "S24_LE" },
+	{ SOF_IPC_FRAME_S32_LE, "S32_LE" },
+};
+
+int tb_mixer_bench_parse(struct tb_mixer_bench *mb, char *sources)
+{
+	char *source_token = NULL;
+	char *token = strtok_r(sources, ",", &source_token);
+	int index;
+
+	for (index = 0; index < TB_MIXER_BENCH_MAX_CASES && token; index++) {
+		mb->num_sources[index] = atoi(token);
+		if (mb->num_sources[index] < 1 ||
+		    mb->num_sources[index] > PLATFORM_MAX_CHANNELS) {
+			fprintf(stderr, "error: mixer sources must be 1 to %d\n",
+				PLATFORM_MAX_CHANNELS);
+			return -EINVAL;
+		}
+
+		token = strtok_r(NULL, ",", &source_token);
+	}
+
+	if (index == TB_MIXER_BENCH_MAX_CASES && token) {
+		fprintf(stderr, "error: max mixer benchmark cases is %d\n",
+			TB_MIXER_BENCH_MAX_CASES);
+		return -EINVAL;
+	}
+
+	mb->num_cases = index;
+	return 0;
+}
+
+static uint64_t bench_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void *bench_ptr(const struct audio_stream *stream, void *ptr, size_t bytes)
+{
+	return audio_stream_wrap(stream, (char *)ptr + bytes);
+}
+
+/* sample value as the mixer adds it, k samples after ptr */
+static int32_t bench_read(const struct audio_stream *stream, void *ptr, int k)
+{
+	void *sample = bench_ptr(stream, ptr, k * audio_stream_sample_bytes(stream));
+
+	switch (stream->frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return *(int16_t *)sample;
+	case SOF_IPC_FRAME_S24_4LE:
+		return sign_extend_s24(*(int32_t *)sample);
+	default:
+		return *(int32_t *)sample;
+	}
+}
+
+static int32_t bench_sat(enum sof_ipc_frame frame_fmt, int64_t sum)
+{
+	switch (frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return sat_int16(sum);
+	case SOF_IPC_FRAME_S24_4LE:
+		return sat_int24(sum);
+	default:
+		return sat_int32(sum);
+	}
+}
+
+/* compare one mixed period with the saturated sum of the sources */
+static int bench_verify(struct audio_stream *sink, struct audio_stream *sources,
+			int num_sources, int samples)
+{
+	int64_t sum;
+	int32_t out;
+	int errors = 0;
+	int i, j;
+
+	for (i = 0; i < samples; i++) {
+		sum = 0;
+		for (j = 0; j < num_sources; j++)
+			sum += bench_read(&sources[j], sources[j].r_ptr, i);
+
+		/* 24 bit results are stored sign extended */
+		out = sink->frame_fmt == SOF_IPC_FRAME_S16_LE ?
+			*(int16_t *)bench_ptr(sink, sink->w_ptr, i * sizeof(int16_t)) :
+			*(int32_t *)bench_ptr(sink, sink->w_ptr, i * sizeof(int32_t));
+		if (out != bench_sat(sink->frame_fmt, sum))
+			errors++;
+	}
+
+	return errors;
+}
+
+static int bench_case(const struct tb_mixer_bench *mb, const struct mixer_func_map *map,
+		      const char *fmt_name, int num_sources)
+{
+	const struct audio_stream *source_ptr[PLATFORM_MAX_CHANNELS];
+	struct audio_stream sources[PLATFORM_MAX_CHANNELS];
+	struct audio_stream sink;
+	uint64_t max_ns = 0;
+	uint64_t total_ns = 0;
+	uint64_t start;
+	uint64_t ns;
+	size_t sample_bytes = get_sample_bytes(map->frame_fmt);
+	size_t frame_bytes = sample_bytes * mb->channels;
+	size_t period_bytes;
+	size_t bytes;
+	int frames = mb->rate / 1000;
+	int errors = 0;
+	int ret = 0;
+	int i, j;
+
+	if (!frames)
+		return -EINVAL;
+
+	period_bytes = frames * frame_bytes;
+	memset(sources, 0, sizeof(sources));
+	memset(&sink, 0, sizeof(sink));
+
+	/* sources wrap at different positions, random data saturates often */
+	for (j = 0; j < num_sources; j++) {
+		bytes = 2 * period_bytes + 2 * (j + 1) * frame_bytes;
+		audio_stream_init(&sources[j], malloc(bytes), bytes);
+		if (!sources[j].addr) {
+			ret = -ENOMEM;
+			goto out;
+		}
+
+		for (i = 0; i < bytes / sizeof(int16_t); i++)
+			((int16_t *)sources[j].addr)[i] = rand();
+
+		sources[j].frame_fmt = map->frame_fmt;
+		sources[j].channels = mb->channels;
+		sources[j].rate = mb->rate;
+		source_ptr[j] = &sources[j];
+	}
+
+	bytes = 3 * period_bytes + frame_bytes;
+	audio_stream_init(&sink, malloc(bytes), bytes);
+	if (!sink.addr) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	sink.frame_fmt = map->frame_fmt;
+	sink.channels = mb->channels;
+	sink.rate = mb->rate;
+
+	for (i = 0; i < TB_MIXER_BENCH_VERIFY_PERIODS + mb->duration_ms; i++) {
+		start = bench_ns();
+		map->func(NULL, &sink, source_ptr, num_sources, frames);
+		ns = bench_ns() - start;
+
+		if (i < TB_MIXER_BENCH_VERIFY_PERIODS) {
+			errors += bench_verify(&sink, sources, num_sources,
+					       frames * mb->channels);
+		} else {
+			total_ns += ns;
+			max_ns = MAX(max_ns, ns);
+		}
+
+		sink.w_ptr = bench_ptr(&sink, sink.w_ptr, period_bytes);
+		for (j = 0; j < num_sources; j++)
+			sources[j].r_ptr = bench_ptr(&sources[j], sources[j].r_ptr,
+						     period_bytes);
+	}
+
+	printf("mixer %s %d sources %d ch %d Hz: %.2f ns/frame, ",
+	       fmt_name, num_sources, mb->channels, mb->rate,
+	       (double)total_ns / ((uint64_t)mb->duration_ms * frames));
+	printf("avg %.2f us max %.2f us per 1 ms, %.2f%% of a core",
+	       total_ns / 1000.0 / mb->duration_ms, max_ns / 1000.0,
+	       total_ns / 10000.0 / mb->duration_ms);
+	if (errors) {
+		printf(", %d samples mismatch\n", errors);
+		ret = -EINVAL;
+	} else {
+		printf("\n");
+	}
+
+out:
+	free(sink.addr);
+	for (j = 0; j < num_sources; j++)
+		free(sources[j].addr);
+
+	return ret;
+}
+
+int tb_mixer_bench_run(const struct tb_mixer_bench *mb)
+{
+	const struct mixer_func_map *func_map;
+	const struct mixer_func_map *map;
+	const size_t *func_count;
+	void *handle;
+	int ret = 0;
+	int i, j, k;
+
+	if (mb->duration_ms < 1 || mb->channels < 1) {
+		fprintf(stderr, "error: mixer benchmark needs duration and channels\n");
+		return -EINVAL;
+	}
+
+	/* the mixer driver registers itself when the library is loaded */
+	sys_comp_init(sof_get());
+
+	handle = dlopen(mb->library, RTLD_LAZY);
+	if (!handle) {
+		fprintf(stderr, "error: %s\n", dlerror());
+		return -EINVAL;
+	}
+
+	func_map = dlsym(handle, "mixer_func_map");
+	func_count = dlsym(handle, "mixer_func_count");
+	if (!func_map || !func_count) {
+		fprintf(stderr, "error: no mixer functions in %s\n", mb->library);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	printf("mixer benchmark with %s\n", mb->library);
+
+	for (i = 0; i < ARRAY_SIZE(bench_formats); i++) {
+		if (mb->frame_fmt >= 0 && mb->frame_fmt != bench_formats[i].frame_fmt)
+			continue;
+
+		map = NULL;
+		for (j = 0; j < *func_count; j++)
+			if (func_map[j].frame_fmt == bench_formats[i].frame_fmt)
+				map = &func_map[j];
+
+		if (!map) {
+			printf("mixer %s: not supported by the build\n", bench_formats[i].name);
+			continue;
+		}
+
+		for (k = 0; k < mb->num_cases; k++) {
+			ret = bench_case(mb, map, bench_formats[i].name, mb->num_sources[k]);
+			if (ret < 0)
+				goto out;
+		}
+	}
+
+out:
+	dlclose(handle);
+	return ret;
+}
@@ -0,0 +1,281 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/* Per component copy() profiler for testbench */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/component_ext.h>
+#include <sof/list.h>
+#include "testbench/profile.h"
+
+struct tb_comp_profile {
+	struct comp_dev *dev;
+	uint32_t comp_id;
+	const char *name;
+	uint64_t calls;
+	uint64_t frames;
+	uint64_t total_ns;
+	uint32_t min_ns;
+	uint32_t max_ns;
+	uint32_t *period_ns;	/* copy() time of each call, for percentiles */
+	size_t num_periods;
+	size_t max_periods;
+};
+
+/* frames, ns per frame, min, avg, max, p99 and share columns */
+#define TB_PROFILE_CSV_HDR	"frames,ns_per_frame,min_ns,avg_ns,max_ns,p99_ns,share"
+#define TB_PROFILE_CSV_FMT	"%llu,%.1f,%u,%llu,%u,%u,%.4f\n"
+#define TB_PROFILE_JSON_FMT	"\"frames\": %llu, \"ns_per_frame\": %.1f, " \
+				"\"min_ns\": %u, \"avg_ns\": %llu, \"max_ns\": %u, " \
+				"\"p99_ns\": %u, \"share\": %.4f}"
+
+static struct tb_comp_profile profile[TB_PROFILE_MAX_COMPS];
+static int profile_count;
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct tb_comp_profile *tb_profile_get(struct comp_dev *dev)
+{
+	struct tb_comp_profile *prof = NULL;
+	const struct tr_ctx *tctx;
+	int i;
+
+	pthread_mutex_lock(&profile_lock);
+
+	for (i = 0; i < profile_count; i++) {
+		if (profile[i].dev == dev) {
+			prof = &profile[i];
+			goto out;
+		}
+	}
+
+	if (profile_count == TB_PROFILE_MAX_COMPS)
+		goto out;
+
+	prof = &profile[profile_count++];
+	prof->dev = dev;
+	prof->comp_id = dev_comp_id(dev);
+	tctx = trace_comp_drv_get_tr_ctx(dev->drv);
+	prof->name = tctx && tctx->uuid_p ? tctx->uuid_p->name : "unknown";
+	prof->min_ns = UINT32_MAX;
+
+out:
+	pthread_mutex_unlock(&profile_lock);
+	return prof;
+}
+
+/*
+ * Frames processed by a copy() are the frames that appeared in the first
+ * sink buffer, or for components without sinks, the frames that were freed
+ * in the first source buffer.
+ */
+static uint32_t tb_profile_frames(struct comp_dev *dev)
+{
+	struct comp_buffer __sparse_cache *buf_c;
+	struct comp_buffer *buf;
+	uint32_t frames;
+
+	if (!list_is_empty(&dev->bsink_list)) {
+		buf = list_first_item(&dev->bsink_list, struct comp_buffer, source_list);
+		buf_c = buffer_acquire(buf);
+		frames = audio_stream_get_avail_frames(&buf_c->stream);
+		buffer_release(buf_c);
+		return frames;
+	}
+
+	if (!list_is_empty(&dev->bsource_list)) {
+		buf = list_first_item(&dev->bsource_list, struct comp_buffer, sink_list);
+		buf_c = buffer_acquire(buf);
+		frames = audio_stream_get_free_frames(&buf_c->stream);
+		buffer_release(buf_c);
+		return frames;
+	}
+
+	return 0;
+}
+
+static void tb_profile_add(struct tb_comp_profile *prof, uint32_t ns, uint32_t frames)
+{
+	uint32_t *period_ns;
+	size_t max_periods;
+
+	prof->calls++;
+	prof->frames += frames;
+	prof->total_ns += ns;
+	prof->min_ns = MIN(prof->min_ns, ns);
+	prof->max_ns = MAX(prof->max_ns, ns);
+
+	if (prof->num_periods == prof->max_periods) {
+		max_periods = prof->max_periods ? prof->max_periods * 2 : TB_PROFILE_INIT_SAMPLES;
+		period_ns = realloc(prof->period_ns, max_periods * sizeof(*period_ns));
+		if (!period_ns)
+			return;
+
+		prof->period_ns = period_ns;
+		prof->max_periods = max_periods;
+	}
+
+	prof->period_ns[prof->num_periods++] = ns;
+}
+
+/* comp_copy() hook, times the copy() op of the component */
+static int tb_profile_comp_copy(struct comp_dev *dev)
+{
+	struct tb_comp_profile *prof = tb_profile_get(dev);
+	struct timespec td0, td1;
+	uint32_t frames0, frames1;
+	int64_t ns;
+	int ret;
+
+	if (!prof)
+		return dev->drv->ops.copy(dev);
+
+	frames0 = tb_profile_frames(dev);
+	clock_gettime(CLOCK_MONOTONIC, &td0);
+	ret = dev->drv->ops.copy(dev);
+	clock_gettime(CLOCK_MONOTONIC, &td1);
+	frames1 = tb_profile_frames(dev);
+
+	ns = (int64_t)(td1.tv_sec - td0.tv_sec) * 1000000000;
+	ns += td1.tv_nsec - td0.tv_nsec;
+	ns = MIN(ns, UINT32_MAX);
+
+	tb_profile_add(prof, ns, frames1 > frames0 ? frames1 - frames0 : 0);
+	return ret;
+}
+
+void tb_profile_enable(bool enable)
+{
+	comp_copy_hook = enable ? tb_profile_comp_copy : NULL;
+}
+
+static int tb_profile_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* 99th percentile of copy() times, sorts the recorded times */
+static uint32_t tb_profile_p99(struct tb_comp_profile *prof)
+{
+	if (!prof->num_periods)
+		return 0;
+
+	qsort(prof->period_ns, prof->num_periods, sizeof(*prof->period_ns), tb_profile_cmp);
+	return prof->period_ns[(prof->num_periods * 99 - 1) / 100];
+}
+
+static uint64_t tb_profile_total_ns(void)
+{
+	uint64_t total = 0;
+	int i;
+
+	for (i = 0; i < profile_count; i++)
+		total += profile[i].total_ns;
+
+	return total;
+}
+
+void tb_profile_print(void)
+{
+	struct tb_comp_profile *prof;
+	uint64_t total = tb_profile_total_ns();
+	int i;
+
+	if (!profile_count)
+		return;
+
+	printf("Component copy() profile:\n");
+	printf("%-24s %6s %10s %12s %10s %10s %10s %10s %10s %7s\n",
+	       "component", "id", "calls", "frames", "ns/frame",
+	       "min ns", "avg ns", "max ns", "p99 ns", "share");
+
+	for (i = 0; i < profile_count; i++) {
+		prof = &profile[i];
+		if (!prof->calls)
+			continue;
+
+		printf("%-24s %6u %10llu %12llu %10.1f %10u %10llu %10u %10u %6.1f%%\n",
+		       prof->name, prof->comp_id, (unsigned long long)prof->calls,
+		       (unsigned long long)prof->frames,
+		       prof->frames ? (double)prof->total_ns / prof->frames : 0.0,
+		       prof->min_ns, (unsigned long long)(prof->total_ns / prof->calls),
+		       prof->max_ns, tb_profile_p99(prof),
+		       total ? 100.0 * prof->total_ns / total : 0.0);
+	}
+
+	printf("\n");
+}
+
+/* write profile as JSON if file name ends with .json, otherwise as CSV */
+int tb_profile_write(const char *file_name)
+{
+	struct tb_comp_profile *prof;
+	uint64_t total = tb_profile_total_ns();
+	const char *ext = strrchr(file_name, '.');
+	bool json = ext && !strcmp(ext, ".json");
+	FILE *fh;
+	int n = 0;
+	int i;
+
+	fh = fopen(file_name, "w");
+	if (!fh) {
+		fprintf(stderr, "error: can't open profile file %s\n", file_name);
+		return -errno;
+	}
+
+	if (json)
+		fprintf(fh, "[\n");
+	else
+		fprintf(fh, "component,id,calls,%s\n", TB_PROFILE_CSV_HDR);
+
+	for (i = 0; i < profile_count; i++) {
+		prof = &profile[i];
+		if (!prof->calls)
+			continue;
+
+		if (json)
+			fprintf(fh, "%s\t{\"component\": \"%s\", \"id\": %u, \"calls\": %llu, ",
+				n ? ",\n" : "", prof->name, prof->comp_id,
+				(unsigned long long)prof->calls);
+		else
+			fprintf(fh, "%s,%u,%llu,", prof->name, prof->comp_id,
+				(unsigned long long)prof->calls);
+
+		fprintf(fh, json ? TB_PROFILE_JSON_FMT : TB_PROFILE_CSV_FMT,
+			(unsigned long long)prof->frames,
+			prof->frames ? (double)prof->total_ns / prof->frames : 0.0,
+			prof->min_ns, (unsigned long long)(prof->total_ns / prof->calls),
+			prof->max_ns, tb_profile_p99(prof),
+			total ? (double)prof->total_ns / total : 0.0);
+		n++;
+	}
+
+	if (json)
+		fprintf(fh, "\n]\n");
+
+	fclose(fh);
+	return 0;
+}
+
+/* free recorded data, components are profiled again from scratch */
+void tb_profile_free(void)
+{
+	int i;
+
+	pthread_mutex_lock(&profile_lock);
+	for (i = 0; i < profile_count; i++)
+		free(profile[i].period_ns);
+
+	memset(profile, 0, sizeof(profile));
+	profile_count = 0;
+	pthread_mutex_unlock(&profile_lock);
+}
@@ -9,12 +9,17 @@
 #include <sof/ipc/driver.h>
 #include <sof/ipc/topology.h>
 #include <sof/list.h>
+#include <sof/schedule/ll_schedule.h>
+#include <rtos/spinlock.h>
 #include <getopt.h>
 #include <dlfcn.h>
 #include "testbench/common_test.h"
 #include <tplg_parser/topology.h>
 #include "testbench/trace.h"
 #include "testbench/file.h"
+#include "testbench/profile.h"
+#include "testbench/mixer_bench.h"
+#include <inttypes.h>
 #include <limits.h>
 #include <stdlib.h>
 
@@ -75,6 +80,20 @@ struct pipeline_thread_data {
 	struct testbench_prm *tp;
 	int count;			/* copy iteration count */
 	int core_id;
+	uint64_t ticks;			/* LL ticks run in free-running mode */
+
+	/* free-running mode with pipelines on several virtual cores */
+	pthread_barrier_t tick_start;	/* vcores start the next tick */
+	pthread_barrier_t tick_done;	/* vcores have completed the tick */
+	bool tick_stop;			/* vcores leave at next tick start */
+	int tick_count[SCHEDULE_LL_VCORES];	/* tasks run by vcore in the tick */
+};
+
+/* free-running LL tick thread of a virtual core */
+struct vcore_thread_data {
+	struct pipeline_thread_data *ptdata;
+	pthread_t thread_id;
+	int core;
 };
 
 /* shared library look up table */
@@ -165,6 +184,40 @@ static int parse_input_files(char *inputs, struct testbench_prm *tp)
 	return 0;
 }
 
+/* rate, channels and format of WAV input are taken from the file header */
+static int parse_input_wav(struct testbench_prm *tp)
+{
+	struct file_wav_info wav;
+	const char *bits;
+	int ret;
+
+	ret = file_wav_get_info(tp->input_file[0], &wav);
+	if (ret < 0) {
+		fprintf(stderr, "error: %s is not a supported WAV file\n", tp->input_file[0]);
+		return ret;
+	}
+
+	switch (wav.frame_fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		bits = "S16_LE";
+		break;
+	case SOF_IPC_FRAME_S24_4LE:
+		bits = "S24_LE";
+		break;
+	default:
+		bits = "S32_LE";
+		break;
+	}
+
+	free(tp->bits_in);
+	tp->bits_in = strdup(bits);
+	tp->cmd_frame_fmt = wav.frame_fmt;
+	tp->cmd_fs_in = wav.rate;
+	tp->cmd_channels_in = wav.channels;
+
+	return 0;
+}
+
 static int parse_pipelines(char *pipelines, struct testbench_prm *tp)
 {
 	char *output_token = NULL;
@@ -242,6 +295,12 @@ static void print_usage(char *executable)
 	printf("  -a <comp1=comp1_library,comp2=comp2_library>, override default library\n\n");
 	printf("Options to control test:\n");
 	printf("  -d Run in debug mode\n");
+	printf("  -F Free-running mode, tick LL scheduler back to back until EOF\n");
+	printf("  -x Profile copy() of each component and print statistics\n");
+	printf("  -X <file.csv|file.json> Profile copy() and write statistics to file\n");
+	printf("  -M <sources1,sources2,...> Benchmark mixer kernels with the given numbers\n");
+	printf("     of sources, format from -b or all, -c channels, -r rate, -D duration,\n");
+	printf("     -a mixer=<library> to select the mixer library\n");
 	printf("  -q Run in quiet mode, suppress traces output\n");
 	printf("  -p <pipeline1,pipeline2,...>\n");
 	printf("  -s Use real time priorities for threads (needs sudo)\n");
@@ -249,13 +308,14 @@ static void print_usage(char *executable)
 	printf("  -D <pipeline duration in ms>\n");
 	printf("  -P <number of dynamic pipeline iterations>\n");
 	printf("  -T <microseconds for tick, 0 for batch mode>\n");
-	printf("  -V <number of virtual cores>\n\n");
+	printf("  -V <number of virtual cores>, pipelines are spread over the cores\n\n");
 	printf("Options for input and output format override:\n");
 	printf("  -b <input_format>, S16_LE, S24_LE, or S32_LE\n");
 	printf("  -c <input channels>\n");
 	printf("  -n <output channels>\n");
 	printf("  -r <input rate>\n");
-	printf("  -R <output rate>\n\n");
+	printf("  -R <output rate>\n");
+	printf("  With .wav input file the input format is taken from the file\n\n");
 	printf("Environment variables\n");
 	printf("  SOF_HOST_CORE0=<i> - Map DSP core 0..N to host i..i+N\n");
 	printf("Help:\n");
@@ -399,7 +459,7 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hdqi:o:t:b:a:r:R:c:n:C:P:Vp:T:D:")) != -1) {
+	while ((option = getopt(argc, argv, "hdFxX:M:qi:o:t:b:a:r:R:c:n:C:P:V:p:T:D:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -462,6 +522,27 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->quiet = true;
 			break;
 
+		/* free-running, no tick pacing */
+		case 'F':
+			tp->free_running = true;
+			break;
+
+		/* per component copy() profiling */
+		case 'x':
+			tp->profile = true;
+			break;
+
+		/* per component copy() profiling written to file */
+		case 'X':
+			tp->profile = true;
+			tp->profile_file = strdup(optarg);
+			break;
+
+		/* mixer kernel benchmark, no topology is run */
+		case 'M':
+			tp->mixer_bench = strdup(optarg);
+			break;
+
 		/* number of dynamic pipeline iterations */
 		case 'P':
 			tp->dynamic_pipeline_iterations = atoi(optarg);
@@ -599,6 +680,48 @@ static int test_pipeline_params(struct pipeline_thread_data *ptdata, struct tplg
 	return 0;
 }
 
+/*
+ * Spread the test pipelines round robin over the virtual cores. The LL task
+ * of a pipeline is created at prepare on the core of the pipeline so this
+ * must be done before the pipelines are prepared. Components stay on DSP
+ * core 0.
+ */
+static void test_pipeline_set_cores(struct pipeline_thread_data *ptdata)
+{
+	struct testbench_prm *tp = ptdata->tp;
+	struct pipeline *p;
+	int i;
+
+	for (i = 0; i < tp->pipeline_num; i++) {
+		p = get_pipeline_by_id(tp->pipelines[i]);
+		p->core = i % tp->num_vcores;
+	}
+}
+
+/* buffers between pipelines on different virtual cores need locking */
+static void test_pipeline_share_buffers(void)
+{
+	struct ipc *ipc = sof_get()->ipc;
+	struct ipc_comp_dev *icd;
+	struct comp_buffer *buffer;
+	struct list_item *clist;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_BUFFER)
+			continue;
+
+		buffer = icd->cb;
+		if (!buffer->source || !buffer->sink ||
+		    !buffer->source->pipeline || !buffer->sink->pipeline)
+			continue;
+
+		if (buffer->source->pipeline->core != buffer->sink->pipeline->core &&
+		    !is_coherent_shared(buffer, c))
+			coherent_shared(buffer, c);
+	}
+}
+
 static int test_pipeline_start(struct pipeline_thread_data *ptdata)
 {
 	struct testbench_prm *tp = ptdata->tp;
@@ -606,6 +729,11 @@ static int test_pipeline_start(struct pipeline_thread_data *ptdata)
 	struct ipc *ipc = sof_get()->ipc;
 	int i;
 
+	if (tp->num_vcores > 1) {
+		test_pipeline_set_cores(ptdata);
+		test_pipeline_share_buffers();
+	}
+
 	/* Run pipeline until EOF from fileread */
 	for (i = 0; i < tp->pipeline_num; i++) {
 		p = get_pipeline_by_id(tp->pipelines[i]);
@@ -735,13 +863,185 @@ static void test_pipeline_stats(struct pipeline_thread_data *ptdata,
 	}
 	printf("Input sample (frame) count: %d (%d)\n", n_in, n_in / ctx->channels_in);
 	printf("Output sample (frame) count: %d (%d)\n", n_out, n_out / ctx->channels_out);
+	if (tp->free_running)
+		printf("Free-running LL ticks: %" PRIu64 "\n", ptdata->ticks);
+	if (tp->num_vcores > 1) {
+		for (i = 0; i < tp->pipeline_num; i++) {
+			p = get_pipeline_by_id(tp->pipelines[i]);
+			printf("Pipeline %d on vcore %d, LL task time: %" PRIu64 " us\n",
+			       tp->pipelines[i], p->core, p->pipe_task->start);
+		}
+	}
 	printf("Total execution time: %zu us, %.2f x realtime\n\n",
 	       delta, (double)((double)n_out / ctx->channels_out / ctx->fs_out) * 1000000 / delta);
+
+	if (tp->profile) {
+		tb_profile_print();
+		if (tp->profile_file)
+			tb_profile_write(tp->profile_file);
+	}
+}
+
+/* sleep to let the pipeline work - we exit at timeout OR
+ * if copy iterations OR max_samples is reached (whatever first)
+ */
+static void test_pipeline_wait(struct pipeline_thread_data *ptdata)
+{
+	struct testbench_prm *tp = ptdata->tp;
+	struct timespec ts;
+	int nsleep_time;
+	int nsleep_limit;
+	int err;
+
+	nsleep_time = 0;
+	ts.tv_sec = tp->tick_period_us / 1000000;
+	ts.tv_nsec = (tp->tick_period_us % 1000000) * 1000;
+	if (!tp->copy_check)
+		nsleep_limit = INT_MAX;
+	else
+		nsleep_limit = tp->copy_iterations *
+			       tp->pipeline_duration_ms;
+
+	while (nsleep_time < nsleep_limit) {
+		/* wait for next tick */
+		err = nanosleep(&ts, &ts);
+		if (err == 0) {
+			nsleep_time += tp->tick_period_us; /* sleep fully completed */
+			if (test_pipeline_check_state(ptdata, SOF_TASK_STATE_CANCEL)) {
+				fprintf(stdout, "pipeline cancelled !\n");
+				break;
+			}
+		} else {
+			if (err == EINTR) {
+				continue; /* interrupted - keep going */
+			} else {
+				printf("error: sleep failed: %s\n", strerror(err));
+				break;
+			}
+		}
+	}
+}
+
+/* run one LL tick on each core used by the test pipelines */
+static int test_pipeline_tick(struct pipeline_thread_data *ptdata)
+{
+	struct testbench_prm *tp = ptdata->tp;
+	bool ticked[SCHEDULE_LL_VCORES] = { false };
+	struct pipeline *p;
+	int count = 0;
+	int ret;
+	int i;
+
+	for (i = 0; i < tp->pipeline_num; i++) {
+		p = get_pipeline_by_id(tp->pipelines[i]);
+		if (p->core >= SCHEDULE_LL_VCORES || ticked[p->core])
+			continue;
+
+		ticked[p->core] = true;
+		ret = schedule_ll_run_tick(p->core);
+		if (ret > 0)
+			count += ret;
+	}
+
+	return count;
+}
+
+/*
+ * Free-running LL tick thread of a virtual core. The tester thread releases
+ * all vcores into a tick together and waits for all of them to complete it,
+ * so the vcores run in parallel but never drift apart by more than a tick.
+ */
+static void *test_pipeline_vcore_run(void *data)
+{
+	struct vcore_thread_data *vt = data;
+	struct pipeline_thread_data *ptdata = vt->ptdata;
+
+	for (;;) {
+		pthread_barrier_wait(&ptdata->tick_start);
+		if (ptdata->tick_stop)
+			break;
+
+		ptdata->tick_count[vt->core] = schedule_ll_run_tick(vt->core);
+		pthread_barrier_wait(&ptdata->tick_done);
+	}
+
+	return NULL;
+}
+
+/* run the LL ticks of the virtual cores in parallel, one thread per vcore */
+static void test_pipeline_run_free_vcores(struct pipeline_thread_data *ptdata)
+{
+	struct vcore_thread_data vt[SCHEDULE_LL_VCORES];
+	int num_vcores = ptdata->tp->num_vcores;
+	int count;
+	int err;
+	int i;
+
+	pthread_barrier_init(&ptdata->tick_start, NULL, num_vcores + 1);
+	pthread_barrier_init(&ptdata->tick_done, NULL, num_vcores + 1);
+	ptdata->tick_stop = false;
+
+	for (i = 0; i < num_vcores; i++) {
+		vt[i].ptdata = ptdata;
+		vt[i].core = i;
+		err = pthread_create(&vt[i].thread_id, NULL, test_pipeline_vcore_run, &vt[i]);
+		if (err) {
+			fprintf(stderr, "error: can't create vcore %d thread: %s\n",
+				i, strerror(err));
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	while (!test_pipeline_check_state(ptdata, SOF_TASK_STATE_CANCEL)) {
+		pthread_barrier_wait(&ptdata->tick_start);
+		pthread_barrier_wait(&ptdata->tick_done);
+
+		count = 0;
+		for (i = 0; i < num_vcores; i++)
+			if (ptdata->tick_count[i] > 0)
+				count += ptdata->tick_count[i];
+
+		if (!count)
+			break;
+
+		ptdata->ticks++;
+	}
+
+	ptdata->tick_stop = true;
+	pthread_barrier_wait(&ptdata->tick_start);
+
+	for (i = 0; i < num_vcores; i++)
+		pthread_join(vt[i].thread_id, NULL);
+
+	pthread_barrier_destroy(&ptdata->tick_start);
+	pthread_barrier_destroy(&ptdata->tick_done);
 }
 
 /*
- * Tester thread, one for each virtual core. This is NOT the thread that will
- * execute the virtual core.
+ * Free-running mode, the LL scheduler is ticked back to back without any
+ * pacing until fileread hits EOF or the copy limit cancels the pipeline.
+ */
+static void test_pipeline_run_free(struct pipeline_thread_data *ptdata)
+{
+	ptdata->ticks = 0;
+
+	if (ptdata->tp->num_vcores > 1) {
+		test_pipeline_run_free_vcores(ptdata);
+	} else {
+		while (!test_pipeline_check_state(ptdata, SOF_TASK_STATE_CANCEL)) {
+			if (!test_pipeline_tick(ptdata))
+				break;
+
+			ptdata->ticks++;
+		}
+	}
+
+	fprintf(stdout, "pipeline cancelled after %" PRIu64 " ticks\n", ptdata->ticks);
+}
+
+/*
+ * Tester thread, loads the topology and runs the test pipelines. This is NOT
+ * the thread that will execute the virtual cores.
  */
 static void *pipline_test(void *data)
 {
@@ -749,11 +1049,8 @@ static void *pipline_test(void *data)
 	struct testbench_prm *tp = ptdata->tp;
 	int dp_count = 0;
 	struct tplg_context ctx;
-	struct timespec ts;
 	struct timespec td0, td1;
 	int err;
-	int nsleep_time;
-	int nsleep_limit;
 	uint64_t delta;
 
 	/* build, run and teardown pipelines */
@@ -788,36 +1085,10 @@ static void *pipline_test(void *data)
 		}
 		clock_gettime(CLOCK_MONOTONIC, &td0);
 
-		/* sleep to let the pipeline work - we exit at timeout OR
-		 * if copy iterations OR max_samples is reached (whatever first)
-		 */
-		nsleep_time = 0;
-		ts.tv_sec = tp->tick_period_us / 1000000;
-		ts.tv_nsec = (tp->tick_period_us % 1000000) * 1000;
-		if (!tp->copy_check)
-			nsleep_limit = INT_MAX;
+		if (tp->free_running)
+			test_pipeline_run_free(ptdata);
 		else
-			nsleep_limit = tp->copy_iterations *
-				       tp->pipeline_duration_ms;
-
-		while (nsleep_time < nsleep_limit) {
-			/* wait for next tick */
-			err = nanosleep(&ts, &ts);
-			if (err == 0) {
-				nsleep_time += tp->tick_period_us; /* sleep fully completed */
-				if (test_pipeline_check_state(ptdata, SOF_TASK_STATE_CANCEL)) {
-					fprintf(stdout, "pipeline cancelled !\n");
-					break;
-				}
-			} else {
-				if (err == EINTR) {
-					continue; /* interrupted - keep going */
-				} else {
-					printf("error: sleep failed: %s\n", strerror(err));
-					break;
-				}
-			}
-		}
+			test_pipeline_wait(ptdata);
 
 		clock_gettime(CLOCK_MONOTONIC, &td1);
 		err = test_pipeline_stop(ptdata);
@@ -839,6 +1110,8 @@ static void *pipline_test(void *data)
 		}
 
 		test_pipeline_free(ptdata);
+		if (tp->profile)
+			tb_profile_free();
 
 		ptdata->count++;
 		dp_count++;
@@ -847,11 +1120,30 @@ static void *pipline_test(void *data)
 	return NULL;
 }
 
+static int run_mixer_bench(struct testbench_prm *tp)
+{
+	struct tb_mixer_bench mb;
+	int ret;
+
+	memset(&mb, 0, sizeof(mb));
+	ret = tb_mixer_bench_parse(&mb, tp->mixer_bench);
+	if (ret < 0)
+		return ret;
+
+	mb.library = lib_table[get_index_by_name("mixer", lib_table)].library_name;
+	mb.frame_fmt = tp->bits_in ? tp->cmd_frame_fmt : -1;
+	mb.channels = tp->cmd_channels_in;
+	mb.rate = tp->cmd_fs_in ? tp->cmd_fs_in : 48000;
+	mb.duration_ms = tp->pipeline_duration_ms;
+
+	return tb_mixer_bench_run(&mb);
+}
+
 static struct testbench_prm tp;
 
 int main(int argc, char **argv)
 {
-	struct pipeline_thread_data ptdata[CONFIG_CORE_COUNT];
+	struct pipeline_thread_data ptdata;
 	int i, err;
 
 	/* initialize input and output sample rates, files, etc. */
@@ -873,6 +1165,10 @@ int main(int argc, char **argv)
 	tp.max_pipeline_id = 0;
 	tp.copy_check = false;
 	tp.quiet = 0;
+	tp.free_running = false;
+	tp.profile = false;
+	tp.profile_file = NULL;
+	tp.mixer_bench = NULL;
 	tp.dynamic_pipeline_iterations = 1;
 	tp.num_vcores = 0;
 	tp.pipeline_string = calloc(1, DEBUG_MSG_LEN);
@@ -887,9 +1183,20 @@ int main(int argc, char **argv)
 	if (err < 0)
 		goto out;
 
+	if (tp.input_file_num && get_file_format(tp.input_file[0]) == FILE_WAV) {
+		err = parse_input_wav(&tp);
+		if (err < 0)
+			goto out;
+	}
+
 	if (!tp.cmd_channels_out)
 		tp.cmd_channels_out = tp.cmd_channels_in;
 
+	if (tp.mixer_bench) {
+		err = run_mixer_bench(&tp);
+		goto out;
+	}
+
 	/* check mandatory args */
 	if (!tp.tplg_file) {
 		fprintf(stderr, "topology file not specified, use -t file.tplg\n");
@@ -915,9 +1222,9 @@ int main(int argc, char **argv)
 		exit(EXIT_FAILURE);
 	}
 
-	if (tp.num_vcores > CONFIG_CORE_COUNT) {
+	if (tp.num_vcores > SCHEDULE_LL_VCORES) {
 		fprintf(stderr, "virtual core count %d is greater than max %d\n",
-			tp.num_vcores, CONFIG_CORE_COUNT);
+			tp.num_vcores, SCHEDULE_LL_VCORES);
 		print_usage(argv[0]);
 		exit(EXIT_FAILURE);
 	} else {
@@ -925,6 +1232,11 @@ int main(int argc, char **argv)
 			tp.num_vcores = 1;
 	}
 
+	/* pipelines on several vcores share buffers across host threads */
+	arch_spinlock_smp = tp.num_vcores > 1;
+
+	tb_profile_enable(tp.profile);
+
 	if (tp.quiet)
 		tb_enable_trace(false); /* reduce trace output */
 	else
@@ -937,22 +1249,14 @@ int main(int argc, char **argv)
 	}
 
 	/* build, run and teardown pipelines */
-	for (i = 0; i < tp.num_vcores; i++) {
-		ptdata[i].core_id = i;
-		ptdata[i].tp = &tp;
-		ptdata[i].count = 0;
+	memset(&ptdata, 0, sizeof(ptdata));
+	ptdata.tp = &tp;
 
-		err = pthread_create(&hc.thread_id[i], NULL,
-				     pipline_test, &ptdata[i]);
-		if (err) {
-			printf("error: can't create thread %d %s\n", err, strerror(err));
-			goto join;
-		}
-	}
-
-join:
-	for (i = 0; i < tp.num_vcores; i++)
-		err = pthread_join(hc.thread_id[i], NULL);
+	err = pthread_create(&hc.thread_id[0], NULL, pipline_test, &ptdata);
+	if (err)
+		printf("error: can't create thread %d %s\n", err, strerror(err));
+	else
+		pthread_join(hc.thread_id[0], NULL);
 
 	/* free other core FW services */
 	tb_free(sof_get());
@@ -968,6 +1272,8 @@ out:
 		free(tp.input_file[i]);
 
 	free(tp.pipeline_string);
+	free(tp.profile_file);
+	free(tp.mixer_bench);
 
 #ifdef TESTBENCH_CACHE_CHECK
 	_cache_free_all();
@@ -979,5 +1285,5 @@ out:
 			dlclose(lib_table[i].handle);
 	}
 
-	return EXIT_SUCCESS;
+	return err < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,689 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2023 Intel Corporation. All rights reserved.
+
+/*
+ * SRC coefficients blob generator. This is a C port of the Kaiser window
+ * design in src_generate.m, src_get.m and src_param.m that writes the
+ * conversion for one rates pair as a struct sof_src_config blob to load
+ * into the SRC component at run-time.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <kernel/abi.h>
+#include <kernel/header.h>
+#include <user/src.h>
+
+#define SRC_FILTER_LENGTH_MULT	4	/* Sub-filter lengths are multiple of four */
+#define SRC_DESIGN_MAX_STEPS	100	/* Iterations to meet stop-band */
+#define SRC_DESIGN_MAX_WORSE	20	/* Worse steps in row before giving up */
+#define SRC_STOPBAND_POINTS	500	/* Frequency points to check stop-band */
+#define SRC_RS_MAX		160	/* Max stop-band attenuation in dB */
+#define SRC_RS_MIN		40	/* Min stop-band attenuation in dB */
+
+struct src_design {
+	int fs1;		/* Input rate of the stage */
+	int fs2;		/* Output rate of the stage */
+	double c_pb;		/* Pass-band end relative to lower rate */
+	double c_sb;		/* Stop-band start relative to lower rate */
+	double rs;		/* Stop-band attenuation in dB */
+	double rp;		/* Pass-band ripple in dB */
+	double gain;		/* Gain in dB at 0 Hz */
+};
+
+struct src_stage_coef {
+	struct sof_src_stage stage;
+	double *coefs;		/* filter_length coefficients in natural order */
+};
+
+struct src_blob_param {
+	int fs_in;
+	int fs_out;
+	int coef_bits;
+	int ipc_major;
+	double quality;
+	double rs;
+	double gain;
+	char *bin_file;
+	char *txt_file;
+};
+
+static void usage(char *name)
+{
+	fprintf(stdout, "Usage: %s -i <rate> -o <rate> [options]\n", name);
+	fprintf(stdout, " -i input sample rate in Hz\n");
+	fprintf(stdout, " -o output sample rate in Hz\n");
+	fprintf(stdout, " -c coefficient bits, 16 or 32, default 32\n");
+	fprintf(stdout, " -a stop-band attenuation in dB, default 80\n");
+	fprintf(stdout, " -q quality to scale the pass-band width, default 1.0\n");
+	fprintf(stdout, " -g overall gain in dB, default -1\n");
+	fprintf(stdout, " -p IPC major version for the ABI header, 3 or 4, default 3\n");
+	fprintf(stdout, " -b output file for binary blob with ABI header\n");
+	fprintf(stdout, " -t output file for comma separated 32 bit words with ABI header\n");
+	fprintf(stdout, " -h print this help\n");
+}
+
+static int gcd(int a, int b)
+{
+	int t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+/* Split c to a * b with a as near as possible to sqrt(c) */
+static void factor2(int c, int *a, int *b)
+{
+	int x = (int)round(sqrt(c));
+	int a1 = 0;
+	int a2 = 0;
+	int t;
+
+	for (t = x; t <= 2 * x; t++) {
+		if (c % t == 0) {
+			a1 = t;
+			break;
+		}
+	}
+
+	for (t = x; t >= x / 2 && t > 0; t--) {
+		if (c % t == 0) {
+			a2 = t;
+			break;
+		}
+	}
+
+	if (a1 && (!a2 || a1 - x < x - a2))
+		*a = a1;
+	else if (a2)
+		*a = a2;
+	else
+		*a = 1; /* No factors near, single step */
+
+	*b = c / *a;
+}
+
+/* Factorize the rates ratio to two stages l1/m1 * l2/m2 */
+static void src_factor2_lm(int fs1, int fs2, int *l1, int *m1, int *l2, int *m2)
+{
+	int k = gcd(fs1, fs2);
+	int l = fs2 / k;
+	int m = fs1 / k;
+	int l01, l02, m01, m02;
+	int fs3[4];
+	int lt[4][4];
+	int ref;
+	int best = -1;
+	int i;
+
+	factor2(l, &l01, &l02);
+	factor2(m, &m01, &m02);
+
+	/* Hand fixing for common ratios to match src_factor2_lm.m */
+	if ((l == 147 && (m == 640 || m == 320 || m == 160)) ||
+	    (m == 147 && (l == 160 || l == 320))) {
+		l01 = l == 147 ? 7 : 8;
+		m01 = m == 147 ? 7 : 8;
+	} else if ((l == 4 && m == 3) || (l == 3 && m == 4)) {
+		l01 = l;
+		m01 = m;
+	}
+
+	l02 = l / l01;
+	m02 = m / m01;
+
+	/* Candidate intermediate rates, pick the one nearest to the lower
+	 * of the rates without going below it.
+	 */
+	lt[0][0] = l01; lt[0][1] = m01; lt[0][2] = l02; lt[0][3] = m02;
+	lt[1][0] = l01; lt[1][1] = m02; lt[1][2] = l02; lt[1][3] = m01;
+	lt[2][0] = l02; lt[2][1] = m01; lt[2][2] = l01; lt[2][3] = m02;
+	lt[3][0] = l02; lt[3][1] = m02; lt[3][2] = l01; lt[3][3] = m01;
+	ref = fs1 > fs2 ? fs2 : fs1;
+	for (i = 0; i < 4; i++) {
+		fs3[i] = (int)((int64_t)fs1 * lt[i][0] / lt[i][1]);
+		if (fs3[i] < ref)
+			continue;
+
+		if (best < 0 || fs3[i] < fs3[best])
+			best = i;
+	}
+
+	if (best < 0)
+		best = 0;
+
+	*l1 = lt[best][0];
+	*m1 = lt[best][1];
+	*l2 = lt[best][2];
+	*m2 = lt[best][3];
+
+	/* Move a 1:1 first stage to second */
+	if (*l1 == 1 && *m1 == 1) {
+		*l1 = *l2;
+		*m1 = *m2;
+		*l2 = 1;
+		*m2 = 1;
+	}
+}
+
+/* Find l0, m0 to meet -l0 * L + m0 * M == 1 */
+static int src_find_l0m0(int L, int M, int32_t *l0, int32_t *m0)
+{
+	int lt;
+
+	if (M == 1) {
+		*l0 = 0;
+		*m0 = 1;
+		return 0;
+	}
+
+	if (L == 1) {
+		*l0 = 1;
+		*m0 = 0;
+		return 0;
+	}
+
+	/* The first found has the smallest sum */
+	for (lt = 1; lt <= 4 * L; lt++) {
+		if ((1 + lt * L) % M == 0) {
+			*l0 = lt;
+			*m0 = (1 + lt * L) / M;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static void src_design_init(struct src_design *d, int fs1, int fs2,
+			    const struct src_blob_param *p)
+{
+	int min_fs = fs1 < fs2 ? fs1 : fs2;
+
+	d->fs1 = fs1;
+	d->fs2 = fs2;
+	d->c_pb = p->quality * 20 / 44.1; /* 20 kHz bandwidth at 44.1 kHz */
+	d->c_sb = 0.5; /* Stop-band starts at Fs/2 */
+	d->rs = p->rs;
+	d->rp = 0.1;
+
+	/* 24 kHz bandwidth for high rates */
+	if (min_fs > 80000)
+		d->c_pb = 24000.0 / min_fs;
+}
+
+/* Zero order modified Bessel function of the first kind */
+static double bessel_i0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	double y = x * x / 4;
+	int k;
+
+	for (k = 1; k < 500; k++) {
+		term *= y / ((double)k * k);
+		sum += term;
+		if (term < 1e-16 * sum)
+			break;
+	}
+
+	return sum;
+}
+
+/* Low-pass FIR design as Octave fir1(n, wc, kaiser(n + 1, beta)) */
+static void fir1_kaiser(double *b, int n, double wc, double beta)
+{
+	double i0_beta = bessel_i0(beta);
+	double sum = 0;
+	double half = n / 2.0;
+	double t;
+	double r;
+	int k;
+
+	for (k = 0; k <= n; k++) {
+		t = k - half;
+		b[k] = t == 0 ? wc : sin(M_PI * wc * t) / (M_PI * t);
+		r = n > 0 ? (k - half) / half : 0;
+		b[k] *= bessel_i0(beta * sqrt(1 - r * r)) / i0_beta;
+		sum += b[k];
+	}
+
+	for (k = 0; k <= n; k++)
+		b[k] /= sum;
+}
+
+/* Returns the max magnitude in dB in frequencies f1 .. f2 */
+static double fir_max_db(const double *b, int length, double f1, double f2, double fs)
+{
+	double max_m = 0;
+	double f, w, re, im, m;
+	double cr, ci, pr, pi, tr;
+	int i, k;
+
+	for (i = 0; i < SRC_STOPBAND_POINTS; i++) {
+		f = f1 + (f2 - f1) * i / (SRC_STOPBAND_POINTS - 1);
+		w = -2 * M_PI * f / fs;
+		cr = cos(w);
+		ci = sin(w);
+		pr = 1;
+		pi = 0;
+		re = 0;
+		im = 0;
+		for (k = 0; k < length; k++) {
+			re += b[k] * pr;
+			im += b[k] * pi;
+			tr = pr * cr - pi * ci;
+			pi = pr * ci + pi * cr;
+			pr = tr;
+		}
+
+		m = re * re + im * im;
+		if (m > max_m)
+			max_m = m;
+	}
+
+	return 10 * log10(max_m);
+}
+
+/* Design one polyphase stage, see src_get.m */
+static int src_design_stage(const struct src_design *d, struct src_stage_coef *s)
+{
+	struct sof_src_stage *st = &s->stage;
+	int k = gcd(d->fs1, d->fs2);
+	int L = d->fs2 / k;
+	int M = d->fs1 / k;
+	int min_fs = d->fs1 < d->fs2 ? d->fs1 : d->fs2;
+	double fs3 = (double)L * d->fs1;
+	double f_pb = min_fs * d->c_pb;
+	double f_sb = min_fs * d->c_sb;
+	double dev_p = (pow(10, d->rp / 20) - 1) / (pow(10, d->rp / 20) + 1);
+	double dev_s = pow(10, -d->rs / 20);
+	double a = -20 * log10(dev_p < dev_s ? dev_p : dev_s);
+	double w = (f_sb - f_pb) / (fs3 / 2);
+	double dn[SRC_DESIGN_MAX_STEPS];
+	int fn[SRC_DESIGN_MAX_STEPS];
+	double delta = 100;
+	double delta_prev;
+	double gmax, coef_max, beta, wc, g;
+	double *b;
+	int nfir_increment = L * SRC_FILTER_LENGTH_MULT;
+	int stopband_ok = 0;
+	int need_to_stop = 0;
+	int n_worse = 0;
+	int nfir, n0, kn0;
+	int32_t idm, odm;
+	int i, j, n;
+	int shift;
+
+	if (d->c_pb > 0.49 || d->c_pb < 0.10) {
+		fprintf(stderr, "error: pass-band %.3f is out of range for %d to %d\n",
+			d->c_pb, d->fs1, d->fs2);
+		return -EINVAL;
+	}
+
+	/* Kaiser order estimate as Octave kaiserord(), decreased to 70% */
+	kn0 = (int)ceil((a - 8) / (2.285 * M_PI * w));
+	if (a > 50)
+		beta = 0.1102 * (a - 8.7);
+	else if (a >= 21)
+		beta = 0.5842 * pow(a - 21, 0.4) + 0.07886 * (a - 21);
+	else
+		beta = 0;
+
+	wc = (f_pb + f_sb) / fs3;
+	n0 = (int)round(kn0 * 0.70);
+	if ((n0 + 1) % nfir_increment)
+		nfir = ((n0 + 1) / nfir_increment + 1) * nfir_increment - 1;
+	else
+		nfir = n0;
+
+	/* Largest possible filter is needed for reverse step */
+	b = malloc(sizeof(double) * (nfir + 1 + SRC_DESIGN_MAX_STEPS * nfir_increment));
+	if (!b)
+		return -ENOMEM;
+
+	/* Increase the length until the stop-band attenuation is met */
+	for (n = 0; !stopband_ok && n < SRC_DESIGN_MAX_STEPS; n++) {
+		fir1_kaiser(b, nfir, wc, beta);
+		delta_prev = delta;
+		delta = d->rs + fir_max_db(b, nfir + 1, f_sb, fs3 / 2, fs3);
+		dn[n] = delta;
+		fn[n] = nfir;
+		if (delta < 0) {
+			stopband_ok = 1;
+		} else if (delta_prev < delta) {
+			if (++n_worse > SRC_DESIGN_MAX_WORSE) {
+				/* No improvement, reverse to the best */
+				need_to_stop = 1;
+				j = 0;
+				for (i = 1; i <= n; i++) {
+					if (dn[i] < dn[j])
+						j = i;
+				}
+
+				nfir = fn[j];
+			} else {
+				nfir += nfir_increment;
+			}
+		} else if (!need_to_stop) {
+			nfir += nfir_increment;
+		} else {
+			stopband_ok = 1;
+			fprintf(stderr, "warning: stop-band not reached, FIR order is %d\n", nfir);
+		}
+	}
+
+	/* Scale for interpolation, unity gain at DC, and requested gain */
+	g = 0;
+	for (i = 0; i <= nfir; i++)
+		g += b[i];
+
+	g = L / fabs(g) * pow(10, d->gain / 20);
+	coef_max = 0;
+	for (i = 0; i <= nfir; i++) {
+		b[i] *= g;
+		if (fabs(b[i]) > coef_max)
+			coef_max = fabs(b[i]);
+	}
+
+	gmax = (32767.0 / 32768.0) / coef_max;
+	shift = (int)floor(log2(gmax));
+	if (shift < SOF_SRC_MIN_SHIFT) {
+		fprintf(stderr, "error: gain is too large for %d/%d\n", L, M);
+		free(b);
+		return -EINVAL;
+	}
+
+	/* the firmware limits the shift, use less of the coefficient range */
+	if (shift > SOF_SRC_MAX_SHIFT)
+		shift = SOF_SRC_MAX_SHIFT;
+
+	for (i = 0; i <= nfir; i++)
+		b[i] *= pow(2, shift);
+
+	st->num_of_subfilters = L;
+	st->subfilter_length = (nfir + 1 + L - 1) / L;
+	st->filter_length = st->subfilter_length * L;
+	st->blk_in = M;
+	st->blk_out = L;
+	st->halfband = 0;
+	st->shift = shift;
+	st->reserved = 0;
+	if (src_find_l0m0(L, M, &idm, &odm) < 0) {
+		fprintf(stderr, "error: no delay line steps for %d/%d\n", L, M);
+		free(b);
+		return -EINVAL;
+	}
+
+	st->idm = idm;
+	st->odm = odm;
+
+	s->coefs = calloc(st->filter_length, sizeof(double));
+	if (!s->coefs) {
+		free(b);
+		return -ENOMEM;
+	}
+
+	memcpy(s->coefs, b, sizeof(double) * (nfir + 1));
+	free(b);
+	return 0;
+}
+
+/* Quantize and write a stage in polyphase order, returns bytes written */
+static size_t src_pack_stage(const struct src_stage_coef *s, int coef_bits, void *data)
+{
+	const struct sof_src_stage *st = &s->stage;
+	int16_t *c16 = data;
+	int32_t *c32 = data;
+	double sref = pow(2, coef_bits - 1);
+	double c;
+	int i, j, n;
+
+	for (i = 0; i < st->num_of_subfilters; i++) {
+		for (j = 0; j < st->subfilter_length; j++) {
+			n = i * st->subfilter_length + j;
+			c = round(sref * s->coefs[i + j * st->num_of_subfilters]);
+			if (c > sref - 1)
+				c = sref - 1;
+
+			if (c < -sref)
+				c = -sref;
+
+			if (coef_bits == 16)
+				c16[n] = (int16_t)c;
+			else
+				c32[n] = (int32_t)c;
+		}
+	}
+
+	return (size_t)st->filter_length * coef_bits / 8;
+}
+
+static int src_write_blob(const struct src_blob_param *p, const uint8_t *blob, size_t size)
+{
+	const uint32_t *words = (const uint32_t *)blob;
+	FILE *fh;
+	size_t i;
+
+	if (p->bin_file) {
+		fh = fopen(p->bin_file, "wb");
+		if (!fh) {
+			fprintf(stderr, "error: can't open %s: %s\n", p->bin_file, strerror(errno));
+			return -errno;
+		}
+
+		if (fwrite(blob, 1, size, fh) != size) {
+			fprintf(stderr, "error: write to %s failed\n", p->bin_file);
+			fclose(fh);
+			return -EIO;
+		}
+
+		fclose(fh);
+	}
+
+	if (p->txt_file) {
+		fh = fopen(p->txt_file, "w");
+		if (!fh) {
+			fprintf(stderr, "error: can't open %s: %s\n", p->txt_file, strerror(errno));
+			return -errno;
+		}
+
+		for (i = 0; i < size / sizeof(uint32_t); i++)
+			fprintf(fh, "%u,", words[i]);
+
+		fprintf(fh, "\n");
+		fclose(fh);
+	}
+
+	return 0;
+}
+
+static int src_print_stage(int n, const struct sof_src_stage *st, int fs_in)
+{
+	int fir_delay = st->subfilter_length + (st->num_of_subfilters - 1) * st->idm +
+		st->blk_in;
+	int out_delay = 1 + (st->num_of_subfilters - 1) * st->odm;
+
+	fprintf(stdout, "Stage %d: L = %d, M = %d, taps = %d, shift = %d\n",
+		n, st->blk_out, st->blk_in, st->filter_length, st->shift);
+	fprintf(stdout, "\tfir delay = %d, out delay = %d, %.2f MMAC/s per channel\n",
+		fir_delay, out_delay, (double)fs_in / st->blk_in * st->filter_length / 1e6);
+
+	if (fir_delay > SOF_SRC_MAX_FIR_DELAY || out_delay > SOF_SRC_MAX_OUT_DELAY) {
+		fprintf(stderr, "error: stage %d delay lines exceed firmware max %d and %d\n",
+			n, SOF_SRC_MAX_FIR_DELAY, SOF_SRC_MAX_OUT_DELAY);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	struct src_blob_param p = {
+		.coef_bits = 32,
+		.ipc_major = 3,
+		.quality = 1.0,
+		.rs = 80,
+		.gain = -1,
+	};
+	struct src_stage_coef s[SOF_SRC_MAX_STAGES];
+	struct src_design d1, d2;
+	struct sof_abi_hdr *hdr;
+	struct sof_src_config *config;
+	uint8_t *blob;
+	size_t blob_size;
+	size_t offset;
+	int l1, m1, l2, m2;
+	int num_stages;
+	int fs3;
+	int opt;
+	int ret;
+	int i;
+
+	while ((opt = getopt(argc, argv, "hi:o:c:a:q:g:p:b:t:")) != -1) {
+		switch (opt) {
+		case 'i':
+			p.fs_in = atoi(optarg);
+			break;
+		case 'o':
+			p.fs_out = atoi(optarg);
+			break;
+		case 'c':
+			p.coef_bits = atoi(optarg);
+			break;
+		case 'a':
+			p.rs = atof(optarg);
+			break;
+		case 'q':
+			p.quality = atof(optarg);
+			break;
+		case 'g':
+			p.gain = atof(optarg);
+			break;
+		case 'p':
+			p.ipc_major = atoi(optarg);
+			break;
+		case 'b':
+			p.bin_file = optarg;
+			break;
+		case 't':
+			p.txt_file = optarg;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return 0;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (p.fs_in <= 0 || p.fs_out <= 0 || p.fs_in == p.fs_out) {
+		fprintf(stderr, "error: need two different positive sample rates\n");
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (p.coef_bits != 16 && p.coef_bits != 32) {
+		fprintf(stderr, "error: coefficient bits must be 16 or 32\n");
+		return EXIT_FAILURE;
+	}
+
+	if (p.ipc_major != 3 && p.ipc_major != 4) {
+		fprintf(stderr, "error: IPC major version must be 3 or 4\n");
+		return EXIT_FAILURE;
+	}
+
+	if (p.rs < SRC_RS_MIN || p.rs > SRC_RS_MAX) {
+		fprintf(stderr, "error: stop-band attenuation must be %d to %d dB\n",
+			SRC_RS_MIN, SRC_RS_MAX);
+		return EXIT_FAILURE;
+	}
+
+	/* Design stages as in src_generate.m */
+	src_factor2_lm(p.fs_in, p.fs_out, &l1, &m1, &l2, &m2);
+	fs3 = (int)((int64_t)p.fs_in * l1 / m1);
+	num_stages = l2 == 1 && m2 == 1 ? 1 : 2;
+	src_design_init(&d1, p.fs_in, fs3, &p);
+	src_design_init(&d2, fs3, p.fs_out, &p);
+	d1.gain = p.gain / num_stages;
+	d2.gain = d1.gain;
+	if (p.fs_out < p.fs_in) {
+		/* When decimating 1st stage pass-band can be limited for
+		 * wider transition band.
+		 */
+		d1.c_pb = p.fs_out * d2.c_pb / (p.fs_in < fs3 ? p.fs_in : fs3);
+	} else {
+		/* When interpolating 2nd stage pass-band can be limited */
+		d2.c_pb = p.fs_in * d1.c_pb / (p.fs_out < fs3 ? p.fs_out : fs3);
+	}
+
+	memset(s, 0, sizeof(s));
+	ret = src_design_stage(&d1, &s[0]);
+	if (!ret && num_stages == 2)
+		ret = src_design_stage(&d2, &s[1]);
+
+	if (ret < 0)
+		goto out;
+
+	/* Pack the blob */
+	blob_size = sizeof(*hdr) + sizeof(*config);
+	for (i = 0; i < num_stages; i++)
+		blob_size += (size_t)s[i].stage.filter_length * p.coef_bits / 8;
+
+	if (blob_size - sizeof(*hdr) > SOF_SRC_MAX_SIZE) {
+		fprintf(stderr, "error: blob size %zu exceeds %d\n", blob_size - sizeof(*hdr),
+			SOF_SRC_MAX_SIZE);
+		ret = -EINVAL;
+		goto out;
+	}
+
+	blob = calloc(1, blob_size);
+	if (!blob) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	hdr = (struct sof_abi_hdr *)blob;
+	config = (struct sof_src_config *)hdr->data;
+	hdr->magic = p.ipc_major == 4 ? SOF_IPC4_ABI_MAGIC : SOF_ABI_MAGIC;
+	hdr->type = 0;
+	hdr->size = blob_size - sizeof(*hdr);
+	hdr->abi = SOF_ABI_VERSION;
+	config->size = hdr->size;
+	config->source_rate = p.fs_in;
+	config->sink_rate = p.fs_out;
+	config->num_stages = num_stages;
+	config->coef_bits = p.coef_bits;
+	offset = 0;
+	for (i = 0; i < num_stages; i++) {
+		config->stage[i] = s[i].stage;
+		offset += src_pack_stage(&s[i], p.coef_bits, (uint8_t *)config->data + offset);
+		ret = src_print_stage(i + 1, &s[i].stage, i ? fs3 : p.fs_in);
+		if (ret < 0)
+			break;
+	}
+
+	if (!ret)
+		ret = src_write_blob(&p, blob, blob_size);
+
+	free(blob);
+
+out:
+	for (i = 0; i < SOF_SRC_MAX_STAGES; i++)
+		free(s[i].coefs);
+
+	return ret < 0 ? EXIT_FAILURE : 0;
+}
@@ -29,7 +29,7 @@ struct mm_info {
 
 struct block_hdr {
 	uint16_t size;		/* size in blocks for continuous allocation */
-	uint16_t used;		/* usage flags for page */
+	uint16_t used_mask;	/* usage bits of blocks [n, n + 15], in every 16th hdr */
 	void *unaligned_ptr;	/* align ptr */
 } __packed;
 